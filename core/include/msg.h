@@ -310,6 +310,20 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive a number of messages at once.
+ *
+ * This function blocks until at least one message was received. Then it
+ * copies as many of the messages waiting in the thread's message queue into
+ * @p buf as fit, taking the queue lock only once.
+ *
+ * @param[out] buf  Buffer for the received messages, must not be NULL.
+ * @param[in]  max  Number of messages that fit into @p buf, must be > 0.
+ *
+ * @return  Number of messages received, at least 1.
+ */
+unsigned msg_receive_batch(msg_t *buf, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_msg_chan Message channels
+ * @ingroup     core_msg
+ * @brief       Lock-free message channels
+ *
+ * A message channel is a ring of @ref msg_t owned by one receiving thread.
+ * Any number of threads and ISRs can put messages into it without disabling
+ * interrupts. The receiver is woken up via @ref core_thread_flags, so a
+ * thread can wait for several channels and other events at once.
+ *
+ * With a single producer, putting a message never retries and is
+ * wait-free. With multiple producers, a producer only retries when another
+ * producer claimed the same slot concurrently.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static msg_chan_slot_t _slots[16];
+ * static msg_chan_t _chan;
+ *
+ * static void *_thread(void *arg)
+ * {
+ *     msg_t msgs[8];
+ *
+ *     msg_chan_init(&_chan, _slots, ARRAY_SIZE(_slots), 0x1);
+ *     while (1) {
+ *         unsigned n = msg_chan_receive_batch(&_chan, msgs, ARRAY_SIZE(msgs));
+ *         [ handle msgs[0] to msgs[n - 1] ]
+ *     }
+ *     return NULL;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * To use, add the module `core_msg_chan` to the `USEMODULE` macro in your
+ * application's Makefile.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Message channel API
+ */
+
+#ifndef MSG_CHAN_H
+#define MSG_CHAN_H
+
+#include <stdatomic.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Slot of a message channel
+ */
+typedef struct {
+    atomic_uint seq;        /**< tells whether the slot is free or filled */
+    msg_t msg;              /**< the message */
+} msg_chan_slot_t;
+
+/**
+ * @brief   Message channel
+ */
+typedef struct {
+    msg_chan_slot_t *slots; /**< the ring of slots */
+    unsigned mask;          /**< number of slots - 1 */
+    atomic_uint tail;       /**< next slot to put a message into */
+    unsigned head;          /**< next slot to receive, receiver only */
+    thread_t *receiver;     /**< thread receiving from the channel */
+    thread_flags_t flag;    /**< thread flag set on new messages */
+} msg_chan_t;
+
+/**
+ * @brief   Initialize a message channel for the calling thread
+ *
+ * @pre     @p numof is a power of two
+ *
+ * @param[out] chan     channel to initialize
+ * @param[in]  slots    slots for the messages
+ * @param[in]  numof    number of slots in @p slots
+ * @param[in]  flag     thread flag to wake up the calling thread with
+ */
+void msg_chan_init(msg_chan_t *chan, msg_chan_slot_t *slots, unsigned numof,
+                   thread_flags_t flag);
+
+/**
+ * @brief   Put a message into a channel
+ *
+ * Can be called from any thread or ISR. The message's sender_pid is set to
+ * the calling thread or @ref KERNEL_PID_ISR.
+ *
+ * @param[in] chan      channel to put the message into
+ * @param[in] m         message to put
+ *
+ * @return  1 if the message was put into the channel
+ * @return  0 if the channel is full
+ */
+int msg_chan_try_put(msg_chan_t *chan, msg_t *m);
+
+/**
+ * @brief   Take messages out of a channel without blocking
+ *
+ * @pre     Called by the thread that initialized @p chan
+ *
+ * @param[in]  chan     channel to receive from
+ * @param[out] buf      buffer for the messages
+ * @param[in]  max      number of messages that fit into @p buf
+ *
+ * @return  Number of messages received, 0 if @p chan is empty
+ */
+unsigned msg_chan_try_receive_batch(msg_chan_t *chan, msg_t *buf,
+                                    unsigned max);
+
+/**
+ * @brief   Take messages out of a channel, blocking until there is at least
+ *          one
+ *
+ * @pre     Called by the thread that initialized @p chan
+ *
+ * @param[in]  chan     channel to receive from
+ * @param[out] buf      buffer for the messages
+ * @param[in]  max      number of messages that fit into @p buf, must be > 0
+ *
+ * @return  Number of messages received, at least 1
+ */
+unsigned msg_chan_receive_batch(msg_chan_t *chan, msg_t *buf, unsigned max);
+
+/**
+ * @brief   Take one message out of a channel, blocking until there is one
+ *
+ * @pre     Called by the thread that initialized @p chan
+ *
+ * @param[in]  chan     channel to receive from
+ * @param[out] m        the message
+ */
+static inline void msg_chan_receive(msg_chan_t *chan, msg_t *m)
+{
+    msg_chan_receive_batch(chan, m, 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSG_CHAN_H */
+/** @} */
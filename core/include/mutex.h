@@ -91,6 +91,37 @@
  *       `MUTEX_LOCK`.
  *     - The scheduler is run, so that if the unblocked waiting thread can
  *       run now, in case it has a higher priority than the running thread.
+ *
+ * Priority Inheritance
+ * --------------------
+ *
+ * A thread holding a mutex can be preempted by threads of medium priority
+ * while a thread of high priority waits for the mutex, so the high priority
+ * thread effectively waits for the medium priority ones (priority inversion,
+ * see `tests/thread_priority_inversion`). With the pseudomodule
+ * `core_mutex_priority_inheritance`, every mutex keeps track of its owner:
+ *
+ * 1. When a thread blocks on a mutex whose owner has a lower priority, the
+ *    owner gets the priority of the blocking thread. If the owner itself waits
+ *    for another mutex, the owner of that one is boosted as well, and so on for
+ *    up to @ref CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH mutexes.
+ * 2. When the mutex is unlocked, the owner drops to the highest priority of
+ *    its own priority and the threads still waiting for other mutexes it
+ *    holds, and the mutex is handed over to the first waiter.
+ *
+ * The owner is only known if the mutex was locked by a thread, so mutexes
+ * initialized with `MUTEX_INIT_LOCKED` or locked from IRQ context by
+ * @ref mutex_trylock never boost. Mutexes can be unlocked in any order. A boost
+ * caused by a waiter that cancels waiting (@ref mutex_cancel) lasts until the
+ * mutex is unlocked.
+ *
+ * Threads do not keep track of the mutexes they hold, so mutexes used as
+ * one-shot signals (e.g. by `ztimer_sleep()`) can go out of scope while
+ * still locked.
+ *
+ * The overhead is one more field in each mutex and in each thread, a bounded
+ * walk along the owners when blocking and, if the owner was boosted, a walk
+ * along all threads when unlocking.
  * @{
  *
  * @file
@@ -117,6 +148,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Maximum number of mutexes a priority boost is passed along
+ *
+ * Bounds the time spent with IRQs disabled when a thread blocks on a mutex
+ * whose owner waits for another mutex and so on.
+ */
+#ifndef CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH
+#define CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH     (4U)
+#endif
+
 /**
  * @brief Mutex structure. Must never be modified by the user.
  */
@@ -127,6 +168,13 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, or KERNEL_PID_UNDEF if unknown
+     * @internal
+     */
+    kernel_pid_t owner;
+#endif
 } mutex_t;
 
 /**
@@ -141,16 +189,21 @@ typedef struct {
     uint8_t cancelled;  /**< Flag whether the mutex has been cancelled */
 } mutex_cancel_t;
 
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF }
+#else
+#define MUTEX_INIT { { NULL } }
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -171,6 +224,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -232,6 +288,10 @@ static inline int mutex_trylock(mutex_t *mutex)
     if (mutex->queue.next == NULL) {
         mutex->queue.next = MUTEX_LOCKED;
         retval = 1;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        thread_t *me = thread_get_active();
+        mutex->owner = (!irq_is_in() && me) ? me->pid : KERNEL_PID_UNDEF;
+#endif
     }
     irq_restore(irq_state);
     return retval;
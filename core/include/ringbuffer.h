@@ -160,6 +160,41 @@ int ringbuffer_peek_one(const ringbuffer_t *__restrict rb);
 unsigned ringbuffer_peek(const ringbuffer_t *__restrict rb, char *buf,
                          unsigned n);
 
+/**
+ * @brief           Get the contiguous region of the oldest elements without
+ *                  copying them.
+ * @details         The elements can be processed in place and removed with
+ *                  ringbuffer_remove() afterwards. As the elements may wrap
+ *                  around the end of the buffer, call this again after
+ *                  ringbuffer_remove() to get the rest.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      data  Start of the contiguous region.
+ * @returns         Number of elements at @p data, 0 if rb is empty.
+ */
+unsigned ringbuffer_peek_contiguous(const ringbuffer_t *__restrict rb,
+                                    const char **data);
+
+/**
+ * @brief           Get the contiguous region of free elements to write to in
+ *                  place.
+ * @details         The elements written are added to the ringbuffer with
+ *                  ringbuffer_commit().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[out]      data  Start of the contiguous region.
+ * @returns         Number of elements writable at @p data, 0 if rb is full.
+ */
+unsigned ringbuffer_reserve_contiguous(ringbuffer_t *__restrict rb,
+                                       char **data);
+
+/**
+ * @brief           Add elements written to the region returned by
+ *                  ringbuffer_reserve_contiguous() to the ringbuffer.
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, must not be larger than
+ *                        returned by ringbuffer_reserve_contiguous().
+ */
+void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
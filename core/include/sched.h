@@ -212,6 +212,20 @@ void sched_set_status(thread_t *process, thread_status_t status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If @p thread is on the run queue, it is moved to the run queue of
+ * @p priority. The scheduler is not run, use @ref sched_switch or
+ * @ref thread_yield_higher if the change has to take effect right away.
+ *
+ * @note    It is safe to call this function from IRQ context.
+ *
+ * @param[in,out]   thread      thread to change the priority of
+ * @param[in]       priority    new priority of @p thread
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -33,6 +33,7 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -102,6 +103,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
         return -1;
     }
 
+    trace_msg(TRACE_EVENT_MSG_SEND, target_pid);
+
     thread_t *me = thread_get_active();
 
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
@@ -203,6 +206,8 @@ static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
         return -1;
     }
 
+    trace_msg(TRACE_EVENT_MSG_SEND, target_pid);
+
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("%s: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", __func__, thread_getpid(), target_pid);
@@ -336,12 +341,60 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res == 1) {
+        trace_msg(TRACE_EVENT_MSG_RECEIVE, m->sender_pid);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    trace_msg(TRACE_EVENT_MSG_RECEIVE, m->sender_pid);
+    return res;
+}
+
+unsigned msg_receive_batch(msg_t *buf, unsigned max)
+{
+    unsigned n = 1;
+
+    assert(max > 0);
+    _msg_receive(buf, 1);
+
+    while (n < max) {
+        unsigned state = irq_disable();
+        thread_t *me = thread_get_active();
+
+        if (me->msg_waiters.next) {
+            /* let _msg_receive() refill the queue from the blocked senders */
+            irq_restore(state);
+            if (_msg_receive(&buf[n], 0) < 0) {
+                break;
+            }
+            n++;
+            continue;
+        }
+        if (thread_has_msg_queue(me)) {
+            int queue_index;
+
+            while ((n < max) &&
+                   ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+                buf[n++] = me->msg_array[queue_index];
+            }
+        }
+        irq_restore(state);
+        break;
+    }
+
+    DEBUG("msg_receive_batch: %" PRIkernel_pid ": received %u messages.\n",
+          thread_getpid(), n);
+    for (unsigned i = 0; i < n; i++) {
+        trace_msg(TRACE_EVENT_MSG_RECEIVE, buf[i].sender_pid);
+    }
+    return n;
 }
 
 static int _msg_receive(msg_t *m, int block)
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_msg_chan
+ * @{
+ *
+ * @file
+ * @brief       Lock-free message channel implementation
+ *
+ * The ring follows the bounded queue by Dmitry Vyukov: every slot carries a
+ * sequence number telling the producers and the receiver whose turn it is.
+ * A free slot for position `pos` has `seq == pos`, a filled one
+ * `seq == pos + 1`.
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "msg_chan.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+void msg_chan_init(msg_chan_t *chan, msg_chan_slot_t *slots, unsigned numof,
+                   thread_flags_t flag)
+{
+    assert((numof != 0) && ((numof & (numof - 1)) == 0));
+
+    for (unsigned i = 0; i < numof; i++) {
+        atomic_init(&slots[i].seq, i);
+    }
+    chan->slots = slots;
+    chan->mask = numof - 1;
+    atomic_init(&chan->tail, 0);
+    chan->head = 0;
+    chan->receiver = thread_get_active();
+    chan->flag = flag;
+}
+
+int msg_chan_try_put(msg_chan_t *chan, msg_t *m)
+{
+    unsigned pos = atomic_load_explicit(&chan->tail, memory_order_relaxed);
+    msg_chan_slot_t *slot;
+
+    while (1) {
+        slot = &chan->slots[pos & chan->mask];
+        int diff = (int)(atomic_load_explicit(&slot->seq, memory_order_acquire)
+                         - pos);
+
+        if (diff == 0) {
+            /* slot is free, claim it */
+            if (atomic_compare_exchange_weak_explicit(&chan->tail, &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            DEBUG("msg_chan: channel %p is full\n", (void *)chan);
+            return 0;
+        }
+        else {
+            /* another producer claimed the slot first */
+            pos = atomic_load_explicit(&chan->tail, memory_order_relaxed);
+        }
+    }
+
+    m->sender_pid = irq_is_in() ? KERNEL_PID_ISR : thread_getpid();
+    slot->msg = *m;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    thread_flags_set(chan->receiver, chan->flag);
+    return 1;
+}
+
+unsigned msg_chan_try_receive_batch(msg_chan_t *chan, msg_t *buf,
+                                    unsigned max)
+{
+    unsigned n;
+
+    assert(thread_get_active() == chan->receiver);
+    for (n = 0; n < max; n++) {
+        msg_chan_slot_t *slot = &chan->slots[chan->head & chan->mask];
+
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) !=
+            chan->head + 1) {
+            /* empty, or the next message is still being written */
+            break;
+        }
+        buf[n] = slot->msg;
+        /* hand the slot to the producers for the next round */
+        atomic_store_explicit(&slot->seq, chan->head + chan->mask + 1,
+                              memory_order_release);
+        chan->head++;
+    }
+    return n;
+}
+
+unsigned msg_chan_receive_batch(msg_chan_t *chan, msg_t *buf, unsigned max)
+{
+    unsigned n;
+
+    assert(max > 0);
+    /* the flag is set after a message was put, so checking before waiting
+     * can't miss one */
+    while ((n = msg_chan_try_receive_batch(chan, buf, max)) == 0) {
+        thread_flags_wait_any(chan->flag);
+    }
+    return n;
+}
@@ -22,6 +22,7 @@
 
 #include <errno.h>
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 #include "mutex.h"
@@ -29,10 +30,118 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+/**
+ * @brief   Make @p owner the owner of @p mutex
+ */
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    /* there is no active thread before the scheduler started */
+    if (owner == NULL) {
+        mutex->owner = KERNEL_PID_UNDEF;
+        return;
+    }
+    mutex->owner = owner->pid;
+#else
+    (void)mutex;
+    (void)owner;
+#endif
+}
+
+/**
+ * @brief   Pass the priority of @p waiter, which just blocked on @p mutex, on
+ *          to the owner of @p mutex
+ * @pre     IRQs are disabled
+ *
+ * If the owner waits for another mutex itself, the owner of that one is
+ * boosted as well, for up to @ref CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH
+ * mutexes.
+ */
+static inline void _inherit(mutex_t *mutex, thread_t *waiter)
+{
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    uint8_t priority = waiter->priority;
+
+    waiter->wait_data = mutex;
+    for (unsigned i = 0; i < CONFIG_MUTEX_PRIORITY_INHERITANCE_DEPTH; i++) {
+        thread_t *owner = thread_get(mutex->owner);
+
+        if ((owner == NULL) || (owner->priority <= priority)) {
+            return;
+        }
+        DEBUG("PID[%" PRIkernel_pid "] mutex: boosting %" PRIkernel_pid
+              " from prio %u to %u\n", thread_getpid(), owner->pid,
+              (unsigned)owner->priority, (unsigned)priority);
+        sched_change_priority(owner, priority);
+        if (owner->status != STATUS_MUTEX_BLOCKED) {
+            return;
+        }
+        /* the owner waits for another mutex, keep its queue sorted */
+        mutex = owner->wait_data;
+        list_remove(&mutex->queue, (list_node_t *)&owner->rq_entry);
+        thread_add_to_list(&mutex->queue, owner);
+    }
+#else
+    (void)mutex;
+    (void)waiter;
+#endif
+}
+
+/**
+ * @brief   Release @p mutex from its owner and lower the priority of the owner
+ *          to what it inherits from the mutexes it still holds
+ * @pre     IRQs are disabled
+ *
+ * @return  true if the priority of the owner was lowered
+ */
+static inline bool _restore(mutex_t *mutex)
+{
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    thread_t *owner = thread_get(mutex->owner);
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (owner == NULL) {
+        return false;
+    }
+    if (owner->priority == owner->base_priority) {
+        return false;
+    }
+
+    /* Mutexes may be released without unlocking (e.g. one-shot signals on the
+     * stack), so the mutexes still held are found via the threads blocked on
+     * them rather than via a list of held mutexes. */
+    uint8_t priority = owner->base_priority;
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        thread_t *waiter = thread_get_unchecked(pid);
+        if ((waiter == NULL) || (waiter->status != STATUS_MUTEX_BLOCKED)
+            || (waiter->priority >= priority)) {
+            continue;
+        }
+        mutex_t *held = waiter->wait_data;
+        if ((held != mutex) && (held->owner == owner->pid)) {
+            priority = waiter->priority;
+        }
+    }
+
+    if (owner->priority >= priority) {
+        return false;
+    }
+    DEBUG("PID[%" PRIkernel_pid "] mutex: restoring prio %u of %"
+          PRIkernel_pid "\n", thread_getpid(), (unsigned)priority,
+          owner->pid);
+    sched_change_priority(owner, priority);
+    return true;
+#else
+    (void)mutex;
+    return false;
+#endif
+}
+
 /**
  * @brief   Block waiting for a locked mutex
  * @pre     IRQs are disabled
@@ -62,6 +171,7 @@ static inline __attribute__((always_inline)) void _block(mutex_t *mutex,
     else {
         thread_add_to_list(&mutex->queue, me);
     }
+    _inherit(mutex, me);
 
     irq_restore(irq_state);
     thread_yield_higher();
@@ -70,6 +180,8 @@ static inline __attribute__((always_inline)) void _block(mutex_t *mutex,
 
 void mutex_lock(mutex_t *mutex)
 {
+    trace_mutex(TRACE_EVENT_MUTEX_LOCK, mutex);
+
     unsigned irq_state = irq_disable();
 
     DEBUG("PID[%" PRIkernel_pid "] mutex_lock().\n", thread_getpid());
@@ -77,6 +189,7 @@ void mutex_lock(mutex_t *mutex)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, thread_get_active());
         DEBUG("PID[%" PRIkernel_pid "] mutex_lock(): early out.\n",
               thread_getpid());
         irq_restore(irq_state);
@@ -84,6 +197,7 @@ void mutex_lock(mutex_t *mutex)
     else {
         _block(mutex, irq_state);
     }
+    trace_mutex(TRACE_EVENT_MUTEX_LOCKED, mutex);
 }
 
 int mutex_lock_cancelable(mutex_cancel_t *mc)
@@ -102,12 +216,15 @@ int mutex_lock_cancelable(mutex_cancel_t *mc)
 
     mutex_t *mutex = mc->mutex;
 
+    trace_mutex(TRACE_EVENT_MUTEX_LOCK, mutex);
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, thread_get_active());
         DEBUG("PID[%" PRIkernel_pid "] mutex_lock_cancelable() early out.\n",
               thread_getpid());
         irq_restore(irq_state);
+        trace_mutex(TRACE_EVENT_MUTEX_LOCKED, mutex);
         return 0;
     }
     else {
@@ -116,12 +233,17 @@ int mutex_lock_cancelable(mutex_cancel_t *mc)
             DEBUG("PID[%" PRIkernel_pid "] mutex_lock_cancelable() "
                   "cancelled.\n", thread_getpid());
         }
+        else {
+            trace_mutex(TRACE_EVENT_MUTEX_LOCKED, mutex);
+        }
         return (mc->cancelled) ? -ECANCELED : 0;
     }
 }
 
 void mutex_unlock(mutex_t *mutex)
 {
+    trace_mutex(TRACE_EVENT_MUTEX_UNLOCK, mutex);
+
     unsigned irqstate = irq_disable();
 
     DEBUG("PID[%" PRIkernel_pid "] mutex_unlock(): queue.next: %p\n",
@@ -133,10 +255,17 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    /* if the priority of the unlocking thread is lowered, other threads may
+     * now have priority over it, so let the scheduler decide */
+    bool lowered = _restore(mutex);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+        if (lowered) {
+            sched_switch(0);
+        }
         return;
     }
 
@@ -146,13 +275,14 @@ void mutex_unlock(mutex_t *mutex)
 
     DEBUG("PID[%" PRIkernel_pid "] mutex_unlock(): waking up waiting thread %"
           PRIkernel_pid "\n", thread_getpid(),  process->pid);
+    _set_owner(mutex, process);
     sched_set_status(process, STATUS_PENDING);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
 
-    uint16_t process_priority = process->priority;
+    uint16_t process_priority = lowered ? 0 : process->priority;
 
     irq_restore(irqstate);
     sched_switch(process_priority);
@@ -162,9 +292,11 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
 {
     DEBUG("PID[%" PRIkernel_pid "] mutex_unlock_and_sleep(): queue.next: %p\n",
           thread_getpid(), (void *)mutex->queue.next);
+    trace_mutex(TRACE_EVENT_MUTEX_UNLOCK, mutex);
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        _restore(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -174,6 +306,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "] mutex_unlock_and_sleep(): waking up "
                   "waiter.\n", process->pid);
+            _set_owner(mutex, process);
             sched_set_status(process, STATUS_PENDING);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
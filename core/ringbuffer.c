@@ -18,6 +18,7 @@
 
 #include "ringbuffer.h"
 
+#include <assert.h>
 #include <string.h>
 
 /**
@@ -54,17 +55,38 @@ static char get_head(ringbuffer_t *restrict rb)
     return result;
 }
 
+/**
+ * @brief           Position of the first free element of the ringbuffer.
+ * @param[in]       rb   Ringbuffer to operate on.
+ * @returns         Index into rb->buf.
+ */
+static unsigned tail_pos(const ringbuffer_t *restrict rb)
+{
+    unsigned pos = rb->start + rb->avail;
+
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    return pos;
+}
+
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
+    unsigned pos = tail_pos(rb);
 
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
-        }
-        add_tail(rb, buf[i]);
+    if (n > ringbuffer_get_free(rb)) {
+        n = ringbuffer_get_free(rb);
+    }
+    if (n > rb->size - pos) {
+        unsigned bytes_till_end = rb->size - pos;
+        memcpy(rb->buf + pos, buf, bytes_till_end);
+        memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+    }
+    else {
+        memcpy(rb->buf + pos, buf, n);
     }
-    return i;
+    rb->avail += n;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -147,3 +169,28 @@ unsigned ringbuffer_peek(const ringbuffer_t *restrict rb_, char *buf,
 
     return ringbuffer_get(&rb, buf, n);
 }
+
+unsigned ringbuffer_peek_contiguous(const ringbuffer_t *restrict rb,
+                                    const char **data)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+
+    *data = rb->buf + rb->start;
+    return (rb->avail > bytes_till_end) ? bytes_till_end : rb->avail;
+}
+
+unsigned ringbuffer_reserve_contiguous(ringbuffer_t *restrict rb, char **data)
+{
+    unsigned pos = tail_pos(rb);
+    unsigned bytes_till_end = rb->size - pos;
+
+    *data = rb->buf + pos;
+    return (ringbuffer_get_free(rb) > bytes_till_end) ? bytes_till_end
+                                                      : ringbuffer_get_free(rb);
+}
+
+void ringbuffer_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    assert(n <= ringbuffer_get_free(rb));
+    rb->avail += n;
+}
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <inttypes.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -264,6 +265,28 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(priority < SCHED_PRIO_LEVELS);
+
+    unsigned irq_state = irq_disable();
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            _clear_runqueue_bit(thread);
+        }
+        thread->priority = priority;
+        clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        _set_runqueue_bit(thread);
+    }
+    else {
+        thread->priority = priority;
+    }
+
+    irq_restore(irq_state);
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n",
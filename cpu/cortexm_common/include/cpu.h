@@ -35,6 +35,7 @@
 #include "irq.h"
 #include "sched.h"
 #include "thread.h"
+#include "trace.h"
 #include "cpu_conf.h"
 
 #ifdef __cplusplus
@@ -180,6 +181,7 @@ static inline void cortexm_sleep(int deep)
  */
 static inline void cortexm_isr_end(void)
 {
+    trace_isr(TRACE_EVENT_ISR_EXIT, __get_IPSR());
     if (sched_context_switch_request) {
         thread_yield_higher();
     }
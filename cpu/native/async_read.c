@@ -67,6 +67,10 @@ void native_async_read_continue(int fd) {
     }
 }
 
+int native_async_read_wait(unsigned timeout_ms) {
+    return real_poll(_fds, _next_index, timeout_ms);
+}
+
 static void _add_handler(int fd, void *arg, native_async_read_callback_t handler) {
     _fds[_next_index].fd = fd;
     _fds[_next_index].events = POLLIN | POLLPRI;
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpu_native
+ * @{
+ *
+ * @file
+ * @brief   Multiple asynchronous read on file descriptors, based on epoll
+ *
+ * All file descriptors are registered edge-triggered with one epoll
+ * instance. A single SIGIO runs the callbacks of all file descriptors that
+ * became readable since the last one. File descriptors that cannot signal
+ * SIGIO themselves are watched by a single child process for all of them,
+ * which forwards their edges as SIGIO.
+ *
+ * native_async_read_continue() checks if a file descriptor is still readable
+ * and, if so, schedules its callback again. Several such checks before the
+ * next interrupt are delivered by a single SIGIO.
+ * @}
+ */
+
+#include <err.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+
+#include "async_read.h"
+#include "native_internal.h"
+
+static int _next_index;
+static struct pollfd _fds[ASYNC_READ_NUMOF];
+static async_read_t pollers[ASYNC_READ_NUMOF];
+/* callbacks to run on the next SIGIO */
+static volatile bool _ready[ASYNC_READ_NUMOF];
+/* a SIGIO was injected and not handled yet */
+static volatile bool _isr_pending;
+
+/* all file descriptors */
+static int _epfd = -1;
+/* file descriptors without SIGIO support, watched by _int_child */
+static int _int_epfd = -1;
+static pid_t _int_child;
+
+static void _async_io_isr(void)
+{
+    struct epoll_event events[ASYNC_READ_NUMOF];
+    int n;
+
+    _isr_pending = false;
+    n = epoll_wait(_epfd, events, ASYNC_READ_NUMOF, 0);
+    for (int i = 0; i < n; i++) {
+        _ready[events[i].data.u32] = true;
+    }
+    for (int i = 0; i < _next_index; i++) {
+        if (_ready[i]) {
+            _ready[i] = false;
+            pollers[i].cb(_fds[i].fd, pollers[i].arg);
+        }
+    }
+}
+
+/* runs _async_io_isr() as soon as interrupts are enabled */
+static void _pend_isr(void)
+{
+    int sig = SIGIO;
+
+    if (_isr_pending) {
+        return;
+    }
+    _isr_pending = true;
+    if (real_write(_sig_pipefd[1], &sig, sizeof(sig)) == -1) {
+        err(EXIT_FAILURE, "native_async_read: real_write()");
+    }
+    _native_sigpend++;
+}
+
+static void _epoll_add(int epfd, int fd, unsigned index)
+{
+    struct epoll_event event = {
+        .events = EPOLLIN | EPOLLPRI | EPOLLET,
+        .data.u32 = index,
+    };
+
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read: epoll_ctl()");
+    }
+}
+
+void native_async_read_setup(void) {
+    register_interrupt(SIGIO, _async_io_isr);
+
+    if (_epfd == -1) {
+        _epfd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epfd == -1) {
+            err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1()");
+        }
+    }
+}
+
+void native_async_read_cleanup(void) {
+    unregister_interrupt(SIGIO);
+
+    for (int i = 0; i < _next_index; i++) {
+        real_close(_fds[i].fd);
+    }
+    if (_int_child) {
+        kill(_int_child, SIGKILL);
+        _int_child = 0;
+    }
+    if (_int_epfd != -1) {
+        real_close(_int_epfd);
+        _int_epfd = -1;
+    }
+    if (_epfd != -1) {
+        real_close(_epfd);
+        _epfd = -1;
+    }
+}
+
+void native_async_read_continue(int fd) {
+    for (int i = 0; i < _next_index; i++) {
+        if (_fds[i].fd != fd) {
+            continue;
+        }
+        _native_in_syscall++; /* no switching here */
+        if (real_poll(&_fds[i], 1, 0) > 0) {
+            _ready[i] = true;
+            _pend_isr();
+        }
+        _native_in_syscall--;
+    }
+}
+
+int native_async_read_wait(unsigned timeout_ms) {
+    return real_poll(_fds, _next_index, timeout_ms);
+}
+
+static void _add_handler(int fd, void *arg, native_async_read_callback_t handler) {
+    _fds[_next_index].fd = fd;
+    _fds[_next_index].events = POLLIN | POLLPRI;
+    async_read_t *poll = &pollers[_next_index];
+
+    poll->child_pid = 0;
+    poll->cb = handler;
+    poll->arg = arg;
+    poll->fd = &_fds[_next_index];
+
+    _epoll_add(_epfd, fd, _next_index);
+}
+
+void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
+    if (_next_index >= ASYNC_READ_NUMOF) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): too many callbacks");
+    }
+
+    _add_handler(fd, arg, handler);
+
+    /* configure fds to send signals on io */
+    if (real_fcntl(fd, F_SETOWN, _native_pid) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETOWN)");
+    }
+    /* set file access mode to non-blocking */
+    if (real_fcntl(fd, F_SETFL, O_NONBLOCK | O_ASYNC) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETFL)");
+    }
+
+    _next_index++;
+}
+
+static void _sigio_child(void)
+{
+    pid_t parent = _native_pid;
+    pid_t child;
+
+    if ((child = real_fork()) == -1) {
+        err(EXIT_FAILURE, "sigio_child: fork");
+    }
+    if (child > 0) {
+        _int_child = child;
+
+        /* return in parent process */
+        return;
+    }
+
+    /* The epoll instance is shared with the parent, so file descriptors added
+     * later are watched as well. Every edge is signalled once. */
+    while (1) {
+        struct epoll_event events[ASYNC_READ_NUMOF];
+
+        if (epoll_wait(_int_epfd, events, ASYNC_READ_NUMOF, -1) > 0) {
+            kill(parent, SIGIO);
+        }
+        else if (errno != EINTR) {
+            kill(parent, SIGKILL);
+            err(EXIT_FAILURE, "sigio_child: epoll_wait");
+        }
+    }
+}
+
+void native_async_read_add_int_handler(int fd, void *arg, native_async_read_callback_t handler) {
+    if (_next_index >= ASYNC_READ_NUMOF) {
+        err(EXIT_FAILURE, "native_async_read_add_int_handler(): too many callbacks");
+    }
+
+    _add_handler(fd, arg, handler);
+
+    if (_int_epfd == -1) {
+        _int_epfd = epoll_create1(0);
+        if (_int_epfd == -1) {
+            err(EXIT_FAILURE, "native_async_read_add_int_handler(): epoll_create1()");
+        }
+    }
+    _epoll_add(_int_epfd, fd, _next_index);
+    if (!_int_child) {
+        _sigio_child();
+    }
+    _next_index++;
+}
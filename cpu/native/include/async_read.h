@@ -13,6 +13,13 @@
  * @file
  * @brief       Multiple asynchronus read on file descriptors
  *
+ * By default, every SIGIO polls all file descriptors. With module
+ * `native_async_read_epoll` (Linux hosts only), the file descriptors are
+ * watched edge-triggered by epoll instead and a single SIGIO delivers the
+ * callbacks of all file descriptors that became readable. File descriptors
+ * added with native_async_read_add_int_handler() then share one watcher
+ * process instead of one process each.
+ *
  * @author      Takuo Yonezawa <Yonezawa-T2@mail.dnp.co.jp>
  */
 #ifndef ASYNC_READ_H
@@ -64,12 +71,23 @@ void native_async_read_cleanup(void);
 /**
  * @brief   resume monitoring of file descriptors
  *
- * Call this function after reading file descriptors.
+ * Call this function after reading file descriptors. With module
+ * `native_async_read_epoll`, the callback of @p fd is called again if
+ * there is more data to read.
  *
  * @param[in] fd  The file descriptor to monitor
  */
 void native_async_read_continue(int fd);
 
+/**
+ * @brief   wait until one of the monitored file descriptors is readable
+ *
+ * @param[in] timeout_ms    Time to wait at most in milliseconds
+ *
+ * @return  number of readable file descriptors, 0 on timeout
+ */
+int native_async_read_wait(unsigned timeout_ms);
+
 /**
  * @brief   start monitoring of file descriptor
  *
@@ -86,6 +86,17 @@ extern char _native_flash[FLASHPAGE_SIZE * FLASHPAGE_NUMOF];
 #define CPU_FLASH_BASE ((uintptr_t)_native_flash)
 /** @} */
 
+/**
+ * @brief   Time in milliseconds to wait for host I/O before skipping ahead to
+ *          the next timer deadline with module native_virtual_time
+ *
+ * With the default of 0, virtual time never waits for the host. Frames
+ * from the host are still handled, but at whatever virtual time they arrive.
+ */
+#ifndef CONFIG_NATIVE_VIRTUAL_TIME_IO_WAIT_MS
+#define CONFIG_NATIVE_VIRTUAL_TIME_IO_WAIT_MS   (0)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
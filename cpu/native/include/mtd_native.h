@@ -24,12 +24,26 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 #include "mtd.h"
 
+/**
+ * @brief   Reject writes that would set bits without an erase first
+ *
+ * Real NOR flash can only turn bits from 1 to 0 when programming. By default,
+ * such writes silently keep the cleared bits, like most flash does. If set to
+ * 1, they fail with -EIO instead, which helps catching missing erases.
+ */
+#ifdef DOXYGEN
+#define CONFIG_MTD_NATIVE_STRICT
+#endif
+
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
     mtd_dev_t dev;      /**< mtd generic device */
     const char *fname;  /**< filename to use for memory emulation */
+    uint8_t *map;       /**< image file mapped on init, NULL before */
 } mtd_native_dev_t;
 
 /**
@@ -20,6 +20,8 @@
 #define NATIVE_INTERNAL_H
 
 #include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <poll.h>
 /* enable signal handler register access on different platforms
@@ -86,6 +88,8 @@ extern void (*real_free)(void *ptr);
 extern void* (*real_calloc)(size_t nmemb, size_t size);
 extern void* (*real_malloc)(size_t size);
 extern void* (*real_realloc)(void *ptr, size_t size);
+extern void* (*real_mmap)(void *addr, size_t len, int prot, int flags,
+                          int fd, off_t off);
 extern void (*real_freeaddrinfo)(struct addrinfo *res);
 extern void (*real_freeifaddrs)(struct ifaddrs *ifa);
 extern void (*real_srandom)(unsigned int seed);
@@ -97,6 +101,7 @@ extern int (*real_connect)(int socket, ...);
 extern int (*real_chdir)(const char *path);
 extern int (*real_close)(int);
 extern int (*real_fcntl)(int, int, ...);
+extern int (*real_ftruncate)(int fd, off_t length);
 /* The ... is a hack to save includes: */
 extern int (*real_creat)(const char *path, ...);
 extern int (*real_dup2)(int, int);
@@ -111,6 +116,7 @@ extern int (*real_getpid)(void);
 extern int (*real_gettimeofday)(struct timeval *t, ...);
 extern int (*real_ioctl)(int fildes, int request, ...);
 extern int (*real_listen)(int socket, int backlog);
+extern off_t (*real_lseek)(int fd, off_t offset, int whence);
 extern int (*real_open)(const char *path, int oflag, ...);
 extern int (*real_pause)(void);
 extern int (*real_pipe)(int[2]);
@@ -167,6 +173,19 @@ ssize_t _native_read(int fd, void *buf, size_t count);
 ssize_t _native_write(int fd, const void *buf, size_t count);
 ssize_t _native_writev(int fildes, const struct iovec *iov, int iovcnt);
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/**
+ * virtual time in microseconds since start
+ */
+uint64_t native_virtual_time_us(void);
+
+/**
+ * advance virtual time to the next timer deadline and pend its interrupt,
+ * returns false if no timer is set
+ */
+bool native_virtual_time_fast_forward(void);
+#endif
+
 /**
  * @endcond
  */
@@ -25,6 +25,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include "kernel_defines.h"
 #include "net/netdev.h"
 
 #include "net/ethernet/hdr.h"
@@ -35,6 +36,14 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Number of receive buffers the driver can lend out with module
+ *          `netdev_rx_loan`, at most 8
+ */
+#ifndef CONFIG_NETDEV_TAP_RX_LOAN_NUMOF
+#define CONFIG_NETDEV_TAP_RX_LOAN_NUMOF     (4U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +53,13 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscuous;                 /**< Flag for promiscuous mode */
+#if IS_USED(MODULE_NETDEV_RX_LOAN) || defined(DOXYGEN)
+    uint8_t rx_lent;                    /**< bitmask of lent out buffers */
+    /**
+     * @brief   Buffers lent out by netdev_driver_t::recv_loan
+     */
+    uint8_t rx_bufs[CONFIG_NETDEV_TAP_RX_LOAN_NUMOF][ETHERNET_FRAME_LEN];
+#endif
 } netdev_tap_t;
 
 /**
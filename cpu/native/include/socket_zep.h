@@ -56,6 +56,7 @@
 #ifndef SOCKET_ZEP_H
 #define SOCKET_ZEP_H
 
+#include "kernel_defines.h"
 #include "net/netdev.h"
 #include "net/netdev/ieee802154.h"
 #include "net/zep.h"
@@ -64,6 +65,14 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of receive buffers the driver can lend out with module
+ *          `netdev_rx_loan`, at most 8
+ */
+#ifndef CONFIG_SOCKET_ZEP_RX_LOAN_NUMOF
+#define CONFIG_SOCKET_ZEP_RX_LOAN_NUMOF     (4U)
+#endif
+
 /**
  * @brief   ZEP device state
  */
@@ -81,6 +90,14 @@ typedef struct {
      */
     uint8_t snd_hdr_buf[sizeof(zep_v2_data_hdr_t)];
     uint16_t chksum_buf;            /**< buffer for send checksum calculation */
+#if IS_USED(MODULE_NETDEV_RX_LOAN) || defined(DOXYGEN)
+    uint8_t rx_lent;                /**< bitmask of lent out buffers */
+    /**
+     * @brief   Buffers lent out by netdev_driver_t::recv_loan
+     */
+    uint8_t rx_bufs[CONFIG_SOCKET_ZEP_RX_LOAN_NUMOF]
+                   [sizeof(zep_v2_data_hdr_t) + IEEE802154_FRAME_LEN_MAX];
+#endif
 } socket_zep_t;
 
 /**
@@ -10,6 +10,10 @@
  * @{
  * @brief       mtd flash emulation for native
  *
+ * The image file is mapped into memory on init and stays mapped until the
+ * process exits (a reboot re-executes it), so all operations are plain memory
+ * accesses.
+ *
  * @file
  *
  * @author      Vincent Dupont <vincent@otakeys.com>
@@ -18,6 +22,9 @@
 #include <stdio.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
 
 #include "mtd.h"
 #include "mtd_native.h"
@@ -29,27 +36,54 @@
 
 #define MIN(a, b) ((a) > (b) ? (b) : (a))
 
+static size_t _size(const mtd_dev_t *dev)
+{
+    return (size_t)dev->sector_count * dev->pages_per_sector * dev->page_size;
+}
+
 static int _init(mtd_dev_t *dev)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t size = _size(dev);
 
     DEBUG("mtd_native: init, filename=%s\n", _dev->fname);
 
-    FILE *f = real_fopen(_dev->fname, "r");
+    /* file systems call mtd_init() on every mount */
+    if (_dev->map) {
+        return 0;
+    }
 
-    if (!f) {
-        DEBUG("mtd_native: init: creating file %s\n", _dev->fname);
-        f = real_fopen(_dev->fname, "w+");
-        if (!f) {
+    int fd = real_open(_dev->fname, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return -EIO;
+    }
+
+    off_t old_size = real_lseek(fd, 0, SEEK_END);
+    if (old_size < 0) {
+        real_close(fd);
+        return -EIO;
+    }
+    if ((size_t)old_size < size) {
+        DEBUG("mtd_native: init: growing file %s to %zu bytes\n",
+              _dev->fname, size);
+        if (real_ftruncate(fd, size) < 0) {
+            real_close(fd);
             return -EIO;
         }
-        size_t size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-        for (size_t i = 0; i < size; i++) {
-            real_fputc(0xff, f);
-        }
     }
 
-    real_fclose(f);
+    void *map = real_mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* the mapping keeps the file referenced */
+    real_close(fd);
+    if (map == MAP_FAILED) {
+        return -EIO;
+    }
+    _dev->map = map;
+
+    /* ftruncate() fills with zeros, but fresh flash is erased */
+    if ((size_t)old_size < size) {
+        memset(_dev->map + old_size, 0xff, size - old_size);
+    }
 
     return 0;
 }
@@ -57,64 +91,81 @@ static int _init(mtd_dev_t *dev)
 static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
 
     DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if ((size_t)addr + size > _size(dev)) {
         return -EOVERFLOW;
     }
 
-    FILE *f = real_fopen(_dev->fname, "r");
-    if (!f) {
-        return -EIO;
+    memcpy(buff, _dev->map + addr, size);
+
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *dev, void *buff, uint32_t page,
+                      uint32_t offset, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t addr = (size_t)page * dev->page_size + offset;
+
+    DEBUG("mtd_native: read from page %" PRIu32 ", offset 0x%" PRIx32 " count %" PRIu32 "\n",
+          page, offset, size);
+
+    if (addr + size > _size(dev)) {
+        return -EOVERFLOW;
     }
-    real_fseek(f, addr, SEEK_SET);
-    size_t nread = real_fread(buff, 1, size, f);
-    real_fclose(f);
 
-    return (nread == size) ? 0 : -EIO;
+    memcpy(buff, _dev->map + addr, size);
+
+    return size;
+}
+
+/* programming flash can only clear bits */
+static int _program(uint8_t *dst, const uint8_t *src, size_t size)
+{
+    if (IS_ACTIVE(CONFIG_MTD_NATIVE_STRICT)) {
+        for (size_t i = 0; i < size; i++) {
+            if (src[i] & ~dst[i]) {
+                DEBUG("mtd_native: write to non-erased byte\n");
+                return -EIO;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        dst[i] &= src[i];
+    }
+
+    return 0;
 }
 
 static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
 
     DEBUG("mtd_native: write from 0x%" PRIx32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if ((size_t)addr + size > _size(dev)) {
         return -EOVERFLOW;
     }
     if (((addr % dev->page_size) + size) > dev->page_size) {
         return -EOVERFLOW;
     }
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
-        return -EIO;
-    }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        uint8_t c = real_fgetc(f);
-        real_fseek(f, -1, SEEK_CUR);
-        real_fputc(c & ((uint8_t*)buff)[i], f);
-    }
-    real_fclose(f);
-
-    return 0;
+    return _program(_dev->map + addr, buff, size);
 }
 
 static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page, uint32_t offset,
                        uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    uint32_t addr = page * dev->page_size + offset;
+    size_t addr = (size_t)page * dev->page_size + offset;
 
     DEBUG("mtd_native: write from page %" PRIx32 ", offset 0x%" PRIx32 " count %" PRIu32 "\n",
           page, offset, size);
 
-    if (page > dev->sector_count * dev->pages_per_sector) {
+    if (page >= dev->sector_count * dev->pages_per_sector) {
         return -EOVERFLOW;
     }
 
@@ -125,45 +176,42 @@ static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page, uint32_t
     uint32_t remaining = dev->page_size - offset;
     size = MIN(remaining, size);
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
-        return -EIO;
-    }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        uint8_t c = real_fgetc(f);
-        real_fseek(f, -1, SEEK_CUR);
-        real_fputc(c & ((uint8_t*)buff)[i], f);
-    }
-    real_fclose(f);
+    int res = _program(_dev->map + addr, buff, size);
 
-    return size;
+    return res < 0 ? res : (int)size;
 }
 
 static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
     size_t sector_size = dev->pages_per_sector * dev->page_size;
 
     DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if ((size_t)addr + size > _size(dev)) {
         return -EOVERFLOW;
     }
     if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
         return -EOVERFLOW;
     }
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
-        return -EIO;
-    }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        real_fputc(0xff, f);
+    memset(_dev->map + addr, 0xff, size);
+
+    return 0;
+}
+
+static int _erase_sector(mtd_dev_t *dev, uint32_t sector, uint32_t count)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t sector_size = dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: erase sector %" PRIu32 " count %" PRIu32 "\n", sector, count);
+
+    if ((uint64_t)sector + count > dev->sector_count) {
+        return -EOVERFLOW;
     }
-    real_fclose(f);
+
+    memset(_dev->map + sector * sector_size, 0xff, count * sector_size);
 
     return 0;
 }
@@ -179,10 +227,12 @@ static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 
 const mtd_desc_t native_flash_driver = {
     .read = _read,
+    .read_page = _read_page,
     .power = _power,
     .write = _write,
     .write_page = _write_page,
     .erase = _erase,
+    .erase_sector = _erase_sector,
     .init = _init,
 };
 
@@ -52,7 +52,9 @@
 
 #include "async_read.h"
 
+#include "bitarithm.h"
 #include "iolist.h"
+#include "irq.h"
 #include "net/eui64.h"
 #include "net/netdev.h"
 #include "net/netdev/eth.h"
@@ -68,6 +70,10 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+static int _recv_loan(netdev_t *netdev, void **buf, void *info);
+static void _recv_return(netdev_t *netdev, void *buf);
+#endif
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -158,6 +164,10 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
 static const netdev_driver_t netdev_driver_tap = {
     .send = _send,
     .recv = _recv,
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+    .recv_loan = _recv_loan,
+    .recv_return = _recv_return,
+#endif
     .init = _init,
     .isr = _isr,
     .get = _get,
@@ -179,6 +189,12 @@ static inline bool _is_addr_multicast(uint8_t *addr)
 
 static void _continue_reading(netdev_tap_t *dev)
 {
+    /* the epoll backend checks for further data itself */
+    if (IS_USED(MODULE_NATIVE_ASYNC_READ_EPOLL)) {
+        native_async_read_continue(dev->tap_fd);
+        return;
+    }
+
     /* work around lost signals */
     fd_set rfds;
     struct timeval t;
@@ -204,36 +220,8 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+static int _read(netdev_tap_t *dev, void *buf, size_t len)
 {
-    netdev_tap_t *dev = (netdev_tap_t*)netdev;
-    (void)info;
-
-    if (!buf) {
-        if (len > 0) {
-            /* no memory available in pktbuf, discarding the frame */
-            DEBUG("netdev_tap: discarding the frame\n");
-
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
-
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
-
-            _continue_reading(dev);
-        }
-
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
-    }
-
     int nread = real_read(dev->tap_fd, buf, len);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
@@ -273,6 +261,85 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return -1;
 }
 
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev_tap: discarding the frame\n");
+
+            /* repeating `real_read` for small size on tap device results in
+             * freeze for some reason. Using a large buffer for now. */
+            /*
+            uint8_t buf[4];
+            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
+            }
+            */
+
+            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
+
+            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
+
+            _continue_reading(dev);
+        }
+
+        /* no way of figuring out packet size without racey buffering,
+         * so we return the maximum possible size */
+        return ETHERNET_FRAME_LEN;
+    }
+
+    return _read(dev, buf, len);
+}
+
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+static void _rx_buf_free(netdev_tap_t *dev, unsigned idx)
+{
+    unsigned state = irq_disable();
+
+    dev->rx_lent &= ~(1U << idx);
+    irq_restore(state);
+}
+
+static int _recv_loan(netdev_t *netdev, void **buf, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    unsigned state = irq_disable();
+    unsigned avail = ~dev->rx_lent &
+                     ((1U << CONFIG_NETDEV_TAP_RX_LOAN_NUMOF) - 1);
+    (void)info;
+
+    if (avail == 0) {
+        irq_restore(state);
+        DEBUG("netdev_tap: all receive buffers lent out\n");
+        return -ENOBUFS;
+    }
+    unsigned idx = bitarithm_lsb(avail);
+    dev->rx_lent |= 1U << idx;
+    irq_restore(state);
+
+    int nread = _read(dev, dev->rx_bufs[idx], sizeof(dev->rx_bufs[idx]));
+    if (nread <= 0) {
+        _rx_buf_free(dev, idx);
+        return nread;
+    }
+    *buf = dev->rx_bufs[idx];
+    return nread;
+}
+
+static void _recv_return(netdev_t *netdev, void *buf)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    unsigned idx = ((uint8_t *)buf - dev->rx_bufs[0]) / sizeof(dev->rx_bufs[0]);
+
+    assert(buf == dev->rx_bufs[idx]);
+    assert(dev->rx_lent & (1U << idx));
+    _rx_buf_free(dev, idx);
+}
+#endif
+
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -39,7 +39,18 @@
 static void _native_sleep(void)
 {
     _native_in_syscall++; /* no switching here */
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    /* skip to the next timer deadline unless host I/O arrives in time, only
+     * wait for real if there is neither */
+    if ((_native_sigpend == 0) &&
+        ((native_async_read_wait(CONFIG_NATIVE_VIRTUAL_TIME_IO_WAIT_MS) > 0) ||
+         !native_virtual_time_fast_forward()) &&
+        (_native_sigpend == 0)) {
+        real_pause();
+    }
+#else
     real_pause();
+#endif
     _native_in_syscall--;
 
     if (_native_sigpend > 0) {
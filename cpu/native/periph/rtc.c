@@ -46,6 +46,20 @@ static time_t _native_rtc_offset;
 
 static xtimer_t _native_rtc_timer;
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/* host time when the RTC was initialized, the RTC then follows virtual time */
+static time_t _native_rtc_epoch;
+#endif
+
+static time_t _time(void)
+{
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    return _native_rtc_epoch + native_virtual_time_us() / US_PER_SEC;
+#else
+    return time(NULL);
+#endif
+}
+
 static void _native_rtc_cb(void *arg) {
     if (_native_rtc_alarm_callback) {
         _native_rtc_alarm_callback(arg);
@@ -77,6 +91,9 @@ void rtc_init(void)
     _native_rtc_alarm_callback = NULL;
 
     _native_rtc_offset = 0;
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+    _native_rtc_epoch = time(NULL) - native_virtual_time_us() / US_PER_SEC;
+#endif
 
     _native_rtc_initialized = 1;
     printf("Native RTC initialized.\n");
@@ -141,7 +158,7 @@ int rtc_set_time(struct tm *ttime)
         return -1;
     }
     _native_syscall_enter();
-    _native_rtc_offset = tnew - time(NULL);
+    _native_rtc_offset = tnew - _time();
     _native_syscall_leave();
 
     if (_native_rtc_alarm_callback) {
@@ -166,7 +183,7 @@ int rtc_get_time(struct tm *ttime)
     }
 
     _native_syscall_enter();
-    t = time(NULL) + _native_rtc_offset;
+    t = _time() + _native_rtc_offset;
 
     if (localtime_r(&t, ttime) == NULL) {
         err(EXIT_FAILURE, "rtc_get_time: localtime_r");
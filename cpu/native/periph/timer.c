@@ -17,6 +17,10 @@
  *
  * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
  *
+ * With module native_virtual_time the timer counts virtual time instead:
+ * every timer_read() advances it by one tick, and when RIOT is idle it jumps
+ * straight to the next timer deadline.
+ *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
@@ -38,6 +42,8 @@
 #include <time.h>
 #include <sys/time.h>
 #include <signal.h>
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -58,6 +64,14 @@ static unsigned long time_null;
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+static uint64_t _now;
+static uint64_t _deadline;
+static uint64_t _period;
+/* time left of a stopped timer */
+static uint64_t _remaining;
+static bool _armed;
+#else
 static struct itimerval itv;
 
 /**
@@ -68,6 +82,7 @@ static unsigned long ts2ticks(struct timespec *tp)
     /* TODO: check for overflow */
     return (((unsigned long)tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
 }
+#endif
 
 /**
  * native timer signal handler
@@ -105,6 +120,59 @@ int timer_init(tim_t dev, uint32_t freq, timer_cb_t cb, void *arg)
     return 0;
 }
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+/* pends the timer interrupt if the deadline passed, must be called with
+ * _native_in_syscall set */
+static void _check_deadline(void)
+{
+    int sig = SIGALRM;
+
+    if (!_armed || (_now < _deadline)) {
+        return;
+    }
+    if (_period) {
+        _deadline += _period;
+    }
+    else {
+        _armed = false;
+    }
+    if (real_write(_sig_pipefd[1], &sig, sizeof(sig)) == -1) {
+        err(EXIT_FAILURE, "timer: real_write()");
+    }
+    _native_sigpend++;
+}
+
+uint64_t native_virtual_time_us(void)
+{
+    return _now;
+}
+
+bool native_virtual_time_fast_forward(void)
+{
+    if (!_armed) {
+        return false;
+    }
+    if (_now < _deadline) {
+        DEBUG("%s: skipping %" PRIu64 " us\n", __func__, _deadline - _now);
+        _now = _deadline;
+    }
+    _check_deadline();
+    return true;
+}
+
+static void do_timer_set(tim_t dev, unsigned int offset, bool periodic)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+
+    _native_syscall_enter();
+    _armed = (offset != 0);
+    _deadline = _now + offset;
+    _period = periodic ? offset : 0;
+    _remaining = 0;
+    _native_syscall_leave();
+}
+#else
 static void do_timer_set(tim_t dev, unsigned int offset, bool periodic)
 {
     DEBUG("%s\n", __func__);
@@ -124,6 +192,7 @@ static void do_timer_set(tim_t dev, unsigned int offset, bool periodic)
 
     timer_start(dev);
 }
+#endif
 
 int timer_set(tim_t dev, int channel, unsigned int offset)
 {
@@ -170,6 +239,49 @@ int timer_clear(tim_t dev, int channel)
     return 0;
 }
 
+#ifdef MODULE_NATIVE_VIRTUAL_TIME
+void timer_start(tim_t dev)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+
+    _native_syscall_enter();
+    if (!_armed && _remaining) {
+        _deadline = _now + _remaining;
+        _armed = true;
+        _remaining = 0;
+    }
+    _native_syscall_leave();
+}
+
+void timer_stop(tim_t dev)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+
+    _native_syscall_enter();
+    if (_armed) {
+        _remaining = (_deadline > _now) ? _deadline - _now : 1;
+        _armed = false;
+    }
+    _native_syscall_leave();
+}
+
+unsigned int timer_read(tim_t dev)
+{
+    if (dev >= TIMER_NUMOF) {
+        return 0;
+    }
+
+    _native_syscall_enter();
+    /* every read takes a tick, so busy waiting on the timer terminates */
+    _now++;
+    _check_deadline();
+    _native_syscall_leave();
+
+    return _now - time_null;
+}
+#else
 void timer_start(tim_t dev)
 {
     (void)dev;
@@ -227,3 +339,4 @@ unsigned int timer_read(tim_t dev)
 
     return ts2ticks(&t) - time_null;
 }
+#endif
@@ -25,8 +25,10 @@
 #include <sys/time.h>
 
 #include "async_read.h"
+#include "bitarithm.h"
 #include "byteorder.h"
 #include "checksum/ucrc16.h"
+#include "irq.h"
 #include "native_internal.h"
 #include "random.h"
 
@@ -135,6 +137,12 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 
 static void _continue_reading(socket_zep_t *dev)
 {
+    /* the epoll backend checks for further data itself */
+    if (IS_USED(MODULE_NATIVE_ASYNC_READ_EPOLL)) {
+        native_async_read_continue(dev->sock_fd);
+        return;
+    }
+
     /* work around lost signals */
     fd_set rfds;
     struct timeval t;
@@ -177,6 +185,70 @@ static inline bool _dst_not_me(socket_zep_t *dev, const void *buf)
     }
 }
 
+/* reads a frame into rcv_buf and returns the length of the payload, which
+ * starts at *payload */
+static int _read(socket_zep_t *dev, uint8_t *rcv_buf, size_t len,
+                 void **payload, void *info)
+{
+    int size = real_read(dev->sock_fd, rcv_buf, sizeof(dev->rcv_buf));
+
+    if (size > 0) {
+        zep_hdr_t *tmp = (zep_hdr_t *)rcv_buf;
+
+        if ((tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
+            DEBUG("socket_zep::recv: invalid ZEP header");
+            return -1;
+        }
+        switch (tmp->version) {
+            case 2: {
+                zep_v2_data_hdr_t *zep = (zep_v2_data_hdr_t *)tmp;
+
+                *payload = &rcv_buf[sizeof(zep_v2_data_hdr_t)];
+                if (zep->type != ZEP_V2_TYPE_DATA) {
+                    DEBUG("socket_zep::recv: unexpected ZEP type\n");
+                    /* don't support ACK frames for now*/
+                    return -1;
+                }
+                if (((sizeof(zep_v2_data_hdr_t) + zep->length) != (unsigned)size) ||
+                    (zep->length > len) || (zep->chan != dev->netdev.chan) ||
+                    /* TODO promiscuous mode */
+                    _dst_not_me(dev, *payload)) {
+                    /* TODO: check checksum */
+                    return -1;
+                }
+                /* don't hand FCS to stack */
+                size = zep->length - sizeof(uint16_t);
+                if (info != NULL) {
+                    struct netdev_radio_rx_info *rx_info = info;
+                    rx_info->lqi = zep->lqi_val;
+                    rx_info->rssi = UINT8_MAX;
+                }
+                break;
+            }
+            default:
+                DEBUG("socket_zep::recv: unexpected ZEP version\n");
+                return -1;
+        }
+    }
+    else if (size == 0) {
+        DEBUG("socket_zep::recv: ignoring null-event\n");
+        return -1;
+    }
+    else if (size == -1) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        }
+        else {
+            err(EXIT_FAILURE, "zep: read");
+        }
+    }
+    else {
+        errx(EXIT_FAILURE, "internal error _rx_event");
+    }
+    _continue_reading(dev);
+
+    return size;
+}
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     socket_zep_t *dev = (socket_zep_t *)netdev;
@@ -196,70 +268,61 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
         return size;
     }
-    else if (len > 0) {
-        size = real_read(dev->sock_fd, dev->rcv_buf, sizeof(dev->rcv_buf));
 
-        if (size > 0) {
-            zep_hdr_t *tmp = (zep_hdr_t *)&dev->rcv_buf;
+    void *payload;
 
-            if ((tmp->preamble[0] != 'E') || (tmp->preamble[1] != 'X')) {
-                DEBUG("socket_zep::recv: invalid ZEP header");
-                return -1;
-            }
-            switch (tmp->version) {
-                case 2: {
-                    zep_v2_data_hdr_t *zep = (zep_v2_data_hdr_t *)tmp;
-                    void *payload = &dev->rcv_buf[sizeof(zep_v2_data_hdr_t)];
-
-                    if (zep->type != ZEP_V2_TYPE_DATA) {
-                        DEBUG("socket_zep::recv: unexpected ZEP type\n");
-                        /* don't support ACK frames for now*/
-                        return -1;
-                    }
-                    if (((sizeof(zep_v2_data_hdr_t) + zep->length) != (unsigned)size) ||
-                        (zep->length > len) || (zep->chan != dev->netdev.chan) ||
-                        /* TODO promiscuous mode */
-                        _dst_not_me(dev, payload)) {
-                        /* TODO: check checksum */
-                        return -1;
-                    }
-                    /* don't hand FCS to stack */
-                    size = zep->length - sizeof(uint16_t);
-                    if (buf != NULL) {
-                        memcpy(buf, payload, size);
-                        if (info != NULL) {
-                            struct netdev_radio_rx_info *rx_info = info;
-                            rx_info->lqi = zep->lqi_val;
-                            rx_info->rssi = UINT8_MAX;
-                        }
-                    }
-                    break;
-                }
-                default:
-                    DEBUG("socket_zep::recv: unexpected ZEP version\n");
-                    return -1;
-            }
-        }
-        else if (size == 0) {
-            DEBUG("socket_zep::recv: ignoring null-event\n");
-            return -1;
-        }
-        else if (size == -1) {
-            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-            }
-            else {
-                err(EXIT_FAILURE, "zep: read");
-            }
-        }
-        else {
-            errx(EXIT_FAILURE, "internal error _rx_event");
-        }
+    size = _read(dev, dev->rcv_buf, len, &payload, info);
+    if (size > 0) {
+        memcpy(buf, payload, size);
     }
-    _continue_reading(dev);
+    return size;
+}
+
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+static void _rx_buf_free(socket_zep_t *dev, unsigned idx)
+{
+    unsigned state = irq_disable();
 
+    dev->rx_lent &= ~(1U << idx);
+    irq_restore(state);
+}
+
+static int _recv_loan(netdev_t *netdev, void **buf, void *info)
+{
+    socket_zep_t *dev = (socket_zep_t *)netdev;
+    unsigned state = irq_disable();
+    unsigned avail = ~dev->rx_lent &
+                     ((1U << CONFIG_SOCKET_ZEP_RX_LOAN_NUMOF) - 1);
+
+    if (avail == 0) {
+        irq_restore(state);
+        DEBUG("socket_zep::recv_loan: all receive buffers lent out\n");
+        return -ENOBUFS;
+    }
+    unsigned idx = bitarithm_lsb(avail);
+    dev->rx_lent |= 1U << idx;
+    irq_restore(state);
+
+    int size = _read(dev, dev->rx_bufs[idx], IEEE802154_FRAME_LEN_MAX, buf,
+                     info);
+    if (size <= 0) {
+        _rx_buf_free(dev, idx);
+    }
     return size;
 }
 
+static void _recv_return(netdev_t *netdev, void *buf)
+{
+    socket_zep_t *dev = (socket_zep_t *)netdev;
+    /* buf points to the payload behind the ZEP header */
+    unsigned idx = ((uint8_t *)buf - dev->rx_bufs[0]) / sizeof(dev->rx_bufs[0]);
+
+    assert(buf == &dev->rx_bufs[idx][sizeof(zep_v2_data_hdr_t)]);
+    assert(dev->rx_lent & (1U << idx));
+    _rx_buf_free(dev, idx);
+}
+#endif
+
 static void _isr(netdev_t *netdev)
 {
     if (netdev->event_callback) {
@@ -319,6 +382,10 @@ static int _set(netdev_t *netdev, netopt_t opt, const void *value,
 static const netdev_driver_t socket_zep_driver = {
     .send = _send,
     .recv = _recv,
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+    .recv_loan = _recv_loan,
+    .recv_return = _recv_return,
+#endif
     .init = _init,
     .isr = _isr,
     .get = _get,
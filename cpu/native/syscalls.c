@@ -55,6 +55,8 @@ void (*real_free)(void *ptr);
 void* (*real_malloc)(size_t size);
 void* (*real_calloc)(size_t nmemb, size_t size);
 void* (*real_realloc)(void *ptr, size_t size);
+void* (*real_mmap)(void *addr, size_t len, int prot, int flags, int fd,
+                   off_t off);
 void (*real_freeaddrinfo)(struct addrinfo *res);
 void (*real_freeifaddrs)(struct ifaddrs *ifa);
 void (*real_srandom)(unsigned int seed);
@@ -69,6 +71,7 @@ int (*real_getpid)(void);
 int (*real_chdir)(const char *path);
 int (*real_close)(int);
 int (*real_fcntl)(int, int, ...);
+int (*real_ftruncate)(int fd, off_t length);
 int (*real_creat)(const char *path, ...);
 int (*real_dup2)(int, int);
 int (*real_execve)(const char *, char *const[], char *const[]);
@@ -76,6 +79,7 @@ int (*real_fork)(void);
 int (*real_feof)(FILE *stream);
 int (*real_ferror)(FILE *stream);
 int (*real_listen)(int socket, int backlog);
+off_t (*real_lseek)(int fd, off_t offset, int whence);
 int (*real_ioctl)(int fildes, int request, ...);
 int (*real_open)(const char *path, int oflag, ...);
 int (*real_pause)(void);
@@ -461,6 +465,9 @@ void _native_init_syscalls(void)
     *(void **)(&real_chdir) = dlsym(RTLD_NEXT, "chdir");
     *(void **)(&real_close) = dlsym(RTLD_NEXT, "close");
     *(void **)(&real_fcntl) = dlsym(RTLD_NEXT, "fcntl");
+    *(void **)(&real_ftruncate) = dlsym(RTLD_NEXT, "ftruncate");
+    *(void **)(&real_lseek) = dlsym(RTLD_NEXT, "lseek");
+    *(void **)(&real_mmap) = dlsym(RTLD_NEXT, "mmap");
     *(void **)(&real_creat) = dlsym(RTLD_NEXT, "creat");
     *(void **)(&real_fork) = dlsym(RTLD_NEXT, "fork");
     *(void **)(&real_dup2) = dlsym(RTLD_NEXT, "dup2");
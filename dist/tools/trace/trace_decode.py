@@ -0,0 +1,97 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Script to convert the binary stream written by `trace_export()` (provided by
+the `trace` module) to text.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x43525452
+VERSION = 1
+HDR_FMT = "IHHII"
+ENTRY_FMT = "IHhI"
+
+EVENTS = [
+    "user",
+    "lost",
+    "sched_out",
+    "sched_in",
+    "isr_enter",
+    "isr_exit",
+    "mutex_lock",
+    "mutex_locked",
+    "mutex_unlock",
+    "msg_send",
+    "msg_receive",
+    "netapi_dispatch",
+    "netapi_send",
+]
+EVENT_APP = 0x8000
+
+
+def event_name(event):
+    if event < len(EVENTS):
+        return EVENTS[event]
+    if event >= EVENT_APP:
+        return "app+{}".format(event - EVENT_APP)
+    return "0x{:04x}".format(event)
+
+
+def read_hdr(stream):
+    """Returns (byte order, frequency, number of entries) or None at EOF"""
+    data = stream.read(struct.calcsize("<" + HDR_FMT))
+    if not data:
+        return None
+    for order in "<>":
+        magic, version, entry_size, freq, numof = struct.unpack(order + HDR_FMT,
+                                                                data)
+        if (magic == MAGIC) and (version == VERSION):
+            if entry_size != struct.calcsize(order + ENTRY_FMT):
+                raise ValueError("unexpected entry size {}".format(entry_size))
+            return order, freq, numof
+    raise ValueError("not a trace stream or unsupported version")
+
+
+def decode(stream, out):
+    # timestamps wrap around, so they are accumulated from the differences
+    total = None
+    last = 0
+    while True:
+        hdr = read_hdr(stream)
+        if hdr is None:
+            break
+        order, freq, numof = hdr
+        fmt = order + ENTRY_FMT
+        for _ in range(numof):
+            time, event, pid, arg = struct.unpack(fmt,
+                                                  stream.read(struct.calcsize(fmt)))
+            total = 0 if total is None else total + ((time - last) & 0xffffffff)
+            last = time
+            if freq:
+                stamp = "{:16.9f}".format(total / freq)
+            else:
+                stamp = "{:16d}".format(total)
+            out.write("{} pid={:3d} {:<16} 0x{:08x}\n".format(
+                stamp, pid, event_name(event), arg))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("infile", nargs="?", type=argparse.FileType("rb"),
+                        default=sys.stdin.buffer,
+                        help="binary trace stream (default: stdin)")
+    args = parser.parse_args()
+    decode(args.infile, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -98,6 +98,12 @@
  * This receive sequence can of course be simplified by skipping steps 2 and 3
  * when using fixed sized pre-allocated buffers or similar means. *
  *
+ * Drivers that receive into buffers of their own (e.g. via DMA) can offer
+ * @ref netdev_driver_t::recv_loan "recv_loan()" with module `netdev_rx_loan`.
+ * It replaces steps 2 to 4 by lending the driver's buffer to the caller,
+ * which hands it back with @ref netdev_driver_t::recv_return "recv_return()"
+ * when done. This saves copying the frame.
+ *
  * @note    The @ref netdev_driver_t::send "send()" and
  *          @ref netdev_driver_t::recv "recv()" functions **must** never be
  *          called from interrupt context.
@@ -478,6 +484,47 @@ typedef struct netdev_driver {
      */
     int (*recv)(netdev_t *dev, void *buf, size_t len, void *info);
 
+#if defined(MODULE_NETDEV_RX_LOAN) || defined(DOXYGEN)
+    /**
+     * @brief   Get a received frame without copying it
+     *
+     * @pre     `(dev != NULL) && (buf != NULL)`
+     *
+     * Instead of copying the frame into a buffer of the caller like
+     * netdev_driver_t::recv, the driver lends out the buffer the frame was
+     * received into. The caller owns the buffer until it hands it back with
+     * netdev_driver_t::recv_return, so it can pass it up the stack without
+     * copying. The driver must not reuse the buffer meanwhile.
+     *
+     * Only present with module `netdev_rx_loan`. Drivers that don't support
+     * this set it (and netdev_driver_t::recv_return) to `NULL`.
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[out]  buf     the buffer holding the frame
+     * @param[out]  info    status information for the received frame, as for
+     *                      netdev_driver_t::recv. May be NULL.
+     *
+     * @retval  -ENOBUFS    all of the driver's buffers are lent out. The
+     *                      frame is left in the device, so it can still be
+     *                      received with netdev_driver_t::recv.
+     * @retval  <0          other error, the frame was dropped
+     * @retval  0           the driver dropped the frame, e.g. because of
+     *                      its destination address. @p buf is not set.
+     * @return  length of the frame in @p buf
+     */
+    int (*recv_loan)(netdev_t *dev, void **buf, void *info);
+
+    /**
+     * @brief   Hand a buffer lent out by netdev_driver_t::recv_loan back
+     *
+     * Can be called from any thread, but not from ISRs.
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[in]   buf     the buffer returned by netdev_driver_t::recv_loan
+     */
+    void (*recv_return)(netdev_t *dev, void *buf);
+#endif
+
     /**
      * @brief   the driver's initialization function
      *
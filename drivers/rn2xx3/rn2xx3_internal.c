@@ -53,7 +53,7 @@ static bool _wait_reply(rn2xx3_t *dev, uint8_t timeout)
 
     xtimer_ticks64_t sent_time = xtimer_now64();
 
-    xtimer_t resp_timer;
+    xtimer_t resp_timer = { 0 };
     resp_timer.callback = isr_resp_timeout;
     resp_timer.arg = dev;
 
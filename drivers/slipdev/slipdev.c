@@ -189,15 +189,26 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         uint8_t *ptr = buf;
 
         do {
-            int tmp;
+            const uint8_t *data;
+            size_t avail = tsrb_peek_contiguous(&dev->inbuf, &data);
+            size_t i = 0;
 
-            if ((byte = tsrb_get_one(&dev->inbuf)) < 0) {
+            if (avail == 0) {
                 /* something went wrong, return error */
                 return -EIO;
             }
-            tmp = slipdev_unstuff_readbyte(ptr, byte, &escaped);
-            ptr += tmp;
-            res += tmp;
+            /* unstuff in place up to the end of the packet or of the
+             * contiguous part of the ringbuffer */
+            do {
+                int tmp;
+
+                byte = data[i++];
+                tmp = slipdev_unstuff_readbyte(ptr, byte, &escaped);
+                ptr += tmp;
+                res += tmp;
+            } while ((byte != SLIPDEV_END) && (i < avail) &&
+                     ((unsigned)res <= len));
+            tsrb_drop(&dev->inbuf, i);
             if ((unsigned)res > len) {
                 while (byte != SLIPDEV_END) {
                     /* clear out unreceived packet */
@@ -418,7 +418,7 @@ ssize_t sock_udp_recv_buf_aux(sock_udp_t *sock, void **data, void **buf_ctx,
     }
 
 #ifdef MODULE_ZTIMER_USEC
-    ztimer_t timer;
+    ztimer_t timer = { 0 };
 
     if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
         timer.callback = _timeout_cb;
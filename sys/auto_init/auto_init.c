@@ -28,6 +28,11 @@
 
 void auto_init(void)
 {
+    if (IS_USED(MODULE_TRACE)) {
+        LOG_DEBUG("Auto init trace.\n");
+        extern void trace_init(void);
+        trace_init();
+    }
     if (IS_USED(MODULE_AUTO_INIT_RANDOM)) {
         LOG_DEBUG("Auto init random.\n");
         extern void auto_init_random(void);
@@ -147,7 +147,7 @@ int conn_can_raw_send(conn_can_raw_t *conn, const struct can_frame *frame, int f
         }
     }
     else {
-        xtimer_t timer;
+        xtimer_t timer = { 0 };
         timer.callback = _tx_conf_timeout;
         timer.arg = conn;
         xtimer_set(&timer, CONN_CAN_RAW_TIMEOUT_TX_CONF);
@@ -217,7 +217,7 @@ int conn_can_raw_recv(conn_can_raw_t *conn, struct can_frame *frame, uint32_t ti
 
     assert(frame != NULL);
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
 
     if (timeout != 0) {
         timer.callback = _rx_timeout;
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdbool.h>
+
+#include "timex.h"
+
+#include "congure/cocoa.h"
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = congure_reno_snd_report_msg_sent,
+    .report_msg_discarded = congure_reno_snd_report_msg_discarded,
+    .report_msgs_timeout = _snd_report_msgs_timeout,
+    .report_msgs_lost = congure_reno_snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = congure_reno_snd_report_ecn_ce,
+};
+
+static unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static unsigned _max(unsigned a, unsigned b)
+{
+    return (a > b) ? a : b;
+}
+
+void congure_cocoa_snd_setup(congure_cocoa_snd_t *c,
+                             const congure_reno_snd_consts_t *consts)
+{
+    congure_reno_snd_setup(&c->super, consts);
+    c->super.super.driver = &_driver;
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+
+    congure_reno_snd_init(cong, ctx);
+    c->strong.srtt = 0;
+    c->strong.rttvar = 0;
+    c->weak.srtt = 0;
+    c->weak.rttvar = 0;
+    c->rto = CONFIG_CONGURE_COCOA_INIT_RTO_MS;
+}
+
+/* see RFC 6298, section 2; returns the estimator's RTO */
+static uint32_t _rtt_update(congure_cocoa_rtt_t *est, uint32_t rtt, unsigned k)
+{
+    if (est->srtt == 0) {
+        est->srtt = _max(rtt, 1U);
+        est->rttvar = rtt / 2;
+    }
+    else {
+        uint32_t diff = (est->srtt > rtt) ? est->srtt - rtt : rtt - est->srtt;
+
+        est->rttvar = (3 * est->rttvar + diff) / 4;
+        est->srtt = _max((7 * est->srtt + rtt) / 8, 1U);
+    }
+    return est->srtt + k * est->rttvar;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+    uint32_t srtt = (c->strong.srtt) ? c->strong.srtt : c->weak.srtt;
+
+    if ((srtt == 0) || (c->super.super.cwnd == 0)) {
+        return -1;
+    }
+    /* spread a window over 4/5 of the RTT, so pacing itself does not limit
+     * the throughput */
+    uint64_t interval = ((uint64_t)srtt * US_PER_MS * msg_size * 4) /
+                        ((uint64_t)c->super.super.cwnd * 5);
+
+    return (interval > INT32_MAX) ? INT32_MAX : (int32_t)interval;
+}
+
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+    congure_snd_msg_t *msg = msgs;
+    bool resent = false;
+
+    /* back off the RTO, but less when it is large already (variable backoff
+     * factor) */
+    c->rto = (c->rto < 1 * MS_PER_SEC) ? c->rto * 3
+           : (c->rto > 3 * MS_PER_SEC) ? (c->rto * 3) / 2
+           : c->rto * 2;
+    if (msgs != NULL) {
+        do {
+            msg = (congure_snd_msg_t *)msg->super.next;
+            resent |= (msg->resends > 0);
+        } while (msg != msgs);
+    }
+    if (resent) {
+        congure_reno_snd_report_msgs_timeout(cong, msgs);
+    }
+    else {
+        congure_reno_snd_t *reno = &c->super;
+        unsigned cwnd = _max(reno->super.cwnd / 2U, 2U * reno->mss);
+
+        reno->super.cwnd = _min(cwnd, CONGURE_WND_SIZE_MAX);
+        reno->ssthresh = reno->super.cwnd;
+        reno->recover_size = 0;
+        reno->dup_acks = 0;
+    }
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+
+    if (msg->size > 0) {
+        uint32_t rtt = ack->recv_time - msg->send_time;
+
+        rtt -= _min(rtt, ack->delay);
+        if (msg->resends == 0) {
+            /* strong estimator: K = 4, weighs 1/2 for the overall RTO */
+            c->rto = (_rtt_update(&c->strong, rtt, 4) + c->rto) / 2;
+        }
+        else {
+            /* weak estimator: K = 1, weighs 1/4 for the overall RTO */
+            c->rto = (_rtt_update(&c->weak, rtt, 1) + 3 * c->rto) / 4;
+        }
+    }
+    congure_reno_snd_report_msg_acked(cong, msg, ack);
+}
+
+/** @} */
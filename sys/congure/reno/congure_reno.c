@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "congure/reno.h"
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+
+static const congure_snd_driver_t _driver = {
+    .init = congure_reno_snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = congure_reno_snd_report_msg_sent,
+    .report_msg_discarded = congure_reno_snd_report_msg_discarded,
+    .report_msgs_timeout = congure_reno_snd_report_msgs_timeout,
+    .report_msgs_lost = congure_reno_snd_report_msgs_lost,
+    .report_msg_acked = congure_reno_snd_report_msg_acked,
+    .report_ecn_ce = congure_reno_snd_report_ecn_ce,
+};
+
+static unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static unsigned _max(unsigned a, unsigned b)
+{
+    return (a > b) ? a : b;
+}
+
+static congure_wnd_size_t _sat(unsigned wnd)
+{
+    return (wnd > CONGURE_WND_SIZE_MAX) ? CONGURE_WND_SIZE_MAX : wnd;
+}
+
+/* initial window, see RFC 5681, section 3.1 */
+static congure_wnd_size_t _init_cwnd(unsigned mss)
+{
+    if (mss > 2190) {
+        return _sat(2 * mss);
+    }
+    if (mss > 1095) {
+        return _sat(3 * mss);
+    }
+    return _sat(4 * mss);
+}
+
+/* ssthresh after loss, see RFC 5681, equation (4) */
+static congure_wnd_size_t _loss_ssthresh(congure_reno_snd_t *c)
+{
+    return _sat(_max(c->in_flight_size / 2U, 2U * c->mss));
+}
+
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_snd_consts_t *consts)
+{
+    c->super.driver = &_driver;
+    c->consts = consts;
+}
+
+void congure_reno_set_mss(congure_reno_snd_t *c, unsigned mss)
+{
+    if (c->super.cwnd == _init_cwnd(c->mss)) {
+        c->super.cwnd = _init_cwnd(mss);
+    }
+    c->mss = mss;
+}
+
+void congure_reno_snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    c->mss = c->consts->init_mss;
+    c->super.cwnd = _init_cwnd(c->mss);
+    c->ssthresh = c->consts->init_ssthresh;
+    c->last_ack = 0;
+    c->last_wnd = 0;
+    c->in_flight_size = 0;
+    c->recover_size = 0;
+    c->dup_acks = 0;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    return -1;
+}
+
+void congure_reno_snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->in_flight_size = _sat(c->in_flight_size + msg_size);
+}
+
+void congure_reno_snd_report_msg_discarded(congure_snd_t *cong,
+                                           unsigned msg_size)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->in_flight_size -= _min(c->in_flight_size, msg_size);
+}
+
+void congure_reno_snd_report_msgs_timeout(congure_snd_t *cong,
+                                          congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    (void)msgs;
+    /* see RFC 5681, section 3.1; the messages stay in flight as the user
+     * retransmits them */
+    c->ssthresh = _loss_ssthresh(c);
+    c->super.cwnd = c->mss;
+    c->recover_size = 0;
+    c->dup_acks = 0;
+}
+
+void congure_reno_snd_report_msgs_lost(congure_snd_t *cong,
+                                       congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    (void)msgs;
+    /* losses not detected by duplicate ACKs are handled like an ECN-CE:
+     * the window is halved without entering fast recovery */
+    if (c->recover_size == 0) {
+        c->ssthresh = _loss_ssthresh(c);
+        c->super.cwnd = c->ssthresh;
+    }
+}
+
+static void _dup_ack(congure_reno_snd_t *c)
+{
+    unsigned frthresh = c->consts->frthresh;
+
+    if (++c->dup_acks < frthresh) {
+        return;
+    }
+    if ((c->dup_acks == frthresh) && (c->recover_size == 0)) {
+        /* fast retransmit, see RFC 6582, section 3.2, step 2 */
+        c->ssthresh = _loss_ssthresh(c);
+        c->recover_size = _max(c->in_flight_size, 1U);
+        c->consts->fr(c);
+        c->super.cwnd = _sat(c->ssthresh + frthresh * c->mss);
+    }
+    else if (c->recover_size > 0) {
+        /* inflate window for every segment that left the network */
+        c->super.cwnd = _sat(c->super.cwnd + c->mss);
+    }
+}
+
+void congure_reno_snd_report_msg_acked(congure_snd_t *cong,
+                                       congure_snd_msg_t *msg,
+                                       congure_snd_ack_t *ack)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+    unsigned acked = msg->size;
+
+    if (acked == 0) {
+        /* see RFC 5681, section 2, for the definition of a duplicate ACK */
+        if ((ack->id == c->last_ack) && (ack->size == 0) &&
+            (ack->wnd == c->last_wnd) && ack->clean &&
+            (c->in_flight_size > 0)) {
+            _dup_ack(c);
+        }
+        c->last_wnd = ack->wnd;
+        return;
+    }
+    c->last_ack = ack->id;
+    c->last_wnd = ack->wnd;
+    c->dup_acks = 0;
+    c->in_flight_size -= _min(c->in_flight_size, acked);
+    if (c->recover_size > 0) {
+        if (acked < c->recover_size) {
+            /* partial ACK, see RFC 6582, section 3.2, step 5 */
+            unsigned cwnd = c->super.cwnd - _min(c->super.cwnd, acked);
+
+            c->recover_size -= acked;
+            c->consts->fr(c);
+            c->super.cwnd = _sat(cwnd + c->mss);
+        }
+        else {
+            /* full ACK, see RFC 6582, section 3.2, step 3 */
+            c->recover_size = 0;
+            c->super.cwnd = _min(c->ssthresh,
+                                 _sat(_max(c->in_flight_size, c->mss) + c->mss));
+        }
+        return;
+    }
+    if (c->super.cwnd < c->ssthresh) {
+        /* slow start, see RFC 5681, equation (2) */
+        c->super.cwnd = _sat(c->super.cwnd + _min(acked, c->mss));
+    }
+    else {
+        /* congestion avoidance, see RFC 5681, equation (3) */
+        unsigned inc = (c->mss * c->mss) / c->super.cwnd;
+
+        c->super.cwnd = _sat(c->super.cwnd + _max(inc, 1U));
+    }
+}
+
+void congure_reno_snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    (void)time;
+    congure_reno_snd_report_msgs_lost(cong, NULL);
+}
+
+/** @} */
@@ -9,6 +9,10 @@
 
 #include "crypto/helper.h"
 
+/* the buffers hold bytes of any type, so words are accessed through a type
+ * that may alias them */
+typedef uint32_t __attribute__((may_alias)) _alias_u32_t;
+
 void crypto_block_inc_ctr(uint8_t block[16], int L)
 {
     uint8_t *b = &block[15];
@@ -20,6 +24,24 @@ void crypto_block_inc_ctr(uint8_t block[16], int L)
     }
 }
 
+void crypto_xor(uint8_t *out, const uint8_t *a, const uint8_t *b, size_t len)
+{
+    if ((((uintptr_t)out | (uintptr_t)a | (uintptr_t)b)
+         & (sizeof(uint32_t) - 1)) == 0) {
+        for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+            *(_alias_u32_t *)(void *)out = *(const _alias_u32_t *)(const void *)a ^
+                                           *(const _alias_u32_t *)(const void *)b;
+            out += sizeof(uint32_t);
+            a += sizeof(uint32_t);
+            b += sizeof(uint32_t);
+        }
+    }
+
+    while (len--) {
+        *out++ = *a++ ^ *b++;
+    }
+}
+
 int crypto_equals(const uint8_t *a, const uint8_t *b, size_t len)
 {
     uint8_t diff = 0;
@@ -20,6 +20,7 @@
 
 
 #include <string.h>
+#include "crypto/helper.h"
 #include "crypto/modes/cbc.h"
 
 int cipher_encrypt_cbc(const cipher_t *cipher, uint8_t iv[16],
@@ -57,33 +58,26 @@ int cipher_encrypt_cbc(const cipher_t *cipher, uint8_t iv[16],
 int cipher_decrypt_cbc(const cipher_t *cipher, uint8_t iv[16],
                        const uint8_t *input, size_t length, uint8_t *output)
 {
-    size_t offset = 0;
-    const uint8_t *input_block, *input_block_last;
     uint8_t block_size;
 
-
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
         return CIPHER_ERR_INVALID_LENGTH;
     }
+    if (length == 0) {
+        return 0;
+    }
 
-    input_block_last = iv;
-    do {
-        input_block = input + offset;
-        uint8_t *output_block = output + offset;
-
-        if (cipher_decrypt(cipher, input_block, output_block) != 1) {
-            return CIPHER_ERR_DEC_FAILED;
-        }
-
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (uint8_t i = 0; i < block_size; ++i) {
-            output_block[i] ^= input_block_last[i];
-        }
+    /* unlike encryption, all blocks can be decrypted in one go */
+    if (cipher_decrypt_blocks(cipher, input, output,
+                              length / block_size) != 1) {
+        return CIPHER_ERR_DEC_FAILED;
+    }
 
-        input_block_last = input_block;
-        offset += block_size;
-    } while (offset < length);
+    /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
+    crypto_xor(output, output, iv, block_size);
+    crypto_xor(output + block_size, output + block_size, input,
+               length - block_size);
 
-    return offset;
+    return length;
 }
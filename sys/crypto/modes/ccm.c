@@ -55,9 +55,7 @@ static int ccm_compute_cbc_mac(const cipher_t *cipher, const uint8_t iv[16],
                                    block_size : length - offset;
 
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (int i = 0; i < block_size_input; ++i) {
-            mac[i] ^= input[offset + i];
-        }
+        crypto_xor(mac, mac, input + offset, block_size_input);
 
         if (cipher_encrypt(cipher, mac, mac_enc) != 1) {
             return CIPHER_ERR_ENC_FAILED;
@@ -18,32 +18,50 @@
  * @}
  */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 
+/* number of counter blocks encrypted per call of the cipher */
+#define CTR_BATCH_BLOCKS    (4U)
+
 int cipher_encrypt_ctr(const cipher_t *cipher, uint8_t nonce_counter[16],
                        uint8_t nonce_len, const uint8_t *input, size_t length,
                        uint8_t *output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = { 0 }, block_size;
+    uint32_t stream[CTR_BATCH_BLOCKS * CIPHER_MAX_BLOCK_SIZE / sizeof(uint32_t)];
+    uint8_t *stream_blocks = (uint8_t *)stream, block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        size_t blocks = (length - offset + block_size - 1) / block_size;
+        size_t stream_len;
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
+        if (blocks > CTR_BATCH_BLOCKS) {
+            blocks = CTR_BATCH_BLOCKS;
+        }
+        else if (blocks == 0) {
+            /* empty input still uses up one counter value */
+            blocks = 1;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        for (size_t i = 0; i < blocks; i++) {
+            memcpy(&stream_blocks[i * block_size], nonce_counter, block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        }
+        if (cipher_encrypt_blocks(cipher, stream_blocks, stream_blocks,
+                                  blocks) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
         }
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        stream_len = blocks * block_size;
+        if (stream_len > length - offset) {
+            stream_len = length - offset;
+        }
+        crypto_xor(output + offset, input + offset, stream_blocks, stream_len);
+        offset += stream_len;
     } while (offset < length);
 
     return offset;
@@ -0,0 +1,400 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Crypto mode - Galois/Counter
+ *
+ * GHASH follows the 4-bit table method of Shoup, as described in the GCM
+ * specification by McGrew and Viega.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "crypto/helper.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/gcm.h"
+
+/* GCM increments only the last 32 bits of the counter block */
+#define GCM_CTR_NONCE_LEN   (GCM_BLOCK_SIZE - 4)
+
+/* reduction of the 4 bits shifted out of the 128 bit value, times x^124 */
+static const uint16_t _last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static uint64_t _get_u64(const uint8_t *buf)
+{
+    uint64_t val = 0;
+
+    for (unsigned i = 0; i < 8; i++) {
+        val = (val << 8) | buf[i];
+    }
+    return val;
+}
+
+static void _put_u64(uint8_t *buf, uint64_t val)
+{
+    for (int i = 7; i >= 0; i--) {
+        buf[i] = val & 0xff;
+        val >>= 8;
+    }
+}
+
+/* Fills the table of multiples of H for all 4 bit values. Bits are in the
+ * reflected order of GCM, so 8 stands for 1 */
+static void _gen_table(cipher_gcm_ctx_t *ctx, const uint8_t h[16])
+{
+    uint64_t vh = _get_u64(h);
+    uint64_t vl = _get_u64(h + 8);
+
+    ctx->h_hi[0] = 0;
+    ctx->h_lo[0] = 0;
+    ctx->h_hi[8] = vh;
+    ctx->h_lo[8] = vl;
+
+    for (unsigned i = 4; i > 0; i >>= 1) {
+        uint64_t t = (vl & 1) * 0xe100000000000000ULL;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ t;
+        ctx->h_hi[i] = vh;
+        ctx->h_lo[i] = vl;
+    }
+
+    for (unsigned i = 2; i <= 8; i *= 2) {
+        for (unsigned j = 1; j < i; j++) {
+            ctx->h_hi[i + j] = ctx->h_hi[i] ^ ctx->h_hi[j];
+            ctx->h_lo[i + j] = ctx->h_lo[i] ^ ctx->h_lo[j];
+        }
+    }
+}
+
+/* x = x * H */
+static void _mult_h(const cipher_gcm_ctx_t *ctx, uint8_t x[16])
+{
+    uint8_t lo = x[15] & 0xf;
+    uint64_t zh = ctx->h_hi[lo];
+    uint64_t zl = ctx->h_lo[lo];
+
+    for (int i = 15; i >= 0; i--) {
+        uint8_t rem;
+
+        lo = x[i] & 0xf;
+        if (i != 15) {
+            rem = zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)_last4[rem] << 48);
+            zh ^= ctx->h_hi[lo];
+            zl ^= ctx->h_lo[lo];
+        }
+
+        rem = zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)_last4[rem] << 48);
+        zh ^= ctx->h_hi[x[i] >> 4];
+        zl ^= ctx->h_lo[x[i] >> 4];
+    }
+
+    _put_u64(x, zh);
+    _put_u64(x + 8, zl);
+}
+
+static void _ghash_update(cipher_gcm_ctx_t *ctx, const uint8_t *data,
+                          size_t len)
+{
+    /* complete a partial block first */
+    while ((ctx->hash_used > 0) && len) {
+        ctx->hash[ctx->hash_used++] ^= *data++;
+        len--;
+        if (ctx->hash_used == GCM_BLOCK_SIZE) {
+            _mult_h(ctx, ctx->hash);
+            ctx->hash_used = 0;
+        }
+    }
+
+    for (; len >= GCM_BLOCK_SIZE; len -= GCM_BLOCK_SIZE) {
+        crypto_xor(ctx->hash, ctx->hash, data, GCM_BLOCK_SIZE);
+        _mult_h(ctx, ctx->hash);
+        data += GCM_BLOCK_SIZE;
+    }
+
+    if (len > 0) {
+        crypto_xor(ctx->hash, ctx->hash, data, len);
+        ctx->hash_used = len;
+    }
+}
+
+/* pads the data hashed so far with zeros to a full block */
+static void _ghash_pad(cipher_gcm_ctx_t *ctx)
+{
+    if (ctx->hash_used > 0) {
+        _mult_h(ctx, ctx->hash);
+        ctx->hash_used = 0;
+    }
+}
+
+int cipher_gcm_init(cipher_gcm_ctx_t *ctx, const cipher_t *cipher,
+                    const uint8_t *nonce, size_t nonce_len)
+{
+    uint8_t h[GCM_BLOCK_SIZE] = { 0 };
+    int res;
+
+    assert(cipher_get_block_size(cipher) == GCM_BLOCK_SIZE);
+
+    if (nonce_len == 0) {
+        return GCM_ERR_INVALID_NONCE_LENGTH;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->cipher = cipher;
+    ctx->stream_used = GCM_BLOCK_SIZE;
+
+    /* H = E(K, 0^128) */
+    res = cipher_encrypt(cipher, h, h);
+    if (res != 1) {
+        return res;
+    }
+    _gen_table(ctx, h);
+    crypto_secure_wipe(h, sizeof(h));
+
+    /* J0 = nonce || 0^31 || 1 for 96 bit nonces,
+     * GHASH(nonce || 0-padding || [0]_64 || [len(nonce)]_64) otherwise */
+    if (nonce_len == GCM_NONCE_LEN) {
+        memcpy(ctx->counter, nonce, GCM_NONCE_LEN);
+        ctx->counter[GCM_BLOCK_SIZE - 1] = 1;
+    }
+    else {
+        uint8_t len_block[GCM_BLOCK_SIZE] = { 0 };
+
+        _put_u64(len_block + 8, (uint64_t)nonce_len * 8);
+        _ghash_update(ctx, nonce, nonce_len);
+        _ghash_pad(ctx);
+        _ghash_update(ctx, len_block, sizeof(len_block));
+        memcpy(ctx->counter, ctx->hash, GCM_BLOCK_SIZE);
+        memset(ctx->hash, 0, GCM_BLOCK_SIZE);
+    }
+
+    res = cipher_encrypt(cipher, ctx->counter, ctx->tag_mask);
+    if (res != 1) {
+        return res;
+    }
+    crypto_block_inc_ctr(ctx->counter, GCM_BLOCK_SIZE - GCM_CTR_NONCE_LEN);
+
+    return 0;
+}
+
+int cipher_gcm_aad(cipher_gcm_ctx_t *ctx, const uint8_t *auth_data,
+                   size_t len)
+{
+    if (ctx->aad_done) {
+        return GCM_ERR_INVALID_STATE;
+    }
+
+    _ghash_update(ctx, auth_data, len);
+    ctx->aad_len += len;
+    return 0;
+}
+
+/* XORs the key stream into input, continuing a partial block if needed */
+static int _crypt(cipher_gcm_ctx_t *ctx, const uint8_t *input, size_t len,
+                  uint8_t *output)
+{
+    size_t bulk_len;
+    int res;
+
+    /* rest of the key stream of a partial block */
+    while ((ctx->stream_used < GCM_BLOCK_SIZE) && len) {
+        *output++ = *input++ ^ ctx->stream[ctx->stream_used++];
+        len--;
+    }
+
+    bulk_len = len - (len % GCM_BLOCK_SIZE);
+    if (bulk_len > 0) {
+        res = cipher_encrypt_ctr(ctx->cipher, ctx->counter, GCM_CTR_NONCE_LEN,
+                                 input, bulk_len, output);
+        if (res < 0) {
+            return res;
+        }
+        input += bulk_len;
+        output += bulk_len;
+        len -= bulk_len;
+    }
+
+    if (len > 0) {
+        res = cipher_encrypt(ctx->cipher, ctx->counter, ctx->stream);
+        if (res != 1) {
+            return res;
+        }
+        crypto_block_inc_ctr(ctx->counter, GCM_BLOCK_SIZE - GCM_CTR_NONCE_LEN);
+        crypto_xor(output, input, ctx->stream, len);
+        ctx->stream_used = len;
+    }
+
+    return 0;
+}
+
+static void _start_text(cipher_gcm_ctx_t *ctx, size_t len)
+{
+    if (!ctx->aad_done) {
+        _ghash_pad(ctx);
+        ctx->aad_done = 1;
+    }
+    ctx->text_len += len;
+}
+
+int cipher_gcm_encrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    int res;
+
+    _start_text(ctx, len);
+    res = _crypt(ctx, input, len, output);
+    if (res < 0) {
+        return res;
+    }
+    _ghash_update(ctx, output, len);
+    return len;
+}
+
+int cipher_gcm_decrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    int res;
+
+    _start_text(ctx, len);
+    /* hash first, output may be input */
+    _ghash_update(ctx, input, len);
+    res = _crypt(ctx, input, len, output);
+    if (res < 0) {
+        return res;
+    }
+    return len;
+}
+
+/* computes the full MAC into ctx->hash */
+static void _finish(cipher_gcm_ctx_t *ctx)
+{
+    uint8_t len_block[GCM_BLOCK_SIZE];
+
+    _ghash_pad(ctx);
+    _put_u64(len_block, ctx->aad_len * 8);
+    _put_u64(len_block + 8, ctx->text_len * 8);
+    _ghash_update(ctx, len_block, sizeof(len_block));
+    crypto_xor(ctx->hash, ctx->hash, ctx->tag_mask, GCM_BLOCK_SIZE);
+}
+
+int cipher_gcm_encrypt_finish(cipher_gcm_ctx_t *ctx, uint8_t *mac,
+                              uint8_t mac_length)
+{
+    if ((mac_length < 4) || (mac_length > GCM_MAC_MAX_LEN)) {
+        crypto_secure_wipe(ctx, sizeof(*ctx));
+        return GCM_ERR_INVALID_MAC_LENGTH;
+    }
+
+    _finish(ctx);
+    memcpy(mac, ctx->hash, mac_length);
+    crypto_secure_wipe(ctx, sizeof(*ctx));
+    return mac_length;
+}
+
+int cipher_gcm_decrypt_finish(cipher_gcm_ctx_t *ctx, const uint8_t *mac,
+                              uint8_t mac_length)
+{
+    int res = 0;
+
+    if ((mac_length < 4) || (mac_length > GCM_MAC_MAX_LEN)) {
+        res = GCM_ERR_INVALID_MAC_LENGTH;
+    }
+    else {
+        _finish(ctx);
+        if (!crypto_equals(ctx->hash, mac, mac_length)) {
+            res = GCM_ERR_INVALID_MAC;
+        }
+    }
+    crypto_secure_wipe(ctx, sizeof(*ctx));
+    return res;
+}
+
+int cipher_encrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t mac_length,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output)
+{
+    cipher_gcm_ctx_t ctx;
+    int res;
+
+    if ((mac_length < 4) || (mac_length > GCM_MAC_MAX_LEN)) {
+        return GCM_ERR_INVALID_MAC_LENGTH;
+    }
+
+    res = cipher_gcm_init(&ctx, cipher, nonce, nonce_len);
+    if (res < 0) {
+        goto out;
+    }
+    cipher_gcm_aad(&ctx, auth_data, auth_data_len);
+    res = cipher_gcm_encrypt_update(&ctx, input, input_len, output);
+    if (res < 0) {
+        goto out;
+    }
+    cipher_gcm_encrypt_finish(&ctx, output + input_len, mac_length);
+    return input_len + mac_length;
+
+out:
+    crypto_secure_wipe(&ctx, sizeof(ctx));
+    return res;
+}
+
+int cipher_decrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t mac_length,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output)
+{
+    cipher_gcm_ctx_t ctx;
+    size_t plain_len;
+    int res;
+
+    if ((mac_length < 4) || (mac_length > GCM_MAC_MAX_LEN)) {
+        return GCM_ERR_INVALID_MAC_LENGTH;
+    }
+    if (input_len < mac_length) {
+        return GCM_ERR_INVALID_MAC;
+    }
+    plain_len = input_len - mac_length;
+
+    res = cipher_gcm_init(&ctx, cipher, nonce, nonce_len);
+    if (res < 0) {
+        goto out;
+    }
+    cipher_gcm_aad(&ctx, auth_data, auth_data_len);
+    res = cipher_gcm_decrypt_update(&ctx, input, plain_len, output);
+    if (res < 0) {
+        goto out;
+    }
+    res = cipher_gcm_decrypt_finish(&ctx, input + plain_len, mac_length);
+    if (res < 0) {
+        /* do not leave unauthenticated plaintext behind */
+        crypto_secure_wipe(output, plain_len);
+        return res;
+    }
+    return plain_len;
+
+out:
+    crypto_secure_wipe(&ctx, sizeof(ctx));
+    return res;
+}
@@ -33,15 +33,96 @@
 #include "xtimer.h"
 #endif
 
+#if IS_USED(MODULE_EVENT_DEADLINE)
+/*
+ * Events posted with a deadline form a prefix of the queue that is sorted by
+ * deadline, queue->deadline_last points to the last of them. Events posted
+ * without a deadline follow in FIFO order.
+ */
+static inline bool _before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+/* must be called with IRQs disabled after an event was taken from the head */
+static inline void _popped(event_queue_t *queue, event_t *event)
+{
+    if (queue->deadline_last == &event->list_node) {
+        queue->deadline_last = NULL;
+    }
+}
+
+void event_post_deadline(event_queue_t *queue, event_t *event,
+                         uint32_t deadline)
+{
+    assert(queue && event);
+
+    thread_t *waiter = NULL;
+
+    unsigned state = irq_disable();
+    if (!event->list_node.next) {
+        if (!queue->event_list.next) {
+            waiter = queue->waiter;
+        }
+        event->deadline = deadline;
+
+        /* find the last event with a deadline not later than this one */
+        clist_node_t *prev = NULL;
+        if (queue->deadline_last) {
+            clist_node_t *node = queue->event_list.next->next;
+            while (!_before(deadline,
+                            container_of(node, event_t, list_node)->deadline)) {
+                prev = node;
+                if (node == queue->deadline_last) {
+                    break;
+                }
+                node = node->next;
+            }
+        }
+
+        if (prev == NULL) {
+            clist_lpush(&queue->event_list, &event->list_node);
+        }
+        else {
+            event->list_node.next = prev->next;
+            prev->next = &event->list_node;
+            if (queue->event_list.next == prev) {
+                queue->event_list.next = &event->list_node;
+            }
+        }
+        if (prev == queue->deadline_last) {
+            queue->deadline_last = &event->list_node;
+        }
+    }
+    irq_restore(state);
+
+    if (waiter) {
+        thread_flags_set(waiter, THREAD_FLAG_EVENT);
+    }
+}
+#else
+static inline void _popped(event_queue_t *queue, event_t *event)
+{
+    (void)queue;
+    (void)event;
+}
+#endif
+
 void event_post(event_queue_t *queue, event_t *event)
 {
     assert(queue && event);
 
+    thread_t *waiter = NULL;
+
     unsigned state = irq_disable();
     if (!event->list_node.next) {
+        /* the waiter drains the queue before blocking again, so only the
+         * first event of a burst needs to wake it up */
+        if (!queue->event_list.next) {
+            waiter = queue->waiter;
+        }
         clist_rpush(&queue->event_list, &event->list_node);
     }
-    thread_t *waiter = queue->waiter;
     irq_restore(state);
 
     if (waiter) {
@@ -55,6 +136,16 @@ void event_cancel(event_queue_t *queue, event_t *event)
     assert(event);
 
     unsigned state = irq_disable();
+#if IS_USED(MODULE_EVENT_DEADLINE)
+    if (queue->deadline_last == &event->list_node) {
+        /* the event before it is the new last one with a deadline, unless the
+         * event is the head of the queue */
+        queue->deadline_last = (queue->event_list.next->next == &event->list_node)
+                             ? NULL
+                             : clist_find_before(&queue->event_list,
+                                                 &event->list_node);
+    }
+#endif
     clist_remove(&queue->event_list, &event->list_node);
     event->list_node.next = NULL;
     irq_restore(state);
@@ -64,6 +155,9 @@ event_t *event_get(event_queue_t *queue)
 {
     unsigned state = irq_disable();
     event_t *result = (event_t *) clist_lpop(&queue->event_list);
+    if (result) {
+        _popped(queue, result);
+    }
     irq_restore(state);
 
     if (result) {
@@ -83,6 +177,7 @@ event_t *event_wait_multi(event_queue_t *queues, size_t n_queues)
             result = container_of(clist_lpop(&queues[i].event_list),
                                   event_t, list_node);
             if (result) {
+                _popped(&queues[i], result);
                 break;
             }
         }
@@ -128,7 +223,7 @@ static event_t *_wait_timeout_xtimer(event_queue_t *queue, xtimer_t *timer)
 
 event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout)
 {
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
 
     thread_flags_clear(THREAD_FLAG_TIMEOUT);
     xtimer_set_timeout_flag(&timer, timeout);
@@ -137,7 +232,7 @@ event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout)
 
 event_t *event_wait_timeout64(event_queue_t *queue, uint64_t timeout)
 {
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
 
     thread_flags_clear(THREAD_FLAG_TIMEOUT);
     xtimer_set_timeout_flag64(&timer, timeout);
@@ -149,7 +244,7 @@ event_t *event_wait_timeout64(event_queue_t *queue, uint64_t timeout)
 event_t *event_wait_timeout_ztimer(event_queue_t *queue,
                                    ztimer_clock_t *clock, uint32_t timeout)
 {
-    ztimer_t timer;
+    ztimer_t timer = { 0 };
     event_t *result;
 
     thread_flags_clear(THREAD_FLAG_TIMEOUT);
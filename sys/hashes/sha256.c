@@ -85,6 +85,14 @@ void *sha256(const void *data, size_t len, void *digest)
     return digest;
 }
 
+void sha256_multi(const void *const data[], size_t len,
+                  void *const digests[], size_t numof)
+{
+    for (size_t i = 0; i < numof; i++) {
+        sha256(data[i], len, digests[i]);
+    }
+}
+
 
 void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
 {
@@ -55,9 +55,6 @@
 #ifdef __BIG_ENDIAN__
 /* Copy a vector of big-endian uint32_t into a vector of bytes */
 #define be32enc_vect memcpy
-
-/* Copy a vector of bytes into a vector of big-endian uint32_t */
-#define be32dec_vect memcpy
 #else /* !__BIG_ENDIAN__ */
 
 /*
@@ -89,50 +86,74 @@ static void be32enc_vect(void *dst_, const void *src_, size_t len)
     }
 }
 
-/*
- * Decode a big-endian length len vector of (unsigned char) into a length
- * len/4 vector of (uint32_t).  Assumes len is a multiple of 4.
- */
-#define be32dec_vect be32enc_vect
-
 #endif /* __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__ */
 
+/* Load a big-endian uint32_t from a possibly unaligned location */
+#define LOAD32_BE(p)    (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                         ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+/* Message words of rounds 0..15, loaded when they are first used */
+#define LOAD(j)         (W[j] = LOAD32_BE(&block[(j) * 4]))
+
+/* Message schedule for rounds 16..63, W is used as a ring of 16 words */
+#define SCHED(j)        (W[(j) & 15] += s1(W[((j) - 2) & 15]) + \
+                                        W[((j) - 7) & 15] + \
+                                        s0(W[((j) - 15) & 15]))
+
+/* One round, the working variables are renamed instead of moved */
+#define RND(a, b, c, d, e, f, g, h, k, w) do { \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + (k) + (w); \
+        d += t0; \
+        h = t0 + S0(a) + Maj(a, b, c); \
+} while (0)
+
+/* 16 rounds starting at round i, MSG(j) yields the j-th word of the ring */
+#define RNDS16(i, MSG) do { \
+        RND(a, b, c, d, e, f, g, h, K[(i) + 0], MSG(0)); \
+        RND(h, a, b, c, d, e, f, g, K[(i) + 1], MSG(1)); \
+        RND(g, h, a, b, c, d, e, f, K[(i) + 2], MSG(2)); \
+        RND(f, g, h, a, b, c, d, e, K[(i) + 3], MSG(3)); \
+        RND(e, f, g, h, a, b, c, d, K[(i) + 4], MSG(4)); \
+        RND(d, e, f, g, h, a, b, c, K[(i) + 5], MSG(5)); \
+        RND(c, d, e, f, g, h, a, b, K[(i) + 6], MSG(6)); \
+        RND(b, c, d, e, f, g, h, a, K[(i) + 7], MSG(7)); \
+        RND(a, b, c, d, e, f, g, h, K[(i) + 8], MSG(8)); \
+        RND(h, a, b, c, d, e, f, g, K[(i) + 9], MSG(9)); \
+        RND(g, h, a, b, c, d, e, f, K[(i) + 10], MSG(10)); \
+        RND(f, g, h, a, b, c, d, e, K[(i) + 11], MSG(11)); \
+        RND(e, f, g, h, a, b, c, d, K[(i) + 12], MSG(12)); \
+        RND(d, e, f, g, h, a, b, c, K[(i) + 13], MSG(13)); \
+        RND(c, d, e, f, g, h, a, b, K[(i) + 14], MSG(14)); \
+        RND(b, c, d, e, f, g, h, a, K[(i) + 15], MSG(15)); \
+} while (0)
+
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
+ *
+ * The rounds are unrolled 16 times, so the message schedule can be kept in a
+ * ring of 16 words that is expanded on the fly with constant indices. The
+ * block is read big-endian in place and may be unaligned.
  */
 static void sha2xx_transform(uint32_t *state, const unsigned char block[64])
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
 
-    /* 1. Prepare message schedule W. */
-    be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+    RNDS16(0, LOAD);
+    for (unsigned i = 16; i < 64; i += 16) {
+        RNDS16(i, SCHED);
     }
 
-    /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
-
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
-
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
-
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
-    }
-
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
-    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
 }
 
 static unsigned char PAD[64] = {
@@ -26,24 +26,17 @@
    implementation of all the Keccak instances approved in the FIPS 202 standard,
    including the hash functions and the extendable-output functions (XOFs).
 
-   We focused on clarity and on source-code compactness,
-   rather than on the performance.
+   The original reference code focused on clarity and source-code compactness.
+   For RIOT, the permutation was replaced by a faster one with precomputed round
+   constants and unrolled steps, using 64-bit lanes with lane complementing on
+   64-bit CPUs and bit-interleaved 32-bit words otherwise. The sponge
+   functions are unchanged.
 
    The advantages of this implementation are:
- + The source code is compact, after removing the comments, that is. :-)
- + There are no tables with arbitrary constants.
- + For clarity, the comments link the operations to the specifications using
-        the same notation as much as possible.
  + There is no restriction in cryptographic features. In particular,
         the SHAKE128 and SHAKE256 XOFs can produce any output length.
  + The code does not use much RAM, as all operations are done in place.
-
-   The drawbacks of this implementation are:
-    - There is no message queue. The whole message must be ready in a buffer.
-    - It is not optimized for performance.
-
-   The implementation is even simpler on a little endian platform. Just define the
-   LITTLE_ENDIAN symbol in that case.
+ + It works on little and big endian platforms and with unaligned buffers.
 
    For a more complete set of implementations, please refer to
    the Keccak Code Package at https://github.com/gvanas/KeccakCodePackage
@@ -51,6 +44,7 @@
    For more information, please refer to:
  * [Keccak Reference] http://keccak.noekeon.org/Keccak-reference-3.0.pdf
  * [Keccak Specifications Summary] http://keccak.noekeon.org/specs_summary.html
+ * [Keccak implementation overview] https://keccak.team/files/Keccak-implementation-3.2.pdf
 
    This file uses UTF-8 encoding, as some comments use Greek letters.
    ================================================================
@@ -163,6 +157,39 @@ void sha3_512_final(keccak_state_t *ctx, void *digest)
     Keccak_final(ctx, digest, SHA3_512_DIGEST_LENGTH);
 }
 
+/**
+ *  Functions to compute the SHAKE128 and SHAKE256 extendable-output functions.
+ */
+void shake128(void *output, size_t output_len, const void *data, size_t len)
+{
+    Keccak(1344, 256, data, len, 0x1F, output, output_len);
+}
+
+void shake128_init(keccak_state_t *ctx)
+{
+    Keccak_init(ctx, 1344, 256, 0x1F);
+}
+
+void shake256(void *output, size_t output_len, const void *data, size_t len)
+{
+    Keccak(1088, 512, data, len, 0x1F, output, output_len);
+}
+
+void shake256_init(keccak_state_t *ctx)
+{
+    Keccak_init(ctx, 1088, 512, 0x1F);
+}
+
+void shake_final(keccak_state_t *ctx, void *output, size_t len)
+{
+    Keccak_final(ctx, output, len);
+}
+
+void shake_squeeze(keccak_state_t *ctx, void *output, size_t len)
+{
+    Keccak_squeeze(ctx, output, len);
+}
+
 /*
    ================================================================
    Technicalities
@@ -170,160 +197,341 @@ void sha3_512_final(keccak_state_t *ctx, void *digest)
  */
 
 typedef uint8_t UINT8;
+typedef uint32_t UINT32;
 typedef uint64_t UINT64;
-typedef UINT64 tKeccakLane;
 
-#if __BYTE_ORDER__ == __ORDER__LITTLE_ENDIAN__
-#define LITTLE_ENDIAN
-#endif
+/*
+   ================================================================
+   Keccak-f[1600] permutation, optimized for the word size of the CPU.
 
-#ifndef LITTLE_ENDIAN
-/** Function to load a 64-bit value using the little-endian (LE) convention.
- * On a LE platform, this could be greatly simplified using a cast.
+   Both variants keep the lanes in local variables and do the ρ and π steps
+   in place by following the cycle of π, so no second copy of the state is
+   needed. θ, ρ, π and χ are unrolled and the round constants precomputed.
+   The state is kept as 200 bytes with little-endian lanes in between, as
+   required by the sponge functions below.
+   ================================================================
  */
-static UINT64 load64(const UINT8 *x)
-{
-    int i;
-    UINT64 u = 0;
 
-    for (i = 7; i >= 0; --i) {
-        u <<= 8;
-        u |= x[i];
-    }
-    return u;
-}
+#ifndef KECCAK_LANE_BITS
+#if defined(__SIZEOF_POINTER__) && (__SIZEOF_POINTER__ >= 8)
+#define KECCAK_LANE_BITS    (64)
+#else
+#define KECCAK_LANE_BITS    (32)
+#endif
+#endif
 
-/** Function to store a 64-bit value using the little-endian (LE) convention.
- * On a LE platform, this could be greatly simplified using a cast.
- */
-static void store64(UINT8 *x, UINT64 u)
+/** Loads a 32-bit value using the little-endian (LE) convention */
+static inline UINT32 load32(const UINT8 *x)
 {
-    unsigned int i;
+    return (UINT32)x[0] | ((UINT32)x[1] << 8) | ((UINT32)x[2] << 16) |
+           ((UINT32)x[3] << 24);
+}
 
-    for (i = 0; i < 8; ++i) {
-        x[i] = u;
-        u >>= 8;
-    }
+/** Stores a 32-bit value using the little-endian (LE) convention */
+static inline void store32(UINT8 *x, UINT32 u)
+{
+    x[0] = u;
+    x[1] = u >> 8;
+    x[2] = u >> 16;
+    x[3] = u >> 24;
 }
 
-/** Function to XOR into a 64-bit value using the little-endian (LE) convention.
- * On a LE platform, this could be greatly simplified using a cast.
+#if KECCAK_LANE_BITS == 64
+
+#define ROL64(a, offset) (((a) << (offset)) | ((a) >> ((64 - (offset)) & 63)))
+
+static const UINT64 KeccakF1600_RoundConstants[24] = {
+    0x0000000000000001, 0x0000000000008082,
+    0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001,
+    0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088,
+    0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b,
+    0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080,
+    0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080,
+    0x0000000080000001, 0x8000000080008008,
+};
+
+/**
+ * Lane complementing: with these six lanes kept inverted, χ needs only five
+ * NOT operations per round instead of 25 (see [Keccak implementation
+ * overview, Section 2.2]).
+ */
+#define COMPLEMENT_LANES(A) do { \
+        A[1] = ~A[1]; A[2] = ~A[2]; A[8] = ~A[8]; \
+        A[12] = ~A[12]; A[17] = ~A[17]; A[20] = ~A[20]; \
+} while (0)
+
+/* Applies θ to lane d and moves the previous lane of the π cycle into it */
+#define RHO_PI(d, r) do { \
+        tmp = A[d] ^ D[(d) % 5]; \
+        A[d] = ROL64(cur, r); \
+        cur = tmp; \
+} while (0)
+
+/**
+ * Function that computes the Keccak-f[1600] permutation on the given state.
  */
-static void xor64(UINT8 *x, UINT64 u)
+static void KeccakF1600_StatePermute(void *state)
 {
-    unsigned int i;
+    UINT8 *lanes = state;
+    UINT64 A[25], C[5], D[5];
+    UINT64 cur, tmp, t0, t1, t2, t3, t4;
 
-    for (i = 0; i < 8; ++i) {
-        x[i] ^= u;
-        u >>= 8;
+    for (unsigned i = 0; i < 25; i++) {
+        A[i] = load32(&lanes[8 * i]) |
+               ((UINT64)load32(&lanes[8 * i + 4]) << 32);
+    }
+    COMPLEMENT_LANES(A);
+
+    for (unsigned round = 0; round < 24; round++) {
+        /* === θ step (see [Keccak Reference, Section 2.3.2]) === */
+        C[0] = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+        C[1] = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+        C[2] = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+        C[3] = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+        C[4] = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+        D[0] = C[4] ^ ROL64(C[1], 1);
+        D[1] = C[0] ^ ROL64(C[2], 1);
+        D[2] = C[1] ^ ROL64(C[3], 1);
+        D[3] = C[2] ^ ROL64(C[4], 1);
+        D[4] = C[3] ^ ROL64(C[0], 1);
+
+        /* === ρ and π steps (see [Keccak Reference, Sections 2.3.3 and 2.3.4]) === */
+        A[0] ^= D[0];
+        cur = A[1] ^ D[1];
+        RHO_PI(10, 1);
+        RHO_PI(7, 3);
+        RHO_PI(11, 6);
+        RHO_PI(17, 10);
+        RHO_PI(18, 15);
+        RHO_PI(3, 21);
+        RHO_PI(5, 28);
+        RHO_PI(16, 36);
+        RHO_PI(8, 45);
+        RHO_PI(21, 55);
+        RHO_PI(24, 2);
+        RHO_PI(4, 14);
+        RHO_PI(15, 27);
+        RHO_PI(23, 41);
+        RHO_PI(19, 56);
+        RHO_PI(13, 8);
+        RHO_PI(12, 25);
+        RHO_PI(2, 43);
+        RHO_PI(20, 62);
+        RHO_PI(14, 18);
+        RHO_PI(22, 39);
+        RHO_PI(9, 61);
+        RHO_PI(6, 20);
+        RHO_PI(1, 44);
+
+        /* === χ step (see [Keccak Reference, Section 2.3.1]) === */
+        /* the complemented lanes determine which operands need a NOT */
+        t0 = A[0]; t1 = A[1]; t2 = A[2]; t3 = A[3]; t4 = A[4];
+        A[0] = t0 ^ (t1 | t2);
+        A[1] = t1 ^ (~t2 | t3);
+        A[2] = t2 ^ (t3 & t4);
+        A[3] = t3 ^ (t4 | t0);
+        A[4] = t4 ^ (t0 & t1);
+        t0 = A[5]; t1 = A[6]; t2 = A[7]; t3 = A[8]; t4 = A[9];
+        A[5] = t0 ^ (t1 | t2);
+        A[6] = t1 ^ (t2 & t3);
+        A[7] = t2 ^ (t3 | ~t4);
+        A[8] = t3 ^ (t4 | t0);
+        A[9] = t4 ^ (t0 & t1);
+        t0 = A[10]; t1 = A[11]; t2 = A[12]; t3 = A[13]; t4 = A[14];
+        A[10] = t0 ^ (t1 | t2);
+        A[11] = t1 ^ (t2 & t3);
+        A[12] = t2 ^ (~t3 & t4);
+        A[13] = ~t3 ^ (t4 | t0);
+        A[14] = t4 ^ (t0 & t1);
+        t0 = A[15]; t1 = A[16]; t2 = A[17]; t3 = A[18]; t4 = A[19];
+        A[15] = t0 ^ (t1 & t2);
+        A[16] = t1 ^ (t2 | t3);
+        A[17] = t2 ^ (~t3 | t4);
+        A[18] = ~t3 ^ (t4 & t0);
+        A[19] = t4 ^ (t0 | t1);
+        t0 = A[20]; t1 = A[21]; t2 = A[22]; t3 = A[23]; t4 = A[24];
+        A[20] = t0 ^ (~t1 & t2);
+        A[21] = ~t1 ^ (t2 | t3);
+        A[22] = t2 ^ (t3 & t4);
+        A[23] = t3 ^ (t4 | t0);
+        A[24] = t4 ^ (t0 & t1);
+
+        /* === ι step (see [Keccak Reference, Section 2.3.5]) === */
+        A[0] ^= KeccakF1600_RoundConstants[round];
+    }
+
+    COMPLEMENT_LANES(A);
+    for (unsigned i = 0; i < 25; i++) {
+        store32(&lanes[8 * i], A[i]);
+        store32(&lanes[8 * i + 4], A[i] >> 32);
     }
 }
-#endif
+
+#else /* KECCAK_LANE_BITS == 32 */
 
 /*
-   ================================================================
-   A readable and compact implementation of the Keccak-f[1600] permutation.
-   ================================================================
+ * Bit interleaving: a lane is kept as two 32-bit words, one with the bits at
+ * even and one with the bits at odd positions. A rotation of the lane then
+ * takes two 32-bit rotations (see [Keccak implementation overview, Section
+ * 2.1]). Lane complementing does not pay off here, the targets of this
+ * variant have an AND NOT instruction.
  */
 
-#define ROL64(a, offset) ((((UINT64)a) << offset) ^ (((UINT64)a) >> (64 - offset)))
-#define i(x, y) ((x) + 5 * (y))
+#define ROL32(a, offset) (((a) << (offset)) | ((a) >> ((32 - (offset)) & 31)))
+
+/* Round constants, bits at even and at odd positions */
+static const UINT32 KeccakF1600_RoundConstants[24][2] = {
+    { 0x00000001, 0x00000000 }, { 0x00000000, 0x00000089 },
+    { 0x00000000, 0x8000008b }, { 0x00000000, 0x80008080 },
+    { 0x00000001, 0x0000008b }, { 0x00000001, 0x00008000 },
+    { 0x00000001, 0x80008088 }, { 0x00000001, 0x80000082 },
+    { 0x00000000, 0x0000000b }, { 0x00000000, 0x0000000a },
+    { 0x00000001, 0x00008082 }, { 0x00000000, 0x00008003 },
+    { 0x00000001, 0x0000808b }, { 0x00000001, 0x8000000b },
+    { 0x00000001, 0x8000008a }, { 0x00000001, 0x80000081 },
+    { 0x00000000, 0x80000081 }, { 0x00000000, 0x80000008 },
+    { 0x00000000, 0x00000083 }, { 0x00000000, 0x80008003 },
+    { 0x00000001, 0x80008088 }, { 0x00000000, 0x80000088 },
+    { 0x00000001, 0x00008000 }, { 0x00000000, 0x80008082 },
+};
+
+/* Moves the bits at even positions to the lower, the odd ones to the upper half */
+static inline UINT32 unshuffle32(UINT32 x)
+{
+    UINT32 t;
 
-#ifdef LITTLE_ENDIAN
-    #define readLane(x, y)          (((tKeccakLane *)state)[i(x, y)])
-    #define writeLane(x, y, lane)   (((tKeccakLane *)state)[i(x, y)]) = (lane)
-    #define XORLane(x, y, lane)     (((tKeccakLane *)state)[i(x, y)]) ^= (lane)
-#else
-    #define readLane(x, y)          load64((UINT8 *)state + sizeof(tKeccakLane) * i(x, y))
-    #define writeLane(x, y, lane)   store64((UINT8 *)state + sizeof(tKeccakLane) * i(x, y), lane)
-    #define XORLane(x, y, lane)     xor64((UINT8 *)state + sizeof(tKeccakLane) * i(x, y), lane)
-#endif
+    t = (x ^ (x >> 1)) & 0x22222222; x ^= t ^ (t << 1);
+    t = (x ^ (x >> 2)) & 0x0C0C0C0C; x ^= t ^ (t << 2);
+    t = (x ^ (x >> 4)) & 0x00F000F0; x ^= t ^ (t << 4);
+    t = (x ^ (x >> 8)) & 0x0000FF00; x ^= t ^ (t << 8);
+    return x;
+}
 
-/**
- * Function that computes the linear feedback shift register (LFSR) used to
- * define the round constants (see [Keccak Reference, Section 1.2]).
- */
-static int LFSR86540(UINT8 *LFSR)
+/* Inverse of unshuffle32() */
+static inline UINT32 shuffle32(UINT32 x)
 {
-    int result = ((*LFSR) & 0x01) != 0;
+    UINT32 t;
 
-    if (((*LFSR) & 0x80) != 0) {
-        /* Primitive polynomial over GF(2): x^8+x^6+x^5+x^4+1 */
-        (*LFSR) = ((*LFSR) << 1) ^ 0x71;
-    }
-    else {
-        (*LFSR) <<= 1;
-    }
-    return result;
+    t = (x ^ (x >> 8)) & 0x0000FF00; x ^= t ^ (t << 8);
+    t = (x ^ (x >> 4)) & 0x00F000F0; x ^= t ^ (t << 4);
+    t = (x ^ (x >> 2)) & 0x0C0C0C0C; x ^= t ^ (t << 2);
+    t = (x ^ (x >> 1)) & 0x22222222; x ^= t ^ (t << 1);
+    return x;
 }
 
+/*
+ * Applies θ to lane d and moves the previous lane of the π cycle into it,
+ * rotated by r. An odd rotation swaps the even and the odd word.
+ */
+#define RHO_PI(d, r) do { \
+        tmpE = E[d] ^ DE[(d) % 5]; \
+        tmpO = O[d] ^ DO[(d) % 5]; \
+        if ((r) & 1) { \
+            E[d] = ROL32(curO, ((r) + 1) / 2); \
+            O[d] = ROL32(curE, (r) / 2); \
+        } \
+        else { \
+            E[d] = ROL32(curE, (r) / 2); \
+            O[d] = ROL32(curO, (r) / 2); \
+        } \
+        curE = tmpE; \
+        curO = tmpO; \
+} while (0)
+
+/* χ on the plane starting at lane y of one half of the state */
+#define CHI(X, y) do { \
+        t0 = X[(y) + 0]; t1 = X[(y) + 1]; t2 = X[(y) + 2]; \
+        t3 = X[(y) + 3]; t4 = X[(y) + 4]; \
+        X[(y) + 0] = t0 ^ (~t1 & t2); \
+        X[(y) + 1] = t1 ^ (~t2 & t3); \
+        X[(y) + 2] = t2 ^ (~t3 & t4); \
+        X[(y) + 3] = t3 ^ (~t4 & t0); \
+        X[(y) + 4] = t4 ^ (~t0 & t1); \
+} while (0)
+
 /**
  * Function that computes the Keccak-f[1600] permutation on the given state.
  */
 static void KeccakF1600_StatePermute(void *state)
 {
-    unsigned int round, x, y, j, t;
-    UINT8 LFSRstate = 0x01;
-
-    for (round = 0; round < 24; round++) {
-        {   /* === θ step (see [Keccak Reference, Section 2.3.2]) === */
-            tKeccakLane C[5];
-
-            /* Compute the parity of the columns */
-            for (x = 0; x < 5; x++)
-                C[x] = readLane(x, 0) ^ readLane(x, 1) ^ readLane(x, 2) ^ readLane(x, 3) ^
-                       readLane(x, 4);
-            for (x = 0; x < 5; x++) {
-                /* Compute the θ effect for a given column */
-                tKeccakLane D = C[(x + 4) % 5] ^ ROL64(C[(x + 1) % 5], 1);
-                /* Add the θ effect to the whole column */
-                for (y = 0; y < 5; y++)
-                    XORLane(x, y, D);
-            }
-        }
+    UINT8 *lanes = state;
+    UINT32 E[25], O[25], CE[5], CO[5], DE[5], DO[5];
+    UINT32 curE, curO, tmpE, tmpO, t0, t1, t2, t3, t4;
+
+    for (unsigned i = 0; i < 25; i++) {
+        UINT32 lo = unshuffle32(load32(&lanes[8 * i]));
+        UINT32 hi = unshuffle32(load32(&lanes[8 * i + 4]));
+        E[i] = (lo & 0x0000FFFF) | (hi << 16);
+        O[i] = (lo >> 16) | (hi & 0xFFFF0000);
+    }
 
-        {   /* === ρ and π steps (see [Keccak Reference, Sections 2.3.3 and 2.3.4]) === */
-            tKeccakLane current;
-            /* Start at coordinates (1 0) */
-            x = 1; y = 0;
-            current = readLane(x, y);
-            /* Iterate over ((0 1)(2 3))^t * (1 0) for 0 ≤ t ≤ 23 */
-            for (t = 0; t < 24; t++) {
-                /* Compute the rotation constant r = (t+1)(t+2)/2 */
-                unsigned int r = ((t + 1) * (t + 2) / 2) % 64;
-                /* Compute ((0 1)(2 3)) * (x y) */
-                unsigned int Y = (2 * x + 3 * y) % 5; x = y; y = Y;
-                /* Swap current and state(x,y), and rotate */
-                tKeccakLane temp = readLane(x, y);
-                writeLane(x, y, ROL64(current, r));
-                current = temp;
-            }
+    for (unsigned round = 0; round < 24; round++) {
+        /* === θ step (see [Keccak Reference, Section 2.3.2]) === */
+        for (unsigned x = 0; x < 5; x++) {
+            CE[x] = E[x] ^ E[x + 5] ^ E[x + 10] ^ E[x + 15] ^ E[x + 20];
+            CO[x] = O[x] ^ O[x + 5] ^ O[x + 10] ^ O[x + 15] ^ O[x + 20];
         }
-
-        {   /* === χ step (see [Keccak Reference, Section 2.3.1]) === */
-            tKeccakLane temp[5];
-            for (y = 0; y < 5; y++) {
-                /* Take a copy of the plane */
-                for (x = 0; x < 5; x++)
-                    temp[x] = readLane(x, y);
-                /* Compute χ on the plane */
-                for (x = 0; x < 5; x++)
-                    writeLane(x, y, temp[x] ^ ((~temp[(x + 1) % 5]) & temp[(x + 2) % 5]));
-            }
+        DE[0] = CE[4] ^ ROL32(CO[1], 1); DO[0] = CO[4] ^ CE[1];
+        DE[1] = CE[0] ^ ROL32(CO[2], 1); DO[1] = CO[0] ^ CE[2];
+        DE[2] = CE[1] ^ ROL32(CO[3], 1); DO[2] = CO[1] ^ CE[3];
+        DE[3] = CE[2] ^ ROL32(CO[4], 1); DO[3] = CO[2] ^ CE[4];
+        DE[4] = CE[3] ^ ROL32(CO[0], 1); DO[4] = CO[3] ^ CE[0];
+
+        /* === ρ and π steps (see [Keccak Reference, Sections 2.3.3 and 2.3.4]) === */
+        E[0] ^= DE[0];
+        O[0] ^= DO[0];
+        curE = E[1] ^ DE[1];
+        curO = O[1] ^ DO[1];
+        RHO_PI(10, 1);
+        RHO_PI(7, 3);
+        RHO_PI(11, 6);
+        RHO_PI(17, 10);
+        RHO_PI(18, 15);
+        RHO_PI(3, 21);
+        RHO_PI(5, 28);
+        RHO_PI(16, 36);
+        RHO_PI(8, 45);
+        RHO_PI(21, 55);
+        RHO_PI(24, 2);
+        RHO_PI(4, 14);
+        RHO_PI(15, 27);
+        RHO_PI(23, 41);
+        RHO_PI(19, 56);
+        RHO_PI(13, 8);
+        RHO_PI(12, 25);
+        RHO_PI(2, 43);
+        RHO_PI(20, 62);
+        RHO_PI(14, 18);
+        RHO_PI(22, 39);
+        RHO_PI(9, 61);
+        RHO_PI(6, 20);
+        RHO_PI(1, 44);
+
+        /* === χ step (see [Keccak Reference, Section 2.3.1]) === */
+        for (unsigned y = 0; y < 25; y += 5) {
+            CHI(E, y);
+            CHI(O, y);
         }
 
-        {
-            /* === ι step (see [Keccak Reference, Section 2.3.5]) === */
-            for (j = 0; j < 7; j++) {
-                unsigned int bitPosition = (1 << j) - 1;    /* 2^j-1 */
-                if (LFSR86540(&LFSRstate)) {
-                    XORLane(0, 0, (tKeccakLane)1 << bitPosition);
-                }
-            }
-        }
+        /* === ι step (see [Keccak Reference, Section 2.3.5]) === */
+        E[0] ^= KeccakF1600_RoundConstants[round][0];
+        O[0] ^= KeccakF1600_RoundConstants[round][1];
+    }
+
+    for (unsigned i = 0; i < 25; i++) {
+        store32(&lanes[8 * i], shuffle32((E[i] & 0x0000FFFF) | (O[i] << 16)));
+        store32(&lanes[8 * i + 4],
+                shuffle32((E[i] >> 16) | (O[i] & 0xFFFF0000)));
     }
 }
 
+#endif /* KECCAK_LANE_BITS */
+
 /*
    ================================================================
    A readable and compact implementation of the Keccak sponge functions
@@ -445,16 +653,25 @@ void Keccak_final(keccak_state_t *ctx, unsigned char *output, unsigned long long
     ctx->state[ctx->rateInBytes - 1] ^= 0x80;
     /* Switch to the squeezing phase */
     KeccakF1600_StatePermute(ctx->state);
+    ctx->i = 0;
+
+    Keccak_squeeze(ctx, output, outputByteLen);
+}
 
+void Keccak_squeeze(keccak_state_t *ctx, unsigned char *output,
+                    unsigned long long int outputByteLen)
+{
     /* === Squeeze out all the output blocks === */
     while (outputByteLen > 0) {
-        unsigned int blockSize = MIN(outputByteLen, ctx->rateInBytes);
-        memcpy(output, ctx->state, blockSize);
-        output += blockSize;
-        outputByteLen -= blockSize;
-
-        if (outputByteLen > 0) {
+        if (ctx->i == ctx->rateInBytes) {
             KeccakF1600_StatePermute(ctx->state);
+            ctx->i = 0;
         }
+
+        unsigned int blockSize = MIN(outputByteLen, ctx->rateInBytes - ctx->i);
+        memcpy(output, &ctx->state[ctx->i], blockSize);
+        ctx->i += blockSize;
+        output += blockSize;
+        outputByteLen -= blockSize;
     }
 }
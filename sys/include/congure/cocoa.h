@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_cocoa   CongURE NewReno variant for constrained links
+ * @ingroup     sys_congure
+ * @brief       NewReno with CoCoA-style RTT estimation and pacing for
+ *              @ref sys_congure
+ *
+ * A variant of @ref sys_congure_reno for lossy multi-hop networks, such as
+ * 6LoWPAN meshes, where a loss is often caused by the link and not by
+ * congestion. It takes the following ideas from CoCoA
+ * ([draft-ietf-core-cocoa](https://tools.ietf.org/html/draft-ietf-core-cocoa)):
+ *
+ * - The RTT is tracked by a strong estimator, fed with samples of messages
+ *   that were not retransmitted, and a weak estimator, fed with samples of
+ *   retransmitted messages. Both are combined to an overall RTO, which is
+ *   available via congure_cocoa_rto().
+ * - The first timeout of a message only halves the congestion window instead
+ *   of collapsing it to one segment. Only messages timing out again are
+ *   treated as congestion as in NewReno.
+ *
+ * Additionally, messages are paced over the smoothed RTT (see
+ * congure_snd_driver_t::inter_msg_interval()), so a window is not sent as a
+ * single burst that overflows the queues of the forwarding nodes.
+ *
+ * Fast retransmit and fast recovery work as in @ref sys_congure_reno, so the
+ * same congure_reno_snd_consts_t are used.
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_COCOA_H
+#define CONGURE_COCOA_H
+
+#include <stdint.h>
+
+#include "congure/reno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   RTO in milliseconds before the first RTT sample
+ */
+#ifndef CONFIG_CONGURE_COCOA_INIT_RTO_MS
+#define CONFIG_CONGURE_COCOA_INIT_RTO_MS    (2000U)
+#endif
+
+/**
+ * @brief   State of an RTT estimator
+ */
+typedef struct {
+    uint32_t srtt;              /**< Smoothed RTT in ms, 0 without sample */
+    uint32_t rttvar;            /**< RTT variation in ms */
+} congure_cocoa_rtt_t;
+
+/**
+ * @brief   State object for CongURE CoCoA
+ *
+ * @extends congure_reno_snd_t
+ */
+typedef struct {
+    congure_reno_snd_t super;   /**< see @ref congure_reno_snd_t */
+    congure_cocoa_rtt_t strong; /**< Strong RTT estimator */
+    congure_cocoa_rtt_t weak;   /**< Weak RTT estimator */
+    uint32_t rto;               /**< Overall RTO in ms */
+} congure_cocoa_snd_t;
+
+/**
+ * @brief   Sets up the driver for a CongURE CoCoA object
+ *
+ * @param[in] c         A CongURE CoCoA object
+ * @param[in] consts    The constants to use for @p c. Must stay valid as
+ *                      long as @p c is used.
+ */
+void congure_cocoa_snd_setup(congure_cocoa_snd_t *c,
+                             const congure_reno_snd_consts_t *consts);
+
+/**
+ * @brief   Get the overall retransmission timeout of a CongURE CoCoA object
+ *
+ * @param[in] c     A CongURE CoCoA object
+ *
+ * @return  The RTO in milliseconds
+ */
+static inline uint32_t congure_cocoa_rto(const congure_cocoa_snd_t *c)
+{
+    return c->rto;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_COCOA_H */
+/** @} */
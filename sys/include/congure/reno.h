@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_reno    CongURE implementation of TCP NewReno
+ * @ingroup     sys_congure
+ * @brief       Implementation of the TCP NewReno congestion control mechanism
+ *              for @ref sys_congure
+ *
+ * Implements slow start and congestion avoidance as specified in
+ * [RFC 5681](https://tools.ietf.org/html/rfc5681) and fast retransmit and
+ * fast recovery with the NewReno modification as specified in
+ * [RFC 6582](https://tools.ietf.org/html/rfc6582).
+ *
+ * Sizes are in bytes, as in TCP. Duplicate ACKs are detected by means of the
+ * congure_snd_ack_t::id (the cumulative acknowledgement number) and
+ * congure_snd_ack_t::wnd of an ACK reported via
+ * congure_snd_driver_t::report_msg_acked() with a message of size 0. When a
+ * non-duplicate ACK is reported, congure_snd_msg_t::size is the number of
+ * bytes newly acknowledged by it.
+ *
+ * The user has to retransmit the oldest unacknowledged message from within
+ * the congure_reno_snd_consts_t::fr callback. It is called on the
+ * congure_reno_snd_consts_t::frthresh'th duplicate ACK and for every partial
+ * ACK during fast recovery.
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_RENO_H
+#define CONGURE_RENO_H
+
+#include <stdint.h>
+
+#include "congure.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of the NewReno state object
+ */
+typedef struct congure_reno_snd congure_reno_snd_t;
+
+/**
+ * @brief   Constants and callbacks for the NewReno state object
+ */
+typedef struct {
+    /**
+     * @brief   Callback to retransmit the oldest unacknowledged message
+     *
+     * @param[in] c     The CongURE state object (congure_snd_t::ctx holds
+     *                  the context given to congure_snd_driver_t::init())
+     */
+    void (*fr)(congure_reno_snd_t *c);
+    unsigned init_mss;          /**< Initial maximum segment size */
+    /**
+     * @brief   Initial slow start threshold
+     *
+     * Use @ref CONGURE_WND_SIZE_MAX for an arbitrarily high threshold.
+     */
+    congure_wnd_size_t init_ssthresh;
+    /**
+     * @brief   Number of duplicate ACKs to trigger fast retransmit
+     *
+     * Usually 3.
+     */
+    uint8_t frthresh;
+} congure_reno_snd_consts_t;
+
+/**
+ * @brief   State object for CongURE NewReno
+ *
+ * @extends congure_snd_t
+ */
+struct congure_reno_snd {
+    congure_snd_t super;                        /**< see @ref congure_snd_t */
+    const congure_reno_snd_consts_t *consts;    /**< Constants */
+    uint32_t last_ack;          /**< ID of the last ACK reported */
+    congure_wnd_size_t last_wnd;    /**< Window of the last ACK reported */
+    congure_wnd_size_t ssthresh;    /**< Slow start threshold */
+    congure_wnd_size_t in_flight_size;  /**< Bytes in flight */
+    /**
+     * @brief   Bytes in flight when fast recovery was entered that are not
+     *          acknowledged yet, 0 when not in fast recovery
+     */
+    congure_wnd_size_t recover_size;
+    uint16_t mss;               /**< Maximum segment size */
+    uint8_t dup_acks;           /**< Number of duplicate ACKs in a row */
+};
+
+/**
+ * @brief   Sets up the driver for a CongURE NewReno object
+ *
+ * @param[in] c         A CongURE NewReno object
+ * @param[in] consts    The constants to use for @p c. Must stay valid as
+ *                      long as @p c is used.
+ */
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_snd_consts_t *consts);
+
+/**
+ * @brief   Set the maximum segment size for a CongURE NewReno object
+ *
+ * Rescales the congestion window accordingly, if it still has its initial
+ * value.
+ *
+ * @param[in] c     A CongURE NewReno object
+ * @param[in] mss   The new maximum segment size
+ */
+void congure_reno_set_mss(congure_reno_snd_t *c, unsigned mss);
+
+/**
+ * @name    Methods of the NewReno driver
+ *
+ * For implementations that extend @ref congure_reno_snd_t and only replace
+ * some of its methods.
+ * @{
+ */
+/**
+ * @brief   congure_snd_driver_t::init() of NewReno
+ */
+void congure_reno_snd_init(congure_snd_t *c, void *ctx);
+
+/**
+ * @brief   congure_snd_driver_t::report_msg_sent() of NewReno
+ */
+void congure_reno_snd_report_msg_sent(congure_snd_t *c, unsigned msg_size);
+
+/**
+ * @brief   congure_snd_driver_t::report_msg_discarded() of NewReno
+ */
+void congure_reno_snd_report_msg_discarded(congure_snd_t *c,
+                                           unsigned msg_size);
+
+/**
+ * @brief   congure_snd_driver_t::report_msgs_timeout() of NewReno
+ */
+void congure_reno_snd_report_msgs_timeout(congure_snd_t *c,
+                                          congure_snd_msg_t *msgs);
+
+/**
+ * @brief   congure_snd_driver_t::report_msgs_lost() of NewReno
+ */
+void congure_reno_snd_report_msgs_lost(congure_snd_t *c,
+                                       congure_snd_msg_t *msgs);
+
+/**
+ * @brief   congure_snd_driver_t::report_msg_acked() of NewReno
+ */
+void congure_reno_snd_report_msg_acked(congure_snd_t *c,
+                                       congure_snd_msg_t *msg,
+                                       congure_snd_ack_t *ack);
+
+/**
+ * @brief   congure_snd_driver_t::report_ecn_ce() of NewReno
+ */
+void congure_reno_snd_report_ecn_ce(congure_snd_t *c, ztimer_now_t time);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_RENO_H */
+/** @} */
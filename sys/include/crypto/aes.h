@@ -126,6 +126,40 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts consecutive blocks, expanding the key only once
+ *
+ * @param       context   the cipher_context_t-struct to use for this
+ *                        encryption
+ * @param       input     the plaintext, @p blocks times blocksize long
+ * @param       output    the place where the ciphertext will be stored, may
+ *                        be @p input
+ * @param       blocks    number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks);
+
+/**
+ * @brief   decrypts consecutive blocks, expanding the key only once
+ *
+ * @param       context   the cipher_context_t-struct to use for this
+ *                        decryption
+ * @param       input     the ciphertext, @p blocks times blocksize long
+ * @param       output    the place where the plaintext will be stored, may
+ *                        be @p input
+ * @param       blocks    number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -91,6 +92,23 @@ typedef struct cipher_interface_st {
     /** @brief the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /**
+     * @brief the function to encrypt consecutive blocks, may be NULL
+     *
+     * Lets a cipher do its per-call work, e.g. a key schedule, once for many
+     * blocks. If NULL, @ref encrypt is called per block.
+     */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+    /**
+     * @brief the function to decrypt consecutive blocks, may be NULL
+     *
+     * If NULL, @ref decrypt is called per block.
+     */
+    int (*decrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
 } cipher_interface_t;
 
 
@@ -164,6 +182,46 @@ int cipher_decrypt(const cipher_t *cipher, const uint8_t *input,
                    uint8_t *output);
 
 
+/**
+ * @brief Encrypt consecutive blocks
+ *
+ * Same result as calling cipher_encrypt() for every block, but faster for
+ * ciphers that implement cipher_interface_st::encrypt_blocks.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to encrypt, of size
+ *                   @p blocks * BLOCK_SIZE
+ * @param output     pointer to allocated memory for encrypted data, of size
+ *                   @p blocks * BLOCK_SIZE. May be @p input.
+ * @param blocks     number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+
+/**
+ * @brief Decrypt consecutive blocks
+ *
+ * Same result as calling cipher_decrypt() for every block, but faster for
+ * ciphers that implement cipher_interface_st::decrypt_blocks.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to decrypt, of size
+ *                   @p blocks * BLOCK_SIZE
+ * @param output     pointer to allocated memory for decrypted data, of size
+ *                   @p blocks * BLOCK_SIZE. May be @p input.
+ * @param blocks     number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+
 /**
  * @brief Get block size of cipher
  * *
@@ -38,6 +38,16 @@ extern "C" {
 void crypto_block_inc_ctr(uint8_t block[16], int L);
 
 
+/**
+ * @brief   XORs two buffers, a word at a time if they are aligned
+ *
+ * @param[out] out  a ^ b, may be @p a or @p b
+ * @param[in]  a    first operand
+ * @param[in]  b    second operand
+ * @param[in]  len  size of @p out, @p a and @p b in bytes
+ */
+void crypto_xor(uint8_t *out, const uint8_t *a, const uint8_t *b, size_t len);
+
 /**
  * @brief   Compares two blocks of same size in deterministic time.
  *
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file        gcm.h
+ * @brief       Galois/Counter mode of operation for block ciphers
+ *
+ * Implements GCM as specified in NIST SP 800-38D. GHASH uses a 4-bit table
+ * of multiples of the hash key (256 bytes in @ref cipher_gcm_ctx_t), which
+ * is about an order of magnitude faster than a bitwise multiplication.
+ *
+ * Besides the one-shot functions, data can be passed in pieces of any length,
+ * e.g. from a packet chain:
+ *
+ *     cipher_gcm_init(&ctx, &cipher, nonce, sizeof(nonce));
+ *     cipher_gcm_aad(&ctx, header, header_len);
+ *     for (snip = pkt; snip; snip = snip->next) {
+ *         cipher_gcm_encrypt_update(&ctx, snip->data, snip->size, snip->data);
+ *     }
+ *     cipher_gcm_encrypt_finish(&ctx, tag, sizeof(tag));
+ */
+
+#ifndef CRYPTO_MODES_GCM_H
+#define CRYPTO_MODES_GCM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crypto/ciphers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name GCM error codes
+ * @{
+ */
+#define GCM_ERR_INVALID_NONCE_LENGTH        (-2)
+#define GCM_ERR_INVALID_MAC                 (-3)
+#define GCM_ERR_INVALID_STATE               (-4)
+#define GCM_ERR_INVALID_MAC_LENGTH          (-5)
+/** @} */
+
+/**
+ * @brief Block size required for the cipher. GCM is only defined for 128 bit ciphers.
+ */
+#define GCM_BLOCK_SIZE                      16
+
+/**
+ * @brief Maximum length for the appended MAC
+ */
+#define GCM_MAC_MAX_LEN                     16
+
+/**
+ * @brief Recommended nonce length, other lengths need an extra GHASH pass
+ */
+#define GCM_NONCE_LEN                       12
+
+/**
+ * @brief State of a GCM encryption or decryption
+ *
+ * Contains key material, it is wiped by the finish functions.
+ */
+typedef struct {
+    /** @cond INTERNAL */
+    const cipher_t *cipher;
+    uint64_t h_hi[16];                  /* multiples of H, upper 64 bits */
+    uint64_t h_lo[16];                  /* multiples of H, lower 64 bits */
+    uint8_t counter[GCM_BLOCK_SIZE];    /* next counter block */
+    uint8_t tag_mask[GCM_BLOCK_SIZE];   /* E(K, J0) */
+    uint8_t hash[GCM_BLOCK_SIZE];       /* GHASH state */
+    uint8_t stream[GCM_BLOCK_SIZE];     /* key stream of a partial block */
+    uint64_t aad_len;
+    uint64_t text_len;
+    uint8_t hash_used;                  /* bytes of hash of the current block */
+    uint8_t stream_used;                /* bytes of stream already used */
+    uint8_t aad_done;                   /* set when data was processed */
+    /** @endcond */
+} cipher_gcm_ctx_t;
+
+/**
+ * @brief Starts a GCM encryption or decryption
+ *
+ * @param ctx        state to initialize
+ * @param cipher     Already initialized cipher struct with a block size of
+ *                   GCM_BLOCK_SIZE, must stay valid until the finish call
+ * @param nonce      nonce (IV), never to be repeated with the same key
+ * @param nonce_len  length of the nonce, should be GCM_NONCE_LEN
+ *
+ * @return           0 on success
+ * @return           GCM_ERR_INVALID_NONCE_LENGTH if @p nonce_len is 0
+ * @return           A negative error code of the cipher
+ */
+int cipher_gcm_init(cipher_gcm_ctx_t *ctx, const cipher_t *cipher,
+                    const uint8_t *nonce, size_t nonce_len);
+
+/**
+ * @brief Adds additional data to authenticate
+ *
+ * May be called several times, but only before any data is encrypted or
+ * decrypted.
+ *
+ * @param ctx        state
+ * @param auth_data  additional data to authenticate
+ * @param len        length of @p auth_data
+ *
+ * @return           0 on success
+ * @return           GCM_ERR_INVALID_STATE if data was already processed
+ */
+int cipher_gcm_aad(cipher_gcm_ctx_t *ctx, const uint8_t *auth_data,
+                   size_t len);
+
+/**
+ * @brief Encrypts the next piece of data
+ *
+ * @param ctx        state
+ * @param input      plaintext
+ * @param len        length of @p input
+ * @param output     memory for the ciphertext of size @p len, may be @p input
+ *
+ * @return           @p len on success
+ * @return           A negative error code of the cipher
+ */
+int cipher_gcm_encrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief Decrypts the next piece of data
+ *
+ * The plaintext must not be used before cipher_gcm_decrypt_finish() verified
+ * the MAC.
+ *
+ * @param ctx        state
+ * @param input      ciphertext
+ * @param len        length of @p input
+ * @param output     memory for the plaintext of size @p len, may be @p input
+ *
+ * @return           @p len on success
+ * @return           A negative error code of the cipher
+ */
+int cipher_gcm_decrypt_update(cipher_gcm_ctx_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief Finishes an encryption and writes the MAC
+ *
+ * @param ctx        state, wiped afterwards
+ * @param mac        memory for the MAC
+ * @param mac_length length of the MAC, between 4 and GCM_MAC_MAX_LEN
+ *
+ * @return           @p mac_length on success
+ * @return           GCM_ERR_INVALID_MAC_LENGTH for an invalid @p mac_length
+ */
+int cipher_gcm_encrypt_finish(cipher_gcm_ctx_t *ctx, uint8_t *mac,
+                              uint8_t mac_length);
+
+/**
+ * @brief Finishes a decryption and verifies the MAC
+ *
+ * @param ctx        state, wiped afterwards
+ * @param mac        received MAC
+ * @param mac_length length of the MAC, between 4 and GCM_MAC_MAX_LEN
+ *
+ * @return           0 if the MAC is valid
+ * @return           GCM_ERR_INVALID_MAC if the MAC is invalid
+ * @return           GCM_ERR_INVALID_MAC_LENGTH for an invalid @p mac_length
+ */
+int cipher_gcm_decrypt_finish(cipher_gcm_ctx_t *ctx, const uint8_t *mac,
+                              uint8_t mac_length);
+
+/**
+ * @brief Encrypt and authenticate data of arbitrary length in gcm mode.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate in MAC
+ * @param auth_data_len    Length of additional data
+ * @param mac_length       length of the appended MAC (between 4 and 16)
+ * @param nonce            Nonce, should be GCM_NONCE_LEN long
+ * @param nonce_len        Length of the nonce in octets
+ * @param input            pointer to input data to encrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for encrypted data. It
+ *                         has to be of size input_len + mac_length.
+ *
+ * @return                 Length of encrypted data including the MAC
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_encrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t mac_length,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output);
+
+/**
+ * @brief Decrypt data of arbitrary length in gcm mode.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate in MAC
+ * @param auth_data_len    Length of additional data
+ * @param mac_length       length of the appended MAC (between 4 and 16)
+ * @param nonce            Nonce, should be GCM_NONCE_LEN long
+ * @param nonce_len        Length of the nonce in octets
+ * @param input            pointer to input data to decrypt, followed by the
+ *                         MAC
+ * @param input_len        length of the input data including the MAC
+ * @param output           pointer to allocated memory for the plaintext. It
+ *                         has to be of size input_len - mac_length. It is
+ *                         wiped if the MAC is invalid.
+ *
+ * @return                 Length of the decrypted data
+ * @return                 A negative error code if something went wrong
+ */
+int cipher_decrypt_gcm(const cipher_t *cipher,
+                       const uint8_t *auth_data, size_t auth_data_len,
+                       uint8_t mac_length,
+                       const uint8_t *nonce, size_t nonce_len,
+                       const uint8_t *input, size_t input_len,
+                       uint8_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_MODES_GCM_H */
+/** @} */
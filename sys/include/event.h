@@ -47,6 +47,13 @@
  * to be queued. Thus event queues can be used safely and efficiently in combination
  * with thread flags and msg queues.
  *
+ * With module `event_deadline`, events can be posted with a deadline hint
+ * using event_post_deadline(). Such events are handled before all events
+ * posted with event_post(), in the order of their deadlines. The deadline is
+ * only used for ordering, e.g. a timestamp of any clock, or a priority. Thus,
+ * urgent events (e.g. from an ISR) can overtake a backlog of less urgent ones
+ * in the same queue, while event_wait_multi() orders the queues themselves.
+ *
  * Examples:
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
@@ -147,6 +154,9 @@ typedef void (*event_handler_t)(event_t *);
 struct event {
     clist_node_t list_node;     /**< event queue list entry             */
     event_handler_t handler;    /**< pointer to event handler function  */
+#if IS_USED(MODULE_EVENT_DEADLINE) || defined(DOXYGEN)
+    uint32_t deadline;          /**< deadline hint, see event_post_deadline() */
+#endif
 };
 
 /**
@@ -155,6 +165,9 @@ struct event {
 typedef struct PTRTAG {
     clist_node_t event_list;    /**< list of queued events              */
     thread_t *waiter;           /**< thread owning event queue          */
+#if IS_USED(MODULE_EVENT_DEADLINE) || defined(DOXYGEN)
+    clist_node_t *deadline_last;    /**< last queued event with a deadline */
+#endif
 } event_queue_t;
 
 /**
@@ -257,11 +270,40 @@ static inline void event_queue_claim(event_queue_t *queue)
  * in the previous position on the queue. So reposting an event while it is
  * already on the queue will have no effect.
  *
+ * The thread owning the queue is only notified with @ref THREAD_FLAG_EVENT
+ * when the queue was empty, so a burst of events costs a single wake-up. A
+ * thread waiting for @ref THREAD_FLAG_EVENT itself must therefore call
+ * event_get() until it returns NULL before waiting again.
+ *
  * @param[in]   queue   event queue to queue event in
  * @param[in]   event   event to queue in event queue
  */
 void event_post(event_queue_t *queue, event_t *event);
 
+#if IS_USED(MODULE_EVENT_DEADLINE) || defined(DOXYGEN)
+/**
+ * @brief   Queue an event with a deadline hint
+ *
+ * The event is queued behind all events with an earlier or the same deadline
+ * and in front of all other events, including all events posted with
+ * event_post(). Deadlines are compared as 32 bit timestamps that may wrap
+ * around, so the deadlines of all events in a queue must lie within 2^31 of
+ * each other.
+ *
+ * Like with event_post(), reposting an event that is already queued has no
+ * effect.
+ *
+ * @note    Queuing runs in O(n) with interrupts disabled, with n the number
+ *          of events with a deadline in @p queue.
+ *
+ * @param[in]   queue       event queue to queue event in
+ * @param[in]   event       event to queue in event queue
+ * @param[in]   deadline    deadline hint of @p event
+ */
+void event_post_deadline(event_queue_t *queue, event_t *event,
+                         uint32_t deadline);
+#endif
+
 /**
  * @brief   Cancel a queued event
  *
@@ -135,6 +135,24 @@ static inline void sha256_final(sha256_context_t *ctx, void *digest)
  */
 void *sha256(const void *data, size_t len, void *digest);
 
+/**
+ * @brief Computes the SHA-256 of several independent messages of the same
+ * length, e.g. the elements of several hash chains
+ *
+ * This is the entry point for batches of messages, such as verifying several
+ * hash chains at once. The messages are currently hashed one after the other:
+ * interleaving two messages in one transform was measured slower on CPUs
+ * without SIMD units, as the two states do not fit into the registers.
+ *
+ * @param[in] data      array of @p numof pointers to the messages
+ * @param[in] len       length of each message
+ * @param[out] digests  array of @p numof pointers to the results, each of
+ *                      length SHA256_DIGEST_LENGTH
+ * @param[in] numof     number of messages
+ */
+void sha256_multi(const void *const data[], size_t len,
+                  void *const digests[], size_t numof);
+
 /**
  * @brief hmac_sha256_init HMAC SHA-256 calculation. Initiate calculation of a HMAC
  * @param[in] ctx hmac_context_t handle to use
@@ -14,7 +14,8 @@
 /**
  * @defgroup    sys_hashes_sha3 SHA-3
  * @ingroup     sys_hashes_unkeyed
- * @brief       Implementation of the SHA-3 hashing function
+ * @brief       Implementation of the SHA-3 hashing function and the SHAKE
+ *              extendable-output functions
  * @{
  *
  * @file
@@ -97,6 +98,18 @@ void Keccak_update(keccak_state_t *ctx, const unsigned char *input,
 void Keccak_final(keccak_state_t *ctx, unsigned char *output,
                   unsigned long long int outputByteLen);
 
+/**
+ * @brief Squeeze more data from a sponge after Keccak_final()
+ *
+ * The output continues where the previous call stopped.
+ *
+ * @param[in,out] ctx        context handle of the sponge
+ * @param[out] output        the squeezed data
+ * @param[in] outputByteLen  size of the data to be squeezed.
+ */
+void Keccak_squeeze(keccak_state_t *ctx, unsigned char *output,
+                    unsigned long long int outputByteLen);
+
 /**
  * @brief SHA3-256 initialization.  Begins a SHA3-256 operation.
  *
@@ -185,6 +198,65 @@ void sha3_384(void *digest, const void *data, size_t len);
  */
 void sha3_512(void *digest, const void *data, size_t len);
 
+/**
+ * @brief SHAKE128 initialization.  Begins a SHAKE128 operation.
+ *
+ * Data is added with sha3_update(), the output is read with shake_final()
+ * and, if more is needed, shake_squeeze().
+ *
+ * @param[in] ctx  keccak_state_t handle to initialise
+ */
+void shake128_init(keccak_state_t *ctx);
+
+/**
+ * @brief SHAKE256 initialization.  Begins a SHAKE256 operation.
+ *
+ * Data is added with sha3_update(), the output is read with shake_final()
+ * and, if more is needed, shake_squeeze().
+ *
+ * @param[in] ctx  keccak_state_t handle to initialise
+ */
+void shake256_init(keccak_state_t *ctx);
+
+/**
+ * @brief SHAKE finalization.  Pads the input data and exports the first
+ * bytes of the output
+ *
+ * @param[in,out] ctx    context handle to use
+ * @param[out] output    resulting output
+ * @param[in] len        number of output bytes
+ */
+void shake_final(keccak_state_t *ctx, void *output, size_t len);
+
+/**
+ * @brief Exports more output of a SHAKE operation after shake_final()
+ *
+ * @param[in,out] ctx    context handle to use
+ * @param[out] output    resulting output, continuing the previous output
+ * @param[in] len        number of output bytes
+ */
+void shake_squeeze(keccak_state_t *ctx, void *output, size_t len);
+
+/**
+ * @brief A wrapper function to compute SHAKE128 of one buffer
+ *
+ * @param[out] output      pointer to an array for the result
+ * @param[in] output_len   number of output bytes
+ * @param[in] data         pointer to the buffer to generate output from
+ * @param[in] len          length of the buffer
+ */
+void shake128(void *output, size_t output_len, const void *data, size_t len);
+
+/**
+ * @brief A wrapper function to compute SHAKE256 of one buffer
+ *
+ * @param[out] output      pointer to an array for the result
+ * @param[in] output_len   number of output bytes
+ * @param[in] data         pointer to the buffer to generate output from
+ * @param[in] len          length of the buffer
+ */
+void shake256(void *output, size_t output_len, const void *data, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -385,6 +385,9 @@
 #include "net/ipv6/addr.h"
 #include "net/sock/udp.h"
 #include "net/nanocoap.h"
+#ifdef MODULE_NANOCOAP_ROUTER
+#include "net/nanocoap_router.h"
+#endif
 #include "xtimer.h"
 
 #ifdef __cplusplus
@@ -417,6 +420,16 @@ extern "C" {
 #ifndef CONFIG_GCOAP_REQ_WAITING_MAX
 #define CONFIG_GCOAP_REQ_WAITING_MAX   (2)
 #endif
+
+/**
+ * @brief   Number of hash buckets to find requests awaiting a response
+ *
+ * Responses are matched to their request by token, empty ACKs by message ID,
+ * each via a hash table with this many buckets.
+ */
+#ifndef CONFIG_GCOAP_REQ_HASH_BUCKETS
+#define CONFIG_GCOAP_REQ_HASH_BUCKETS  (4)
+#endif
 /** @} */
 
 /**
@@ -510,6 +523,17 @@ extern "C" {
 #define CONFIG_GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of hash buckets to find Observe clients and registrations
+ *
+ * Observe clients are found by endpoint, registrations by resource and by
+ * token, each via a hash table with this many buckets.
+ */
+#ifndef CONFIG_GCOAP_OBS_HASH_BUCKETS
+#define CONFIG_GCOAP_OBS_HASH_BUCKETS          (4)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -664,6 +688,13 @@ struct gcoap_listener {
      * @ref resources_len fields to fit their needs.
      */
     gcoap_request_matcher_t request_matcher;
+#if defined(MODULE_NANOCOAP_ROUTER) || defined(DOXYGEN)
+    /**
+     * @brief  Trie over @ref resources, built by gcoap_register_listener()
+     *         for the default request matcher
+     */
+    nanocoap_router_t router;
+#endif
 };
 
 /**
@@ -184,6 +184,22 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   Index off-link entries in a prefix trie
+ *
+ * With this, the longest prefix match for a destination does not need to
+ * look at every off-link entry. This speeds up forwarding on routers with
+ * many routes, at the cost of about 40 bytes of RAM per
+ * @ref CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_OFFL_TRIE
+#if CONFIG_GNRC_IPV6_NIB_6LBR
+#define CONFIG_GNRC_IPV6_NIB_OFFL_TRIE                1
+#else
+#define CONFIG_GNRC_IPV6_NIB_OFFL_TRIE                0
+#endif
+#endif
+
 /**
  * @brief   Support for DNS configuration options
  *
@@ -54,11 +54,43 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_batch   Batched dispatch extension
+ * @ingroup     net_gnrc_netapi
+ * @brief       Batched dispatch extension for @ref net_gnrc_netapi
+ * @{
+ * @details The submodule `gnrc_netapi_batch` lets a thread pass several
+ *          packets to other GNRC threads before yielding to them. While a
+ *          thread is batching (see @ref gnrc_netapi_batch_start()), packets
+ *          it sends via @ref net_gnrc_netapi are put into the message queues
+ *          of their receivers without an immediate context switch. The
+ *          receivers are woken up once, when the batch is flushed with
+ *          @ref gnrc_netapi_batch_flush() or when
+ *          @ref CONFIG_GNRC_NETAPI_BATCH_SIZE messages were queued.
+ *
+ * The event loops of `gnrc_netif`, `gnrc_sixlowpan` and `gnrc_ipv6` batch
+ * while they still have messages waiting, so a burst of frames is passed
+ * through the stack with one context switch per layer instead of one per
+ * packet.
+ *
+ * @note    The message queues of all receivers need space for at least
+ *          @ref CONFIG_GNRC_NETAPI_BATCH_SIZE messages, otherwise packets
+ *          are dropped in a burst.
+ * @note    Messages sent in a batch have @ref KERNEL_PID_ISR as sender.
+ *
+ * To use, add the module `gnrc_netapi_batch` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_batch
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
 #define NET_GNRC_NETAPI_H
 
+#include "kernel_defines.h"
 #include "thread.h"
 #include "net/netopt.h"
 #include "net/gnrc/nettype.h"
@@ -68,6 +100,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Maximum number of messages queued by a batch before the receivers
+ *          are woken up
+ * @ingroup net_gnrc_netapi_batch
+ */
+#ifndef CONFIG_GNRC_NETAPI_BATCH_SIZE
+#define CONFIG_GNRC_NETAPI_BATCH_SIZE   (4U)
+#endif
+
 /**
  * @brief   @ref core_msg type for passing a @ref net_gnrc_pkt up the network stack
  */
@@ -185,6 +226,47 @@ static inline int gnrc_netapi_dispatch_send(gnrc_nettype_t type, uint32_t demux_
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_SND, pkt);
 }
 
+/**
+ * @brief   Sends @p cmd for a number of packets to all subscribers to
+ *          (@p type, @p demux_ctx).
+ *
+ * With module `gnrc_netapi_batch` the subscribers are woken up once for all
+ * packets (see @ref net_gnrc_netapi_batch), otherwise this is equivalent to
+ * calling @ref gnrc_netapi_dispatch() for every packet.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] cmd       command for all subscribers
+ * @param[in] pkts      packets to dispatch
+ * @param[in] pkts_numof number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx). If there are
+ *         none, the packets in @p pkts are left untouched.
+ */
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               uint16_t cmd, gnrc_pktsnip_t *pkts[],
+                               unsigned pkts_numof);
+
+/**
+ * @brief   Sends a @ref GNRC_NETAPI_MSG_TYPE_SND command for a number of
+ *          packets to all subscribers to (@p type, @p demux_ctx).
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] pkts      packets to send
+ * @param[in] pkts_numof number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+static inline int gnrc_netapi_dispatch_send_batch(gnrc_nettype_t type,
+                                                  uint32_t demux_ctx,
+                                                  gnrc_pktsnip_t *pkts[],
+                                                  unsigned pkts_numof)
+{
+    return gnrc_netapi_dispatch_batch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_SND,
+                                      pkts, pkts_numof);
+}
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_RCV messages
  *
@@ -215,6 +297,54 @@ static inline int gnrc_netapi_dispatch_receive(gnrc_nettype_t type, uint32_t dem
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+/**
+ * @brief   Sends a @ref GNRC_NETAPI_MSG_TYPE_RCV command for a number of
+ *          packets to all subscribers to (@p type, @p demux_ctx).
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] pkts      packets to pass up
+ * @param[in] pkts_numof number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+static inline int gnrc_netapi_dispatch_receive_batch(gnrc_nettype_t type,
+                                                     uint32_t demux_ctx,
+                                                     gnrc_pktsnip_t *pkts[],
+                                                     unsigned pkts_numof)
+{
+    return gnrc_netapi_dispatch_batch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV,
+                                      pkts, pkts_numof);
+}
+
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Starts batching the packets the calling thread sends via
+ *          @ref net_gnrc_netapi
+ * @ingroup net_gnrc_netapi_batch
+ *
+ * Does nothing if the calling thread is already batching or when called
+ * from interrupt context.
+ */
+void gnrc_netapi_batch_start(void);
+
+/**
+ * @brief   Stops batching and wakes up the receivers of the batch
+ * @ingroup net_gnrc_netapi_batch
+ *
+ * Event loops call this before they block to wait for the next message.
+ */
+void gnrc_netapi_batch_flush(void);
+#else
+static inline void gnrc_netapi_batch_start(void)
+{
+}
+
+static inline void gnrc_netapi_batch_flush(void)
+{
+}
+#endif
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_GET messages and
  *          parsing the returned @ref GNRC_NETAPI_MSG_TYPE_ACK message
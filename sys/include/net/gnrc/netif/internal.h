@@ -63,6 +63,33 @@ void gnrc_netif_acquire(gnrc_netif_t *netif);
  */
 void gnrc_netif_release(gnrc_netif_t *netif);
 
+#if IS_USED(MODULE_NETDEV_RX_LOAN) || DOXYGEN
+/**
+ * @brief   Receives a frame from the interface's device without copying it
+ *
+ * The frame stays in the buffer lent out by the device driver (see
+ * netdev_driver_t::recv_loan), which is handed back to the driver when
+ * the packet is released. If the packet buffer can't take more loaned
+ * buffers (see @ref CONFIG_GNRC_PKTBUF_LOAN_NUMOF), the frame is copied.
+ *
+ * @param[in] netif     the network interface
+ * @param[out] pkt      the frame in a snip of type GNRC_NETTYPE_UNDEF
+ * @param[out] info     device class specific receive info, as for
+ *                      netdev_driver_t::recv
+ *
+ * @return  length of the frame
+ * @retval  -ENOBUFS    the driver does not lend out buffers or has no free
+ *                      buffer left. Use netdev_driver_t::recv instead.
+ * @retval  -ENOMEM     no space left in the packet buffer, the frame was
+ *                      dropped
+ * @retval  <= 0        other errors of netdev_driver_t::recv_loan
+ *
+ * @internal
+ */
+int gnrc_netif_recv_loaned(gnrc_netif_t *netif, gnrc_pktsnip_t **pkt,
+                           void *info);
+#endif
+
 #if IS_USED(MODULE_GNRC_NETIF_IPV6) || DOXYGEN
 /**
  * @brief   Adds an IPv6 address to the interface
@@ -35,6 +35,31 @@
 extern "C" {
 #endif
 
+/**
+ * @defgroup net_gnrc_netreg_conf GNRC NETREG compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of hash buckets per protocol type (as exponent of 2^n).
+ *
+ *          Entries are distributed over the buckets of their protocol type
+ *          by their gnrc_netreg_entry_t::demux_ctx, so a lookup only needs
+ *          to search the entries in one bucket. The default of 0 keeps all
+ *          entries of a protocol type in a single list. Increase this if
+ *          many entries are registered for the same type, e.g. hundreds of
+ *          UDP sockets, at the cost of one pointer per bucket and type.
+ */
+#ifndef CONFIG_GNRC_NETREG_BUCKETS_EXP
+#define CONFIG_GNRC_NETREG_BUCKETS_EXP  0
+#endif
+/** @} */
+
+/**
+ * @brief   Number of hash buckets per protocol type
+ */
+#define GNRC_NETREG_BUCKETS     (1 << CONFIG_GNRC_NETREG_BUCKETS_EXP)
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
@@ -335,6 +360,27 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry);
  */
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Searches for entries with given parameters in the registry,
+ *          returns the first found and counts all of them.
+ *
+ * This combines gnrc_netreg_lookup() and gnrc_netreg_num() in a single pass
+ * over the registry, e.g. for dispatching a packet to all entries.
+ *
+ * @param[in] type      Type of the protocol.
+ * @param[in] demux_ctx The demultiplexing context for the registered thread.
+ *                      See gnrc_netreg_entry_t::demux_ctx.
+ * @param[out] num      Number of entries with the same
+ *                      gnrc_netreg_entry_t::type and
+ *                      gnrc_netreg_entry_t::demux_ctx as the given
+ *                      parameters. Must not be NULL.
+ *
+ * @return  The first entry fitting the given parameters on success
+ * @return  NULL if no entry can be found.
+ */
+gnrc_netreg_entry_t *gnrc_netreg_lookup_num(gnrc_nettype_t type,
+                                            uint32_t demux_ctx, int *num);
+
 /**
  * @brief   Returns number of entries with the same gnrc_netreg_entry_t::type and
  *          gnrc_netreg_entry_t::demux_ctx.
@@ -63,8 +63,29 @@ extern "C" {
 #ifndef CONFIG_GNRC_PKTBUF_SIZE
 #define CONFIG_GNRC_PKTBUF_SIZE    (6144)
 #endif
+
+/**
+ * @brief   Maximum number of buffers loaned to the packet buffer at the same
+ *          time (module `gnrc_pktbuf_loan`)
+ *
+ * @see     gnrc_pktbuf_add_loaned()
+ */
+#ifndef CONFIG_GNRC_PKTBUF_LOAN_NUMOF
+#define CONFIG_GNRC_PKTBUF_LOAN_NUMOF   (4U)
+#endif
 /** @} */
 
+/**
+ * @brief   Callback returning loaned data to its owner
+ *
+ * Called with the packet buffer locked, so it must not call any packet
+ * buffer functions. It may be called from any thread that releases packets.
+ *
+ * @param[in] ctx   context given to gnrc_pktbuf_add_loaned()
+ * @param[in] data  data given to gnrc_pktbuf_add_loaned()
+ */
+typedef void (*gnrc_pktbuf_loan_cb_t)(void *ctx, void *data);
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -94,6 +115,34 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
                                 gnrc_nettype_t type);
 
+/**
+ * @brief   Adds a new gnrc_pktsnip_t using loaned data instead of copying
+ *          it into the packet buffer
+ *
+ * The packet buffer uses @p data in place until no snip refers to it any
+ * longer and then hands it back with @p cb. Snips created by
+ * gnrc_pktbuf_mark() share the loaned data; functions that need more space
+ * than loaned move the data into the packet buffer.
+ *
+ * @note    Only available with module `gnrc_pktbuf_loan`
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      Loaned data, must not be NULL.
+ * @param[in] size      Length of @p data, must not be 0.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ * @param[in] cb        Callback to return @p data with.
+ * @param[in] ctx       Context for @p cb.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer or
+ *          @ref CONFIG_GNRC_PKTBUF_LOAN_NUMOF buffers are already loaned.
+ *          @p data is not taken over then.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_loaned(gnrc_pktsnip_t *next, void *data,
+                                       size_t size, gnrc_nettype_t type,
+                                       gnrc_pktbuf_loan_cb_t cb, void *ctx);
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -30,6 +30,10 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_CONGURE_RENO
+#include "congure/reno.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -101,6 +105,50 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+#if defined(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+/**
+ * @brief Set the congestion control for a connection.
+ *
+ * The congestion window limits the number of bytes in flight in addition to
+ * the peers receive window and @ref CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE.
+ * @p congure is (re-)initialized with the TCB as context every time the
+ * connection is opened.
+ *
+ * @note Only available with module `gnrc_tcp_congure`.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre The connection must be closed.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     congure   Congestion control to use for @p tcb, whose
+ *                          sizes are in bytes. NULL to disable congestion
+ *                          control. Must stay valid as long as @p tcb is used.
+ */
+void gnrc_tcp_tcb_set_congure(gnrc_tcp_tcb_t *tcb, congure_snd_t *congure);
+#endif
+
+#if (defined(MODULE_GNRC_TCP_CONGURE) && defined(MODULE_CONGURE_RENO)) || defined(DOXYGEN)
+/**
+ * @brief Fast retransmit callback for @ref congure_reno_snd_consts_t::fr.
+ *
+ * @note Only available with modules `gnrc_tcp_congure` and `congure_reno`.
+ *
+ * @param[in] c   CongURE NewReno state object used by a TCB.
+ */
+void gnrc_tcp_congure_reno_fr(congure_reno_snd_t *c);
+
+/**
+ * @brief NewReno constants for GNRC TCP.
+ *
+ * Can be used with @ref congure_reno_snd_setup() and
+ * @ref congure_cocoa_snd_setup().
+ *
+ * @note Only available with modules `gnrc_tcp_congure` and `congure_reno`.
+ */
+extern const congure_reno_snd_consts_t gnrc_tcp_congure_reno_consts;
+#endif
+
 /**
  * @brief Opens a connection actively.
  *
@@ -162,19 +210,26 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       Without congestion control (see gnrc_tcp_tcb_set_congure()), this is
+ *       the case once a single segment was acknowledged. With congestion
+ *       control, the function only returns early on errors or if
+ *       @p user_timeout_duration_ms expired.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
  * @param[in]     len                        Number of bytes that should be transmitted.
- * @param[in]     user_timeout_duration_ms   If not zero and there was not data transmitted
- *                                           the function returns after user_timeout_duration_ms.
+ * @param[in]     user_timeout_duration_ms   If not zero, the function returns after
+ *                                           user_timeout_duration_ms with the number of
+ *                                           bytes acknowledged so far, or -ETIMEDOUT if
+ *                                           there was no data acknowledged.
  *                                           If zero, no timeout will be triggered.
  *
  * @return   The number of successfully transmitted bytes.
  * @return   -ENOTCONN if connection is not established.
  * @return   -ECONNRESET if connection was reset by the peer.
  * @return   -ECONNABORTED if the connection was aborted.
- * @return   -ETIMEDOUT if @p user_timeout_duration_ms expired.
+ * @return   -ETIMEDOUT if @p user_timeout_duration_ms expired before any data was
+ *           acknowledged.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_ms);
@@ -20,6 +20,7 @@
 #ifndef NET_GNRC_TCP_CONFIG_H
 #define NET_GNRC_TCP_CONFIG_H
 
+#include "kernel_defines.h"
 #include "timex.h"
 
 #ifdef __cplusplus
@@ -86,6 +87,9 @@ extern "C" {
 
 /**
  * @brief Default receive window size
+ *
+ * Windows larger than 65535 bytes are only announced to the peer with module
+ * `gnrc_tcp_wscale`.
  */
 #ifndef CONFIG_GNRC_TCP_DEFAULT_WINDOW
 #define CONFIG_GNRC_TCP_DEFAULT_WINDOW (CONFIG_GNRC_TCP_MSS * CONFIG_GNRC_TCP_MSS_MULTIPLICATOR)
@@ -101,6 +105,36 @@ extern "C" {
 #define CONFIG_GNRC_TCP_RCV_BUFFERS (1U)
 #endif
 
+/**
+ * @brief Number of segments that can be in flight per connection.
+ *
+ * Each unacknowledged segment is kept in the retransmission queue. With a
+ * single slot, TCP waits for the acknowledgement of each segment before
+ * sending the next one. More slots only help if the peer's receive window
+ * covers several segments, e.g. with CONFIG_GNRC_TCP_MSS_MULTIPLICATOR > 1.
+ * With module `gnrc_tcp_congure`, the congestion window limits the segments
+ * in flight further.
+ */
+#ifndef CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+#define CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE (4U)
+#else
+#define CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE (1U)
+#endif
+#endif
+
+/**
+ * @brief Number of out-of-order segments kept per connection.
+ *
+ * Only used with module `gnrc_tcp_sack`. Segments arriving after a gap in
+ * the received data are kept in the packet buffer until the gap is filled
+ * and are reported to the peer with SACK options. Without them, the peer has
+ * to retransmit everything following a lost segment.
+ */
+#ifndef CONFIG_GNRC_TCP_OOO_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_OOO_QUEUE_SIZE (4U)
+#endif
+
 /**
  * @brief Default receive buffer size
  */
@@ -20,6 +20,7 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -34,10 +35,25 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_TCP_CONGURE
+#include "congure.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Entry of the retransmission queue.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< Sent segment */
+    uint32_t send_time;    /**< Timer value of the last transmission */
+    uint8_t resends;       /**< Number of retransmissions */
+    bool lost;             /**< Segment needs to be retransmitted after a timeout */
+    bool sacked;           /**< Segment was selectively acknowledged by the peer */
+} gnrc_tcp_retransmit_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -54,22 +70,42 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
-    uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint8_t options;       /**< Options in use, see GNRC_TCP_OPTION_* in gnrc_tcp_option.h */
+    uint8_t snd_wscale;    /**< Window scale of the peer */
+    uint8_t rcv_wscale;    /**< Window scale announced to the peer */
+#ifdef MODULE_GNRC_TCP_TIMESTAMPS
+    uint32_t ts_recent;    /**< Timestamp to echo to the peer */
+#endif
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     evtimer_msg_event_t event_retransmit; /**< Retransmission event */
     evtimer_mbox_event_t event_misc;      /**< General purpose event */
-    gnrc_pktsnip_t *pkt_retransmit;       /**< Pointer to packet in "retransmit queue" */
+    /**
+     * @brief Segments in "retransmit queue", oldest first
+     */
+    gnrc_tcp_retransmit_t retransmit_queue[CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE];
+    uint8_t retransmit_numof;             /**< Number of segments in retransmit_queue */
+#ifdef MODULE_GNRC_TCP_SACK
+    /**
+     * @brief Received out-of-order segments, ordered by sequence number
+     */
+    gnrc_pktsnip_t *ooo_queue[CONFIG_GNRC_TCP_OOO_QUEUE_SIZE];
+    uint8_t ooo_numof;     /**< Number of segments in ooo_queue */
+    uint32_t ooo_last;     /**< Sequence number of the latest out-of-order segment */
+#endif
+#ifdef MODULE_GNRC_TCP_CONGURE
+    congure_snd_t *congure;  /**< Congestion control, NULL if none is used */
+#endif
     mbox_t *mbox;            /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
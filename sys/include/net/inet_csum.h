@@ -27,6 +27,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Sum up the buffer byte by byte instead of a 32-bit word at a time
+ *
+ * The byte-wise implementation is smaller, but considerably slower.
+ */
+#ifndef CONFIG_INET_CSUM_BYTEWISE
+#define CONFIG_INET_CSUM_BYTEWISE   0
+#endif
+
 /**
  * @brief   Calculates the unnormalized Internet Checksum of @p buf, where the
  *          buffer provides a slice of the full checksum domain, calculated in order.
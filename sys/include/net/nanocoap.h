@@ -137,6 +137,17 @@ extern "C" {
 #define CONFIG_NANOCOAP_URI_MAX            (64)
 #endif
 
+/**
+ * @brief    Maximum number of Uri-Path segments indexed by coap_parse()
+ *
+ * coap_get_uri_path() copies indexed segments without decoding the options
+ * again. The path of requests with more segments is still read, but from the
+ * options.
+ */
+#ifndef CONFIG_NANOCOAP_URI_PATH_SEGS_MAX
+#define CONFIG_NANOCOAP_URI_PATH_SEGS_MAX  (8)
+#endif
+
 /**
  * @brief    Maximum size for a blockwise transfer as a power of 2
  */
@@ -179,6 +190,14 @@ typedef struct {
     uint16_t offset;            /**< offset in packet           */
 } coap_optpos_t;
 
+/**
+ * @brief   Uri-Path segment entry
+ */
+typedef struct {
+    uint16_t offset;            /**< offset of the value in packet  */
+    uint16_t len;               /**< length of the value            */
+} coap_uri_seg_t;
+
 /**
  * @brief   CoAP PDU parsing context structure
  */
@@ -189,6 +208,11 @@ typedef struct {
     uint16_t payload_len;                             /**< length of payload       */
     uint16_t options_len;                             /**< length of options array */
     coap_optpos_t options[CONFIG_NANOCOAP_NOPTS_MAX]; /**< option offset array     */
+    /**
+     * @brief   number of Uri-Path segments + 1, 0 if not indexed
+     */
+    uint8_t uri_path_segs;
+    coap_uri_seg_t uri_path[CONFIG_NANOCOAP_URI_PATH_SEGS_MAX]; /**< Uri-Path segments */
 #ifdef MODULE_GCOAP
     uint32_t observe_value;                           /**< observe value           */
 #endif
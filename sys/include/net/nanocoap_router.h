@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_nanocoap_router Nanocoap trie router
+ * @ingroup     net_nanocoap
+ * @brief       Resource lookup in a radix trie instead of a linear scan
+ *
+ * By default nanocoap and gcoap compare the URI-path of a request with every
+ * resource path until one matches, so the cost of routing a request grows
+ * with the number of resources. With module `nanocoap_router`, a radix trie
+ * over the resource paths is built once for a resource array, and a lookup
+ * only walks the characters of the URI-path.
+ *
+ * The lookup returns the same resource as the linear scan, including the
+ * rules of _Server path matching_ in the [nanocoap](group__net__nanocoap.html)
+ * documentation: the resource array must be ordered by path, and of all
+ * resources matching a request the first one in the array that allows the
+ * request method is chosen.
+ *
+ * With this module, coap_handle_req() routes via a trie built on the first
+ * request, and gcoap builds a trie in gcoap_register_listener() for every
+ * listener that uses the default request matcher.
+ *
+ * The trie nodes are taken from a static pool of
+ * @ref CONFIG_NANOCOAP_ROUTER_NODES_NUMOF nodes, shared by all routers. A
+ * resource array takes at most NANOCOAP_ROUTER_NODES_NEEDED() nodes. If the
+ * pool runs out, requests are routed by the linear scan.
+ *
+ * @{
+ *
+ * @file
+ * @brief       nanocoap trie router API
+ */
+
+#ifndef NET_NANOCOAP_ROUTER_H
+#define NET_NANOCOAP_ROUTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/nanocoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_nanocoap_router_conf    Nanocoap trie router compile configurations
+ * @ingroup  net_nanocoap_conf
+ * @{
+ */
+/**
+ * @brief   Number of trie nodes shared by all routers
+ */
+#ifndef CONFIG_NANOCOAP_ROUTER_NODES_NUMOF
+#define CONFIG_NANOCOAP_ROUTER_NODES_NUMOF  (64)
+#endif
+/** @} */
+
+/**
+ * @brief   Upper bound of the number of trie nodes for @p numof resources
+ */
+#define NANOCOAP_ROUTER_NODES_NEEDED(numof) (2 * (numof) + 1)
+
+/**
+ * @brief   Trie node
+ *
+ * All indices are stored + 1, so 0 means none.
+ */
+typedef struct {
+    const char *label;          /**< edge label, points into a resource path */
+    uint16_t label_len;         /**< length of the edge label */
+    uint16_t child;             /**< first child node */
+    uint16_t sibling;           /**< next sibling node */
+    uint16_t resource;          /**< first resource with the path of the node */
+    uint16_t resources_numof;   /**< number of resources with that path */
+} nanocoap_router_node_t;
+
+/**
+ * @brief   Trie router for one resource array
+ */
+typedef struct {
+    const coap_resource_t *resources;   /**< resources of the trie */
+    nanocoap_router_node_t *nodes;      /**< trie nodes, the root first */
+} nanocoap_router_t;
+
+/**
+ * @brief   Builds the trie for a resource array
+ *
+ * @param[out] router           router to initialize
+ * @param[in]  resources        resources, ordered by path
+ * @param[in]  resources_numof  number of entries in @p resources
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if the node pool is exhausted, @p router is left unused
+ * @return  -EINVAL if @p resources is not ordered by path
+ */
+int nanocoap_router_init(nanocoap_router_t *router,
+                         const coap_resource_t *resources,
+                         size_t resources_numof);
+
+/**
+ * @brief   Checks if @p router was initialized successfully
+ *
+ * @param[in] router    router to check
+ *
+ * @return  true if @p router can be used for lookups
+ */
+static inline bool nanocoap_router_is_ready(const nanocoap_router_t *router)
+{
+    return router->nodes != NULL;
+}
+
+/**
+ * @brief   Finds the resource for a URI-path
+ *
+ * @param[in]  router       router to search
+ * @param[in]  uri          null-terminated URI-path, as read by
+ *                          coap_get_uri_path()
+ * @param[in]  method_flag  method of the request, see coap_method2flag()
+ * @param[out] resource     matching resource
+ *
+ * @return  0 if a resource matches @p uri and @p method_flag
+ * @return  -EPERM if resources match @p uri, but none allows @p method_flag
+ * @return  -ENOENT if no resource matches @p uri
+ */
+int nanocoap_router_find(const nanocoap_router_t *router, const char *uri,
+                         coap_method_flags_t method_flag,
+                         const coap_resource_t **resource);
+
+/**
+ * @brief   Routes a request to its resource handler
+ *
+ * Same as coap_tree_handler(), with the resources of @p router.
+ *
+ * @param[in]  router       router to search
+ * @param[in]  pkt          request
+ * @param[out] resp_buf     buffer for the response
+ * @param[in]  resp_buf_len size of @p resp_buf
+ *
+ * @return  length of the response
+ * @return  <0 on error
+ */
+ssize_t nanocoap_router_handle(const nanocoap_router_t *router, coap_pkt_t *pkt,
+                               uint8_t *resp_buf, unsigned resp_buf_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NANOCOAP_ROUTER_H */
+/** @} */
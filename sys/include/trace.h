@@ -13,23 +13,46 @@
  * @brief       Trace program flows
  *
  * This module allows recording program flow traces. It is meant for debugging
- * in multi-threaded applications or when ISR's are involved.
+ * and profiling in multi-threaded applications or when ISR's are involved.
  *
- * The `trace()` function takes an arbitrary (user chosen) uint32 value.
- * Calling the function is safe from anywhere (user code, ISR, ...) and safely
- * logs the function call time and user value in a trace buffer.
+ * Each trace entry consists of a timestamp, an event type, the thread active
+ * while recording and an argument that depends on the event type. The
+ * `trace()` function records a @ref TRACE_EVENT_USER event with an arbitrary
+ * (user chosen) uint32 value, `trace_event()` records any other event.
+ * Recording is safe from anywhere (user code, ISR, ...).
  *
- * At any point, `trace_dump()` can be used to print the trace buffer.
+ * Timestamps are taken from the fastest counter available: the DWT cycle
+ * counter on Cortex-M3 and above, `clock_gettime()` with nanosecond
+ * resolution on native and `xtimer_now_usec()` everywhere else.
+ *
+ * The following pseudomodules record events of other parts of the system:
+ *
+ * | Module         | Events                                                |
+ * |:-------------- |:----------------------------------------------------- |
+ * | `trace_sched`  | @ref TRACE_EVENT_SCHED_OUT, @ref TRACE_EVENT_SCHED_IN |
+ * | `trace_isr`    | @ref TRACE_EVENT_ISR_ENTER, @ref TRACE_EVENT_ISR_EXIT |
+ * | `trace_mutex`  | @ref TRACE_EVENT_MUTEX_LOCK to @ref TRACE_EVENT_MUTEX_UNLOCK |
+ * | `trace_msg`    | @ref TRACE_EVENT_MSG_SEND, @ref TRACE_EVENT_MSG_RECEIVE |
+ * | `trace_netapi` | @ref TRACE_EVENT_NETAPI_DISPATCH, @ref TRACE_EVENT_NETAPI_SEND |
+ *
+ * `trace_sched` uses @ref sched_register_cb and can't be used together with
+ * `schedstatistics`. On Cortex-M, `trace_isr` only records the exit of ISRs
+ * that end with @ref cortexm_isr_end, as there is no common ISR entry.
+ *
+ * At any point, `trace_dump()` can be used to print the trace buffer, or
+ * `trace_export()` to drain it as a binary stream (see below).
  *
  * The buffer has a default size of 512 entries, which can be overridden by
  * defining CONFIG_TRACE_BUFSIZE. It can be cleared using `trace_reset()`.
  * The trace buffer works like a ring-buffer. If it is full, it will start
- * overwriting from the beginning.
+ * overwriting the oldest entries. Overwritten entries that were not exported
+ * yet are reported as a single @ref TRACE_EVENT_LOST entry on export.
  *
  * Tracing is made thread safe by disabling interrupts for critical sections.
  *
- * It does incur some overhead (at least a function call, getting the current
- * time, a pair of enable/disable interrupts and a couple of memory accesses).
+ * It does incur some overhead (a function call, reading the timestamp
+ * counter, a pair of enable/disable interrupts and a couple of memory
+ * accesses).
  *
  * Example:
  *
@@ -41,6 +64,15 @@
  * trace_dump();
  * ~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * ## Binary stream
+ *
+ * Every call to `trace_export()` writes a block consisting of a
+ * @ref trace_hdr_t followed by `trace_hdr_t::numof` entries of type
+ * @ref trace_entry_t. All fields are in the byte order of the node, which
+ * the reader can tell from trace_hdr_t::version. Blocks can simply be
+ * concatenated, e.g. when exporting periodically over UART.
+ * `dist/tools/trace/trace_decode.py` converts such a stream to text.
+ *
  * @{
  *
  * @brief       Execution tracing module API
@@ -53,17 +85,103 @@
 #ifndef TRACE_H
 #define TRACE_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <sys/types.h>
+
+#include "kernel_defines.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Magic number at the start of each block of the binary stream
+ *          ("RTRC" in ASCII)
+ */
+#define TRACE_MAGIC             (0x43525452UL)
+
+/**
+ * @brief   Version of the binary stream format
+ */
+#define TRACE_VERSION           (1U)
+
+/**
+ * @brief   Event types
+ */
+enum {
+    TRACE_EVENT_USER = 0,       /**< `trace()`, arg: user value */
+    TRACE_EVENT_LOST,           /**< entries were overwritten before export,
+                                     arg: number of entries */
+    TRACE_EVENT_SCHED_OUT,      /**< thread was descheduled, arg: its PID */
+    TRACE_EVENT_SCHED_IN,       /**< thread was scheduled, arg: its PID */
+    TRACE_EVENT_ISR_ENTER,      /**< ISR starts, arg: signal number on native,
+                                     exception number (IPSR) on Cortex-M */
+    TRACE_EVENT_ISR_EXIT,       /**< ISR ends, arg: as above */
+    TRACE_EVENT_MUTEX_LOCK,     /**< thread tries to lock, arg: mutex */
+    TRACE_EVENT_MUTEX_LOCKED,   /**< thread got the mutex, arg: mutex */
+    TRACE_EVENT_MUTEX_UNLOCK,   /**< mutex is unlocked, arg: mutex */
+    TRACE_EVENT_MSG_SEND,       /**< message is sent, arg: target PID */
+    TRACE_EVENT_MSG_RECEIVE,    /**< message was received, arg: sender PID */
+    TRACE_EVENT_NETAPI_DISPATCH,/**< packet is dispatched,
+                                     arg: (nettype << 16) | command */
+    TRACE_EVENT_NETAPI_SEND,    /**< netapi message is sent,
+                                     arg: (target PID << 16) | command */
+    TRACE_EVENT_APP = 0x8000,   /**< first event type free for applications */
+};
+
+/**
+ * @brief   Header of a block in the binary stream
+ */
+typedef struct {
+    uint32_t magic;             /**< @ref TRACE_MAGIC */
+    uint16_t version;           /**< @ref TRACE_VERSION */
+    uint16_t entry_size;        /**< sizeof(trace_entry_t) */
+    uint32_t freq;              /**< timestamp frequency in Hz,
+                                     0 if unknown */
+    uint32_t numof;             /**< number of entries in the block */
+} trace_hdr_t;
+
+/**
+ * @brief   Trace entry
+ */
+typedef struct {
+    uint32_t time;              /**< timestamp, wraps around */
+    uint16_t event;             /**< event type */
+    int16_t pid;                /**< active thread, KERNEL_PID_ISR in ISRs */
+    uint32_t arg;               /**< event argument */
+} trace_entry_t;
+
+/**
+ * @brief   Write function for @ref trace_export
+ *
+ * @param[in] ctx   context passed to @ref trace_export
+ * @param[in] data  data to write
+ * @param[in] len   number of bytes in @p data
+ *
+ * @return  number of bytes written, or negative on error
+ */
+typedef ssize_t (*trace_write_t)(void *ctx, const void *data, size_t len);
+
+/**
+ * @brief   Initialize the timestamp counter and register the hooks
+ *
+ * Called by `auto_init`.
+ */
+void trace_init(void);
+
 /**
  * @brief   Add entry to trace buffer
  *
- * Adds the current time (e.g., xtimer_now_usec()) and @p val to the trace
- * buffer.
+ * @param[in]   event   event type, see @ref TRACE_EVENT_USER et al.
+ * @param[in]   arg     event argument
+ */
+void trace_event(uint16_t event, uint32_t arg);
+
+/**
+ * @brief   Add user entry to trace buffer
+ *
+ * Adds the current time and @p val to the trace buffer.
  *
  * The value parameter is not used by the trace module itself. The caller is
  * supposed to provide a meaningful value.
@@ -71,16 +189,21 @@ extern "C" {
  *
  * @param[in]   val     user defined value
  */
-void trace(uint32_t val);
+static inline void trace(uint32_t val)
+{
+    trace_event(TRACE_EVENT_USER, val);
+}
 
 /**
  * @brief   Print the current trace buffer
  *
  * Will print the number of the trace log entry, the timestamp (first entry) or
  * relative time since last entry, and the value supplied to the `trace()` call
- * of each entry.
+ * of each entry. Entries other than @ref TRACE_EVENT_USER additionally
+ * contain the event type and the active thread.
  *
- * Example output (after adding two traces, 3us apart, with values 0 and 1):
+ * Example output (after adding two traces, 3 timestamp ticks apart, with
+ * values 0 and 1):
  *
  *     n=   0 t=  1815312 v=0x00000000
  *     n=   1 t=+       3 v=0x00000001
@@ -92,6 +215,97 @@ void trace_dump(void);
  */
 void trace_reset(void);
 
+/**
+ * @brief   Drain the trace buffer as one block of the binary stream
+ *
+ * Tracing continues while exporting. Entries recorded after the call
+ * started are left for the next export.
+ *
+ * @param[in] write     function writing the stream
+ * @param[in] ctx       context for @p write
+ *
+ * @return  number of entries exported
+ * @return  negative error of @p write
+ */
+int trace_export(trace_write_t write, void *ctx);
+
+/**
+ * @brief   Drain the trace buffer to stdio
+ *
+ * @return  number of entries exported, negative on error
+ */
+int trace_export_stdio(void);
+
+#if defined(CPU_NATIVE) || defined(DOXYGEN)
+/**
+ * @brief   Drain the trace buffer to a file on the host
+ *
+ * @note    Only available on native
+ *
+ * @param[in] path      file to write, truncated if it exists
+ *
+ * @return  number of entries exported, negative errno on error
+ */
+int trace_export_file(const char *path);
+#endif
+
+/**
+ * @name    Hooks for the tracing pseudomodules
+ *
+ * Compiled out if the corresponding pseudomodule is not used.
+ * @{
+ */
+/**
+ * @brief   Record a scheduler event (`trace_sched`)
+ */
+static inline void trace_sched(uint16_t event, int16_t pid)
+{
+    if (IS_USED(MODULE_TRACE_SCHED)) {
+        trace_event(event, pid);
+    }
+}
+
+/**
+ * @brief   Record an ISR event (`trace_isr`)
+ */
+static inline void trace_isr(uint16_t event, unsigned irq)
+{
+    if (IS_USED(MODULE_TRACE_ISR)) {
+        trace_event(event, irq);
+    }
+}
+
+/**
+ * @brief   Record a mutex event (`trace_mutex`)
+ */
+static inline void trace_mutex(uint16_t event, const void *mutex)
+{
+    if (IS_USED(MODULE_TRACE_MUTEX)) {
+        trace_event(event, (uintptr_t)mutex);
+    }
+}
+
+/**
+ * @brief   Record a message event (`trace_msg`)
+ */
+static inline void trace_msg(uint16_t event, int16_t pid)
+{
+    if (IS_USED(MODULE_TRACE_MSG)) {
+        trace_event(event, pid);
+    }
+}
+
+/**
+ * @brief   Record a netapi event (`trace_netapi`)
+ */
+static inline void trace_netapi(uint16_t event, uint16_t hi, uint16_t cmd)
+{
+    if (IS_USED(MODULE_TRACE_NETAPI)) {
+        trace_event(event, ((uint32_t)hi << 16) | cmd);
+    }
+}
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -165,6 +165,51 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c);
  */
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n);
 
+/**
+ * @brief       Get the contiguous region of the bytes available for reading
+ *
+ * This allows to process the bytes in place, e.g. to decode a frame
+ * without copying it out first. When done, the processed bytes are removed
+ * with @ref tsrb_drop(). As the readable bytes may wrap around the end of
+ * the buffer, call this again after @ref tsrb_drop() to get the rest.
+ *
+ * @pre         There is only one consumer of @p rb
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    Start of the contiguous region
+ *
+ * @return      nr of bytes readable at @p data
+ */
+size_t tsrb_peek_contiguous(tsrb_t *rb, const uint8_t **data);
+
+/**
+ * @brief       Get the contiguous region of free space for writing
+ *
+ * This allows a producer, e.g. a DMA transfer, to write to the ringbuffer
+ * in place. The bytes written become available for reading with
+ * @ref tsrb_commit().
+ *
+ * @pre         There is only one producer of @p rb
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    Start of the contiguous region
+ *
+ * @return      nr of bytes writable at @p data
+ */
+size_t tsrb_reserve_contiguous(tsrb_t *rb, uint8_t **data);
+
+/**
+ * @brief       Make bytes written to the region returned by
+ *              @ref tsrb_reserve_contiguous() available for reading
+ *
+ * @pre         @p n is not larger than the size returned by
+ *              @ref tsrb_reserve_contiguous()
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written
+ */
+void tsrb_commit(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
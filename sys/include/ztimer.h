@@ -135,10 +135,21 @@
  * made a constant operation, at the price of another pointer per timer object
  * (for "previous" element).
  *
- * If deemed necessary, the linked list can be exchanged our augmented with
- * another data structure providing better algorithmic guarantees. It remains
- * to be shown whether the increased complexity would lead to better
- * performance for any reasonable amount of active timers.
+ * For clocks carrying hundreds or thousands of active timers, the module
+ * `ztimer_heap` provides an alternative storage: a pairing heap ordered by the
+ * absolute target time of each timer. Using it costs two additional pointers
+ * per timer object, but gives:
+ *
+ * - constant get_min() and insertion
+ * - O(log n) amortized removal (including the removal of the head on expiry)
+ *
+ * The heap is selected per clock using ztimer_clock_use_heap(), so e.g. only a
+ * heavily loaded ZTIMER_MSEC can be switched while ZTIMER_USEC keeps using the
+ * list. For the default clocks, this is controlled by
+ * @ref CONFIG_ZTIMER_USEC_HEAP, @ref CONFIG_ZTIMER_MSEC_HEAP and
+ * @ref CONFIG_ZTIMER_SEC_HEAP. With either storage, timers are triggered in the
+ * order of their target time, but the order of timers sharing the same target
+ * time is only guaranteed to be the insertion order for the list.
  *
  *
  * ## Clock extension
@@ -240,6 +251,7 @@
 #ifndef ZTIMER_H
 #define ZTIMER_H
 
+#include <assert.h>
 #include <stdint.h>
 
 #include "sched.h"
@@ -270,8 +282,14 @@ typedef struct ztimer_clock ztimer_clock_t;
  * @brief   Minimum information for each timer
  */
 struct ztimer_base {
-    ztimer_base_t *next;        /**< next timer in list */
-    uint32_t offset;            /**< offset from last timer in list */
+    ztimer_base_t *next;        /**< next timer in list, or next sibling if
+                                     the clock uses a heap */
+    uint32_t offset;            /**< offset from last timer in list, or
+                                     absolute target if the clock uses a heap */
+#if MODULE_ZTIMER_HEAP || DOXYGEN
+    ztimer_base_t *child;       /**< first child in heap */
+    ztimer_base_t *prev;        /**< parent or previous sibling in heap */
+#endif
 };
 
 #if MODULE_ZTIMER_NOW64
@@ -285,6 +303,11 @@ typedef uint32_t ztimer_now_t;  /**< type for ztimer_now() result */
  *
  * This type represents an instance of a timer, which is set on an
  * underlying clock object
+ *
+ * @note    A timer must be zero-initialized before its first use, e.g. by
+ *          `ztimer_t timer = { 0 };` or a designated initializer. Clocks using
+ *          a heap (see @ref ztimer_clock_use_heap) take a timer with garbage
+ *          links for a set one.
  */
 typedef struct {
     ztimer_base_t base;             /**< clock list entry */
@@ -339,6 +362,9 @@ struct ztimer_clock {
 #if MODULE_PM_LAYERED || DOXYGEN
     uint8_t block_pm_mode;          /**< min. pm mode to block for the clock to run */
 #endif
+#if MODULE_ZTIMER_HEAP || DOXYGEN
+    uint8_t use_heap;               /**< store timers in a pairing heap     */
+#endif
 };
 
 /**
@@ -568,6 +594,21 @@ int ztimer_rmutex_lock_timeout(ztimer_clock_t *clock, rmutex_t *rmutex,
  */
 void ztimer_update_head_offset(ztimer_clock_t *clock);
 
+#if defined(MODULE_ZTIMER_HEAP) || defined(DOXYGEN)
+/**
+ * @brief   Store the timers of a clock in a pairing heap instead of a list
+ *
+ * This must be called before the first timer is set on @p clock.
+ *
+ * @param[in]   clock  ztimer clock to switch
+ */
+static inline void ztimer_clock_use_heap(ztimer_clock_t *clock)
+{
+    assert(clock->list.next == NULL);
+    clock->use_heap = 1;
+}
+#endif /* MODULE_ZTIMER_HEAP */
+
 /**
  * @brief   Initialize the board-specific default ztimer configuration
  */
@@ -136,6 +136,34 @@ extern "C" {
 #  endif
 #endif
 
+/**
+ * @brief   Store the timers of ZTIMER_USEC in a pairing heap
+ *
+ * Only effective if module `ztimer_heap` is used.
+ */
+#ifndef CONFIG_ZTIMER_USEC_HEAP
+#define CONFIG_ZTIMER_USEC_HEAP             0
+#endif
+
+/**
+ * @brief   Store the timers of ZTIMER_MSEC in a pairing heap
+ *
+ * Only effective if module `ztimer_heap` is used. This is the clock most
+ * network protocol timeouts end up on, so it is enabled by default.
+ */
+#ifndef CONFIG_ZTIMER_MSEC_HEAP
+#define CONFIG_ZTIMER_MSEC_HEAP             1
+#endif
+
+/**
+ * @brief   Store the timers of ZTIMER_SEC in a pairing heap
+ *
+ * Only effective if module `ztimer_heap` is used.
+ */
+#ifndef CONFIG_ZTIMER_SEC_HEAP
+#define CONFIG_ZTIMER_SEC_HEAP              0
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -62,6 +62,10 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+static void _req_memo_index(gcoap_request_memo_t *memo, bool add);
+static void _release_req_memo(gcoap_request_memo_t *memo);
+static void _observer_index(sock_udp_ep_t *observer, bool add);
+static void _obs_memo_index(gcoap_observe_memo_t *memo, bool add);
 
 static int _request_matcher_default(gcoap_listener_t *listener,
                                     const coap_resource_t **resource,
@@ -73,11 +77,11 @@ const coap_resource_t _default_resources[] = {
 };
 
 static gcoap_listener_t _default_listener = {
-    &_default_resources[0],
-    ARRAY_SIZE(_default_resources),
-    NULL,
-    NULL,
-    _request_matcher_default
+    .resources = &_default_resources[0],
+    .resources_len = ARRAY_SIZE(_default_resources),
+    .link_encoder = NULL,
+    .next = NULL,
+    .request_matcher = _request_matcher_default,
 };
 
 /* Container for the state of gcoap itself */
@@ -98,6 +102,20 @@ typedef struct {
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+    struct {
+        uint16_t req_by_token[CONFIG_GCOAP_REQ_HASH_BUCKETS];
+        uint16_t req_by_mid[CONFIG_GCOAP_REQ_HASH_BUCKETS];
+        uint16_t req_token_next[CONFIG_GCOAP_REQ_WAITING_MAX];
+        uint16_t req_mid_next[CONFIG_GCOAP_REQ_WAITING_MAX];
+        uint16_t observer_by_ep[CONFIG_GCOAP_OBS_HASH_BUCKETS];
+        uint16_t observer_next[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+        uint16_t obs_by_resource[CONFIG_GCOAP_OBS_HASH_BUCKETS];
+        uint16_t obs_resource_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+        uint16_t obs_by_token[CONFIG_GCOAP_OBS_HASH_BUCKETS];
+        uint16_t obs_token_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+    } chains;                           /* Hash chains over the arrays above,
+                                           see _chain_add(); changed with lock
+                                           held */
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -233,11 +251,7 @@ static void _process_coap_pdu(sock_udp_t *sock, sock_udp_ep_t *remote,
                 if (memo->resp_handler) {
                     memo->resp_handler(memo, &pdu, remote);
                 }
-
-                if (memo->send_limit >= 0) {        /* if confirmable */
-                    *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                }
-                memo->state = GCOAP_MEMO_UNUSED;
+                _release_req_memo(memo);
                 break;
             default:
                 DEBUG("gcoap: illegal response type: %u\n", coap_get_type(&pdu));
@@ -394,6 +408,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                     if (obs_slot >= 0) {
                         observer = &_coap_state.observers[obs_slot];
                         memcpy(observer, remote, sizeof(sock_udp_ep_t));
+                        _observer_index(observer, true);
                     } else {
                         DEBUG("gcoap: can't register observer\n");
                     }
@@ -410,12 +425,15 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
         /* finish registration */
         if (memo != NULL) {
+            /* resource and token may change, so index the memo again */
+            _obs_memo_index(memo, false);
             /* resource may be assigned here if it is not already registered */
             memo->resource = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
+            _obs_memo_index(memo, true);
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
         }
 
@@ -424,12 +442,14 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
+            _obs_memo_index(memo, false);
             memo->observer = NULL;
             memo           = NULL;
             _find_obs_memo(&memo, remote, NULL);
             if (memo == NULL) {
                 _find_observer(&observer, remote);
                 if (observer != NULL) {
+                    _observer_index(observer, false);
                     observer->family = AF_UNSPEC;
                 }
             }
@@ -467,6 +487,20 @@ static int _request_matcher_default(gcoap_listener_t *listener,
     coap_method_flags_t method_flag = coap_method2flag(
         coap_get_code_detail(pdu));
 
+#ifdef MODULE_NANOCOAP_ROUTER
+    if (nanocoap_router_is_ready(&listener->router)) {
+        switch (nanocoap_router_find(&listener->router, (char *)uri,
+                                     method_flag, resource)) {
+        case 0:
+            return GCOAP_RESOURCE_FOUND;
+        case -EPERM:
+            return GCOAP_RESOURCE_WRONG_METHOD;
+        default:
+            return GCOAP_RESOURCE_NO_PATH;
+        }
+    }
+#endif
+
     for (size_t i = 0; i < listener->resources_len; i++) {
         *resource = &listener->resources[i];
 
@@ -548,6 +582,116 @@ static int _find_resource(const coap_pkt_t *pdu,
     return ret;
 }
 
+/*
+ * Hash chains
+ *
+ * Request memos, observers and observe memos are linked into chains of slot
+ * indices, so matching an incoming message only compares the entries of one
+ * bucket. heads[] holds the first slot of each bucket and next[] the slot
+ * following a slot; both store index + 1, so 0 terminates a chain.
+ */
+
+static uint32_t _fnv1a(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+
+    while (len--) {
+        hash ^= *bytes++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static void _chain_add(uint16_t *heads, uint16_t *next, unsigned bucket,
+                       unsigned slot)
+{
+    next[slot] = heads[bucket];
+    heads[bucket] = slot + 1;
+}
+
+/* Removes slot from its chain; does nothing if slot is not linked. */
+static void _chain_del(uint16_t *heads, uint16_t *next, unsigned bucket,
+                       unsigned slot)
+{
+    for (uint16_t *idx = &heads[bucket]; *idx; idx = &next[*idx - 1]) {
+        if (*idx == slot + 1) {
+            *idx = next[slot];
+            next[slot] = 0;
+            break;
+        }
+    }
+}
+
+static unsigned _token_bucket(const uint8_t *token, unsigned token_len,
+                              unsigned buckets)
+{
+    return _fnv1a(2166136261UL, token, token_len) % buckets;
+}
+
+static unsigned _ep_bucket(const sock_udp_ep_t *ep)
+{
+    /* sock_udp_ep_equal() compares only the first four bytes for IPv4 */
+    size_t addr_len = (ep->family == AF_INET) ? 4 : sizeof(ep->addr);
+    uint32_t hash = _fnv1a(2166136261UL, &ep->port, sizeof(ep->port));
+
+    return _fnv1a(hash, &ep->addr, addr_len) % CONFIG_GCOAP_OBS_HASH_BUCKETS;
+}
+
+static unsigned _resource_bucket(const coap_resource_t *resource)
+{
+    return _fnv1a(2166136261UL, &resource, sizeof(resource))
+           % CONFIG_GCOAP_OBS_HASH_BUCKETS;
+}
+
+/* Header of the request tracked by a memo */
+static coap_hdr_t *_memo_hdr(gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    return (coap_hdr_t *)memo->msg.data.pdu_buf;
+}
+
+/*
+ * Adds a request memo to, or removes it from, the token and message ID
+ * chains. Expects _coap_state.lock to be held.
+ */
+static void _req_memo_index(gcoap_request_memo_t *memo, bool add)
+{
+    unsigned slot = memo - &_coap_state.open_reqs[0];
+    coap_hdr_t *hdr = _memo_hdr(memo);
+    unsigned token_bucket = _token_bucket(coap_hdr_data_ptr(hdr),
+                                          hdr->ver_t_tkl & 0xf,
+                                          CONFIG_GCOAP_REQ_HASH_BUCKETS);
+    unsigned mid_bucket = hdr->id % CONFIG_GCOAP_REQ_HASH_BUCKETS;
+
+    if (add) {
+        _chain_add(_coap_state.chains.req_by_token,
+                   _coap_state.chains.req_token_next, token_bucket, slot);
+        _chain_add(_coap_state.chains.req_by_mid,
+                   _coap_state.chains.req_mid_next, mid_bucket, slot);
+    }
+    else {
+        _chain_del(_coap_state.chains.req_by_token,
+                   _coap_state.chains.req_token_next, token_bucket, slot);
+        _chain_del(_coap_state.chains.req_by_mid,
+                   _coap_state.chains.req_mid_next, mid_bucket, slot);
+    }
+}
+
+/* Frees a request memo and its resend buffer, if any. */
+static void _release_req_memo(gcoap_request_memo_t *memo)
+{
+    mutex_lock(&_coap_state.lock);
+    /* unlink first; the token is read from the resend buffer */
+    _req_memo_index(memo, false);
+    if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+        *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
+    }
+    memo->state = GCOAP_MEMO_UNUSED;
+    mutex_unlock(&_coap_state.lock);
+}
+
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
  * array. Matches on remote endpoint and token.
@@ -565,19 +709,25 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t memo_pdu_data;
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
+    uint16_t *next;
+    unsigned idx;
+
+    mutex_lock(&_coap_state.lock);
+    if (by_mid) {
+        idx = _coap_state.chains.req_by_mid[src_pdu->hdr->id
+                                            % CONFIG_GCOAP_REQ_HASH_BUCKETS];
+        next = _coap_state.chains.req_mid_next;
+    }
+    else {
+        idx = _coap_state.chains.req_by_token[
+                _token_bucket(src_pdu->token, cmplen,
+                              CONFIG_GCOAP_REQ_HASH_BUCKETS)];
+        next = _coap_state.chains.req_token_next;
+    }
 
-    for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-            continue;
-        }
-
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
-        }
+    for (; idx; idx = next[idx - 1]) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[idx - 1];
+        memo_pdu->hdr = _memo_hdr(memo);
 
         if (by_mid) {
             if ((src_pdu->hdr->id == memo_pdu->hdr->id)
@@ -594,6 +744,7 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
             }
         }
     }
+    mutex_unlock(&_coap_state.lock);
 }
 
 /* Calls handler callback on receipt of a timeout message. */
@@ -605,18 +756,10 @@ static void _expire_request(gcoap_request_memo_t *memo)
         /* Pass response to handler */
         if (memo->resp_handler) {
             coap_pkt_t req;
-            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-                req.hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];   /* for reference */
-            }
-            else {
-                req.hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
-            }
+            req.hdr = _memo_hdr(memo);  /* for reference */
             memo->resp_handler(memo, &req, NULL);
         }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-        }
-        memo->state = GCOAP_MEMO_UNUSED;
+        _release_req_memo(memo);
     }
     else {
         /* Response already handled; timeout must have fired while response */
@@ -642,6 +785,52 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
     return plen;
 }
 
+/*
+ * Adds an observer to, or removes it from, the endpoint chains.
+ */
+static void _observer_index(sock_udp_ep_t *observer, bool add)
+{
+    unsigned slot = observer - &_coap_state.observers[0];
+    unsigned bucket = _ep_bucket(observer);
+
+    mutex_lock(&_coap_state.lock);
+    if (add) {
+        _chain_add(_coap_state.chains.observer_by_ep,
+                   _coap_state.chains.observer_next, bucket, slot);
+    }
+    else {
+        _chain_del(_coap_state.chains.observer_by_ep,
+                   _coap_state.chains.observer_next, bucket, slot);
+    }
+    mutex_unlock(&_coap_state.lock);
+}
+
+/*
+ * Adds an observe memo to, or removes it from, the resource and token chains.
+ */
+static void _obs_memo_index(gcoap_observe_memo_t *memo, bool add)
+{
+    unsigned slot = memo - &_coap_state.observe_memos[0];
+    unsigned res_bucket = _resource_bucket(memo->resource);
+    unsigned token_bucket = _token_bucket(memo->token, memo->token_len,
+                                          CONFIG_GCOAP_OBS_HASH_BUCKETS);
+
+    mutex_lock(&_coap_state.lock);
+    if (add) {
+        _chain_add(_coap_state.chains.obs_by_resource,
+                   _coap_state.chains.obs_resource_next, res_bucket, slot);
+        _chain_add(_coap_state.chains.obs_by_token,
+                   _coap_state.chains.obs_token_next, token_bucket, slot);
+    }
+    else {
+        _chain_del(_coap_state.chains.obs_by_resource,
+                   _coap_state.chains.obs_resource_next, res_bucket, slot);
+        _chain_del(_coap_state.chains.obs_by_token,
+                   _coap_state.chains.obs_token_next, token_bucket, slot);
+    }
+    mutex_unlock(&_coap_state.lock);
+}
+
 /*
  * Find registered observer for a remote address and port.
  *
@@ -653,19 +842,21 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
  */
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
 {
-    int empty_slot = -1;
-    *observer      = NULL;
-    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_CLIENTS_MAX; i++) {
+    *observer = NULL;
+    for (unsigned idx = _coap_state.chains.observer_by_ep[_ep_bucket(remote)];
+         idx; idx = _coap_state.chains.observer_next[idx - 1]) {
+        if (sock_udp_ep_equal(&_coap_state.observers[idx - 1], remote)) {
+            *observer = &_coap_state.observers[idx - 1];
+            return -1;
+        }
+    }
 
+    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_CLIENTS_MAX; i++) {
         if (_coap_state.observers[i].family == AF_UNSPEC) {
-            empty_slot = i;
-        }
-        else if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
-            *observer = &_coap_state.observers[i];
-            break;
+            return i;
         }
     }
-    return empty_slot;
+    return -1;
 }
 
 /*
@@ -681,36 +872,45 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu)
 {
-    int empty_slot = -1;
-    *memo          = NULL;
+    *memo = NULL;
 
     sock_udp_ep_t *remote_observer = NULL;
     _find_observer(&remote_observer, remote);
 
-    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
-            continue;
-        }
-
-        if (_coap_state.observe_memos[i].observer == remote_observer) {
-            if (pdu == NULL) {
-                *memo = &_coap_state.observe_memos[i];
-                break;
-            }
-
-            if (_coap_state.observe_memos[i].token_len == coap_get_token_len(pdu)) {
-                unsigned cmplen = _coap_state.observe_memos[i].token_len;
-                if (cmplen &&
-                        memcmp(&_coap_state.observe_memos[i].token[0], &pdu->token[0],
-                                                                       cmplen) == 0) {
+    if (remote_observer != NULL) {
+        if (pdu == NULL) {
+            /* only used to deregister, so a scan is good enough */
+            for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+                if (_coap_state.observe_memos[i].observer == remote_observer) {
                     *memo = &_coap_state.observe_memos[i];
-                    break;
+                    return -1;
                 }
             }
         }
+        else if (coap_get_token_len(pdu)) {
+            unsigned cmplen = coap_get_token_len(pdu);
+            unsigned bucket = _token_bucket(pdu->token, cmplen,
+                                            CONFIG_GCOAP_OBS_HASH_BUCKETS);
+            for (unsigned idx = _coap_state.chains.obs_by_token[bucket];
+                 idx; idx = _coap_state.chains.obs_token_next[idx - 1]) {
+                gcoap_observe_memo_t *obs_memo = &_coap_state.observe_memos[idx - 1];
+                if ((obs_memo->observer == remote_observer)
+                        && (obs_memo->token_len == cmplen)
+                        && (memcmp(&obs_memo->token[0], &pdu->token[0],
+                                   cmplen) == 0)) {
+                    *memo = obs_memo;
+                    return -1;
+                }
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        if (_coap_state.observe_memos[i].observer == NULL) {
+            return i;
+        }
     }
-    return empty_slot;
+    return -1;
 }
 
 /*
@@ -723,13 +923,15 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
     *memo = NULL;
-    for (int i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
-            *memo = &_coap_state.observe_memos[i];
+    mutex_lock(&_coap_state.lock);
+    for (unsigned idx = _coap_state.chains.obs_by_resource[_resource_bucket(resource)];
+         idx; idx = _coap_state.chains.obs_resource_next[idx - 1]) {
+        if (_coap_state.observe_memos[idx - 1].resource == resource) {
+            *memo = &_coap_state.observe_memos[idx - 1];
             break;
         }
     }
+    mutex_unlock(&_coap_state.lock);
 }
 
 /*
@@ -750,6 +952,7 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    memset(&_coap_state.chains, 0, sizeof(_coap_state.chains));
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -772,6 +975,14 @@ void gcoap_register_listener(gcoap_listener_t *listener)
     if (!listener->request_matcher) {
         listener->request_matcher = _request_matcher_default;
     }
+
+#ifdef MODULE_NANOCOAP_ROUTER
+    if ((listener->request_matcher == _request_matcher_default)
+            && (nanocoap_router_init(&listener->router, listener->resources,
+                                     listener->resources_len) != 0)) {
+        DEBUG("gcoap: no trie for listener, using linear matching\n");
+    }
+#endif
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
@@ -881,6 +1092,9 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
             DEBUG("gcoap: illegal msg type %u\n", msg_type);
             break;
         }
+        if (memo->state != GCOAP_MEMO_UNUSED) {
+            _req_memo_index(memo, true);
+        }
         mutex_unlock(&_coap_state.lock);
         if (memo->state == GCOAP_MEMO_UNUSED) {
             return 0;
@@ -903,13 +1117,10 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
     ssize_t res = sock_udp_send(&_sock_udp, buf, len, remote);
     if (res <= 0) {
         if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
             if (timeout > 0) {
                 event_timeout_clear(&memo->resp_evt_tmout);
             }
-            memo->state = GCOAP_MEMO_UNUSED;
+            _release_req_memo(memo);
         }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
     }
@@ -926,6 +1137,7 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     unsigned header_len  = coap_get_total_hdr_len(pdu);
 
     pdu->options_len = 0;
+    pdu->uri_path_segs = 0;
     pdu->payload     = buf + header_len;
     pdu->payload_len = len - header_len;
 
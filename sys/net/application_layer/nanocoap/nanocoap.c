@@ -28,6 +28,9 @@
 
 #include "bitarithm.h"
 #include "net/nanocoap.h"
+#ifdef MODULE_NANOCOAP_ROUTER
+#include "net/nanocoap_router.h"
+#endif
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -68,6 +71,7 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
 
     pkt->payload = NULL;
     pkt->payload_len = 0;
+    pkt->uri_path_segs = 0;
 
     if (len < sizeof(coap_hdr_t)) {
         DEBUG("msg too short\n");
@@ -95,6 +99,10 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     coap_optpos_t *optpos = pkt->options;
     unsigned option_count = 0;
     unsigned option_nr = 0;
+    /* Uri-Path segments are indexed if all of them fit the index, otherwise
+     * coap_get_uri_path() decodes the options again */
+    unsigned uri_path_segs = 0;
+    bool uri_path_indexed = true;
 
     /* parse options */
     while (pkt_pos < pkt_end) {
@@ -133,6 +141,17 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
                 option_count++;
             }
 
+            if ((option_nr == COAP_OPT_URI_PATH) && uri_path_indexed) {
+                if (uri_path_segs < CONFIG_NANOCOAP_URI_PATH_SEGS_MAX) {
+                    coap_uri_seg_t *seg = &pkt->uri_path[uri_path_segs++];
+                    seg->offset = (uintptr_t)pkt_pos - (uintptr_t)hdr;
+                    seg->len = option_len;
+                }
+                else {
+                    uri_path_indexed = false;
+                }
+            }
+
             pkt_pos += option_len;
         }
     }
@@ -143,6 +162,9 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     }
 
     pkt->options_len = option_count;
+    if (uri_path_indexed) {
+        pkt->uri_path_segs = uri_path_segs + 1;
+    }
     if (!pkt->payload) {
         pkt->payload = pkt_pos;
     }
@@ -181,10 +203,14 @@ uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
     const coap_optpos_t *optpos = pkt->options;
     unsigned opt_count = pkt->options_len;
 
+    /* options are stored in ascending order of their number */
     while (opt_count--) {
         if (optpos->opt_num == opt_num) {
             return (uint8_t*)pkt->hdr + optpos->offset;
         }
+        if (optpos->opt_num > opt_num) {
+            break;
+        }
         optpos++;
     }
     return NULL;
@@ -325,11 +351,43 @@ ssize_t coap_opt_get_next(const coap_pkt_t *pkt, coap_optpos_t *opt,
     return len;
 }
 
+/* assembles the Uri-Path from the segments indexed by coap_parse(), without
+ * decoding the options again */
+static ssize_t _get_uri_path_indexed(const coap_pkt_t *pkt, uint8_t *target,
+                                     size_t max_len, char separator)
+{
+    unsigned segs = pkt->uri_path_segs - 1;
+    unsigned left = max_len - 1;
+
+    if (!segs) {
+        *target++ = (uint8_t)separator;
+        *target = '\0';
+        return 2;
+    }
+    for (unsigned i = 0; i < segs; i++) {
+        const coap_uri_seg_t *seg = &pkt->uri_path[i];
+        if (left < (unsigned)(seg->len + 1)) {
+            return -ENOSPC;
+        }
+        *target++ = (uint8_t)separator;
+        memcpy(target, (uint8_t *)pkt->hdr + seg->offset, seg->len);
+        target += seg->len;
+        left -= (seg->len + 1);
+    }
+    *target = '\0';
+
+    return (int)(max_len - left);
+}
+
 ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
                             uint8_t *target, size_t max_len, char separator)
 {
     assert(pkt && target && (max_len > 1));
 
+    if ((optnum == COAP_OPT_URI_PATH) && pkt->uri_path_segs) {
+        return _get_uri_path_indexed(pkt, target, max_len, separator);
+    }
+
     uint8_t *opt_pos = coap_find_option(pkt, optnum);
     if (!opt_pos) {
         *target++ = (uint8_t)separator;
@@ -402,6 +460,19 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
     if (pkt->hdr->code == 0) {
         return coap_build_reply(pkt, COAP_CODE_EMPTY, resp_buf, resp_buf_len, 0);
     }
+#ifdef MODULE_NANOCOAP_ROUTER
+    /* built on the first request, as coap_resources_numof is not known at
+     * compile time; stays unused if the trie does not fit the node pool */
+    static nanocoap_router_t router;
+    static bool router_init_done;
+    if (!router_init_done) {
+        nanocoap_router_init(&router, coap_resources, coap_resources_numof);
+        router_init_done = true;
+    }
+    if (nanocoap_router_is_ready(&router)) {
+        return nanocoap_router_handle(&router, pkt, resp_buf, resp_buf_len);
+    }
+#endif
     return coap_tree_handler(pkt, resp_buf, resp_buf_len, coap_resources,
                              coap_resources_numof);
 }
@@ -841,6 +912,9 @@ static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, const uint8_t *val
     pkt->options[pkt->options_len].opt_num = optnum;
     pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
     pkt->options_len++;
+    if (optnum == COAP_OPT_URI_PATH) {
+        pkt->uri_path_segs = 0;
+    }
     pkt->payload += optlen;
     pkt->payload_len -= optlen;
 
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap_router
+ * @{
+ *
+ * @file
+ * @brief       Nanocoap trie router implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/nanocoap_router.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static nanocoap_router_node_t _pool[CONFIG_NANOCOAP_ROUTER_NODES_NUMOF];
+static unsigned _pool_used;
+static mutex_t _pool_lock = MUTEX_INIT;
+
+static unsigned _common_prefix_len(const char *a, const char *b, unsigned len)
+{
+    unsigned i = 0;
+
+    while ((i < len) && (a[i] == b[i])) {
+        i++;
+    }
+    return i;
+}
+
+/* returns the child of node whose label starts with c, NULL if none */
+static nanocoap_router_node_t *_child(nanocoap_router_node_t *nodes,
+                                      const nanocoap_router_node_t *node,
+                                      char c)
+{
+    for (unsigned idx = node->child; idx; idx = nodes[idx - 1].sibling) {
+        if (nodes[idx - 1].label[0] == c) {
+            return &nodes[idx - 1];
+        }
+    }
+    return NULL;
+}
+
+static nanocoap_router_node_t *_new_node(const char *label, unsigned label_len)
+{
+    if (_pool_used >= CONFIG_NANOCOAP_ROUTER_NODES_NUMOF) {
+        return NULL;
+    }
+
+    nanocoap_router_node_t *node = &_pool[_pool_used++];
+    memset(node, 0, sizeof(*node));
+    node->label = label;
+    node->label_len = label_len;
+    return node;
+}
+
+static inline unsigned _idx(const nanocoap_router_node_t *nodes,
+                            const nanocoap_router_node_t *node)
+{
+    return node - nodes + 1;
+}
+
+static int _insert(nanocoap_router_node_t *nodes, const char *path,
+                   unsigned res_idx)
+{
+    nanocoap_router_node_t *node = &nodes[0];
+    unsigned len = strlen(path);
+    unsigned pos = 0;
+
+    while (pos < len) {
+        nanocoap_router_node_t *child = _child(nodes, node, path[pos]);
+
+        if (child == NULL) {
+            /* rest of the path becomes a new leaf */
+            child = _new_node(&path[pos], len - pos);
+            if (child == NULL) {
+                return -ENOMEM;
+            }
+            child->sibling = node->child;
+            node->child = _idx(nodes, child);
+            node = child;
+            break;
+        }
+
+        unsigned common = _common_prefix_len(child->label, &path[pos],
+                                             (child->label_len < len - pos)
+                                             ? child->label_len : len - pos);
+        if (common < child->label_len) {
+            /* path ends or diverges within the edge: split it, child keeps
+             * its place among its siblings and the rest of the edge moves
+             * to a new node */
+            nanocoap_router_node_t *tail = _new_node(NULL, 0);
+            if (tail == NULL) {
+                return -ENOMEM;
+            }
+            *tail = *child;
+            tail->label += common;
+            tail->label_len -= common;
+            tail->sibling = 0;
+            child->label_len = common;
+            child->child = _idx(nodes, tail);
+            child->resource = 0;
+            child->resources_numof = 0;
+        }
+        node = child;
+        pos += common;
+    }
+
+    if (node->resource == 0) {
+        node->resource = res_idx + 1;
+    }
+    node->resources_numof++;
+    return 0;
+}
+
+int nanocoap_router_init(nanocoap_router_t *router,
+                         const coap_resource_t *resources,
+                         size_t resources_numof)
+{
+    assert(router && (resources || !resources_numof));
+
+    int res = 0;
+
+    router->resources = resources;
+    router->nodes = NULL;
+
+    if (resources_numof >= UINT16_MAX) {
+        return -ENOMEM;
+    }
+
+    mutex_lock(&_pool_lock);
+    unsigned pool_start = _pool_used;
+    nanocoap_router_node_t *nodes = _new_node("", 0);
+
+    if (nodes == NULL) {
+        res = -ENOMEM;
+    }
+    for (unsigned i = 0; (res == 0) && (i < resources_numof); i++) {
+        if ((i > 0) && (strcmp(resources[i - 1].path, resources[i].path) > 0)) {
+            DEBUG("nanocoap_router: %s not in order\n", resources[i].path);
+            res = -EINVAL;
+            break;
+        }
+        res = _insert(nodes, resources[i].path, i);
+    }
+    if (res == 0) {
+        router->nodes = nodes;
+        DEBUG("nanocoap_router: %u resources in %u nodes\n",
+              (unsigned)resources_numof, _pool_used - pool_start);
+    }
+    else {
+        _pool_used = pool_start;
+    }
+    mutex_unlock(&_pool_lock);
+
+    return res;
+}
+
+int nanocoap_router_find(const nanocoap_router_t *router, const char *uri,
+                         coap_method_flags_t method_flag,
+                         const coap_resource_t **resource)
+{
+    assert(nanocoap_router_is_ready(router) && uri && resource);
+
+    const nanocoap_router_node_t *node = &router->nodes[0];
+    unsigned len = strlen(uri);
+    unsigned pos = 0;
+    int ret = -ENOENT;
+
+    /* resources on the way down match as prefix of the URI, in the order of
+     * their path length, so the first match is the one the linear scan of the
+     * ordered resource array would find */
+    while (1) {
+        for (unsigned i = 0; i < node->resources_numof; i++) {
+            const coap_resource_t *r = &router->resources[node->resource - 1 + i];
+            if ((pos < len) && !(r->methods & COAP_MATCH_SUBTREE)) {
+                continue;
+            }
+            if (r->methods & method_flag) {
+                *resource = r;
+                return 0;
+            }
+            ret = -EPERM;
+        }
+        if (pos == len) {
+            break;
+        }
+
+        node = _child(router->nodes, node, uri[pos]);
+        if ((node == NULL) || (node->label_len > len - pos)
+                || memcmp(node->label, &uri[pos], node->label_len)) {
+            break;
+        }
+        pos += node->label_len;
+    }
+
+    return ret;
+}
+
+ssize_t nanocoap_router_handle(const nanocoap_router_t *router, coap_pkt_t *pkt,
+                               uint8_t *resp_buf, unsigned resp_buf_len)
+{
+    coap_method_flags_t method_flag = coap_method2flag(coap_get_code_detail(pkt));
+    const coap_resource_t *resource;
+
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+    if (coap_get_uri_path(pkt, uri) <= 0) {
+        return -EBADMSG;
+    }
+    DEBUG("nanocoap_router: URI path: \"%s\"\n", uri);
+
+    if (nanocoap_router_find(router, (char *)uri, method_flag, &resource) == 0) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
@@ -13,13 +13,72 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#if !IS_ACTIVE(CONFIG_INET_CSUM_BYTEWISE)
+/* the buffer holds bytes of any type, so words are read through types that
+ * may alias them */
+typedef uint16_t __attribute__((may_alias)) _alias_u16_t;
+typedef uint32_t __attribute__((may_alias)) _alias_u32_t;
+
+/* sums up buf as 16-bit words in host byte order, where words are aligned to
+ * even addresses and a missing byte at either end is taken as 0 */
+static uint32_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+
+    if ((uintptr_t)buf & 1) {
+        uint16_t word = 0;
+
+        ((uint8_t *)&word)[1] = *buf;
+        sum += word;
+        buf++;
+        len--;
+    }
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        sum += *(const _alias_u16_t *)(const void *)buf;
+        buf += 2;
+        len -= 2;
+    }
+
+    /* buf is 32-bit aligned now, the carries are collected in the upper
+     * half of sum and folded in only once at the end */
+    const _alias_u32_t *words = (const void *)buf;
+    for (; len >= 16; len -= 16, words += 4) {
+        sum += words[0];
+        sum += words[1];
+        sum += words[2];
+        sum += words[3];
+    }
+    for (; len >= 4; len -= 4) {
+        sum += *(words++);
+    }
+    buf = (const uint8_t *)words;
+    if (len >= 2) {
+        sum += *(const _alias_u16_t *)(const void *)buf;
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        uint16_t word = 0;
+
+        ((uint8_t *)&word)[0] = *buf;
+        sum += word;
+    }
+
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    return sum;
+}
+#endif
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -38,6 +97,7 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     if (len == 0)
         return csum;
 
+#if IS_ACTIVE(CONFIG_INET_CSUM_BYTEWISE)
     if (accum_len & 1) {      /* if accumulated length is odd */
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
@@ -52,6 +112,22 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
 
     if ((accum_len + len) & 1)          /* if accumulated length is odd */
         csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+#else
+    uint32_t words = _sum_words(buf, len);
+
+    words = (words & 0xffff) + (words >> 16);
+    words = (words & 0xffff) + (words >> 16);
+    /* The 1's complement sum is independent of the byte order, except that
+     * the bytes of the result are swapped (RFC 1071, section 2(B)). The
+     * words summed up are in network byte order if the buffer's position in
+     * the checksum domain matches its alignment in memory and the host is
+     * big endian. */
+    bool swap = (accum_len & 1) ^ ((uintptr_t)buf & 1);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    swap = !swap;
+#endif
+    csum += swap ? byteorder_swaps(words) : words;
+#endif
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
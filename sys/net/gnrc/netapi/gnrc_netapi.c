@@ -20,9 +20,13 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 
+#include "irq.h"
 #include "mbox.h"
 #include "msg.h"
+#include "sched.h"
+#include "trace.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
@@ -51,14 +55,75 @@ int _gnrc_netapi_get_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
     return (int)ack.content.value;
 }
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* number of messages queued by each thread's batch plus one,
+ * 0 if the thread is not batching */
+static uint8_t _batch[MAXTHREADS];
+
+static inline uint8_t *_batch_get(void)
+{
+    /* every thread only touches its own counter, so no locking is needed */
+    return &_batch[thread_getpid() - KERNEL_PID_FIRST];
+}
+
+static void _batch_wakeup(void)
+{
+    /* sched_context_switch_request was set by msg_send_int() if a receiver
+     * was woken up */
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+void gnrc_netapi_batch_start(void)
+{
+    if (!irq_is_in() && (*_batch_get() == 0)) {
+        *_batch_get() = 1;
+    }
+}
+
+void gnrc_netapi_batch_flush(void)
+{
+    if (irq_is_in() || (*_batch_get() == 0)) {
+        return;
+    }
+    *_batch_get() = 0;
+    _batch_wakeup();
+}
+
+static int _try_send(msg_t *msg, kernel_pid_t pid)
+{
+    uint8_t *batch;
+
+    if (irq_is_in() || (*(batch = _batch_get()) == 0)) {
+        return msg_try_send(msg, pid);
+    }
+    /* queue the message as an ISR would: without yielding to the receiver */
+    unsigned state = irq_disable();
+    int ret = msg_send_int(msg, pid);
+    irq_restore(state);
+    if (++(*batch) > CONFIG_GNRC_NETAPI_BATCH_SIZE) {
+        *batch = 1;
+        _batch_wakeup();
+    }
+    return ret;
+}
+#else
+static inline int _try_send(msg_t *msg, kernel_pid_t pid)
+{
+    return msg_try_send(msg, pid);
+}
+#endif
+
 int _gnrc_netapi_send_recv(kernel_pid_t pid, gnrc_pktsnip_t *pkt, uint16_t type)
 {
     msg_t msg;
     /* set the outgoing message's fields */
     msg.type = type;
     msg.content.ptr = (void *)pkt;
+    trace_netapi(TRACE_EVENT_NETAPI_SEND, pid, type);
     /* send message */
-    int ret = msg_try_send(&msg, pid);
+    int ret = _try_send(&msg, pid);
     if (ret < 1) {
         DEBUG("gnrc_netapi: dropped message to %" PRIkernel_pid " (%s)\n", pid,
               (ret == 0) ? "receiver queue is full" : "invalid receiver");
@@ -85,11 +150,13 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
-    int numof = gnrc_netreg_num(type, demux_ctx);
+    int numof;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup_num(type, demux_ctx,
+                                                         &numof);
 
-    if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+    trace_netapi(TRACE_EVENT_NETAPI_DISPATCH, type, cmd);
 
+    if (numof != 0) {
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
@@ -136,3 +203,30 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
 
     return numof;
 }
+
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               uint16_t cmd, gnrc_pktsnip_t *pkts[],
+                               unsigned pkts_numof)
+{
+    int numof = gnrc_netreg_num(type, demux_ctx);
+
+    trace_netapi(TRACE_EVENT_NETAPI_DISPATCH, type, cmd);
+    if (numof == 0) {
+        return 0;
+    }
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    /* only flush the batch if it was not started by the caller */
+    bool flush = !irq_is_in() && (*_batch_get() == 0);
+
+    gnrc_netapi_batch_start();
+#endif
+    for (unsigned i = 0; i < pkts_numof; i++) {
+        gnrc_netapi_dispatch(type, demux_ctx, cmd, pkts[i]);
+    }
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    if (flush) {
+        gnrc_netapi_batch_flush();
+    }
+#endif
+    return numof;
+}
@@ -447,6 +447,43 @@ void gnrc_netif_release(gnrc_netif_t *netif)
     }
 }
 
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+static void _recv_return(void *ctx, void *data)
+{
+    netdev_t *dev = ctx;
+
+    dev->driver->recv_return(dev, data);
+}
+
+int gnrc_netif_recv_loaned(gnrc_netif_t *netif, gnrc_pktsnip_t **pkt,
+                           void *info)
+{
+    netdev_t *dev = netif->dev;
+    void *buf;
+    int nread;
+
+    if (dev->driver->recv_loan == NULL) {
+        return -ENOBUFS;
+    }
+    nread = dev->driver->recv_loan(dev, &buf, info);
+    if (nread <= 0) {
+        return nread;
+    }
+    *pkt = gnrc_pktbuf_add_loaned(NULL, buf, nread, GNRC_NETTYPE_UNDEF,
+                                  _recv_return, dev);
+    if (*pkt == NULL) {
+        /* all loan slots are taken, so copy the frame after all */
+        DEBUG("gnrc_netif: unable to loan frame to packet buffer\n");
+        *pkt = gnrc_pktbuf_add(NULL, buf, nread, GNRC_NETTYPE_UNDEF);
+        dev->driver->recv_return(dev, buf);
+        if (*pkt == NULL) {
+            return -ENOMEM;
+        }
+    }
+    return nread;
+}
+#endif
+
 #if IS_USED(MODULE_GNRC_NETIF_IPV6)
 static int _addr_idx(const gnrc_netif_t *netif, const ipv6_addr_t *addr);
 static int _group_idx(const gnrc_netif_t *netif, const ipv6_addr_t *addr);
@@ -1504,8 +1541,11 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
             /* non-blocking msg check */
             int msg_waiting = msg_try_receive(msg);
             if (msg_waiting > 0) {
+                gnrc_netapi_batch_start();
                 return;
             }
+            /* wake up the receivers of the packets handled so far */
+            gnrc_netapi_batch_flush();
             DEBUG("gnrc_netif: waiting for events\n");
             /* Block the thread until something interesting happens */
             thread_flags_wait_any(THREAD_FLAG_MSG_WAITING | THREAD_FLAG_EVENT);
@@ -1514,7 +1554,12 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
     else {
         /* Only messages used for event handling */
         DEBUG("gnrc_netif: waiting for incoming messages\n");
+        if (msg_avail() == 0) {
+            /* wake up the receivers of the packets handled so far */
+            gnrc_netapi_batch_flush();
+        }
         msg_receive(msg);
+        gnrc_netapi_batch_start();
     }
 }
 
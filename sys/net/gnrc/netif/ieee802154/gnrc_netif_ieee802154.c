@@ -13,8 +13,11 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
+
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netif/internal.h"
 #include "net/netdev/ieee802154.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -90,28 +93,55 @@ static inline bool _already_received(gnrc_netif_t *netif,
 }
 #endif /* MODULE_GNRC_NETIF_DEDUP */
 
+static int _recv_copy(gnrc_netif_t *netif, gnrc_pktsnip_t **pkt,
+                      netdev_ieee802154_rx_info_t *rx_info)
+{
+    netdev_t *dev = netif->dev;
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    int nread;
+
+    if (bytes_expected < (int)IEEE802154_MIN_FRAME_LEN) {
+        if (bytes_expected > 0) {
+            DEBUG("_recv_ieee802154: received frame is too short\n");
+            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        }
+        return 0;
+    }
+    *pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (*pkt == NULL) {
+        DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
+        /* Discard packet on netdev device */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return -ENOMEM;
+    }
+    nread = dev->driver->recv(dev, (*pkt)->data, bytes_expected, rx_info);
+    if (nread <= 0) {
+        gnrc_pktbuf_release(*pkt);
+        *pkt = NULL;
+    }
+    return nread;
+}
+
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 {
     netdev_t *dev = netif->dev;
     netdev_ieee802154_rx_info_t rx_info;
     gnrc_pktsnip_t *pkt = NULL;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    int nread = -ENOBUFS;
 
-    if (bytes_expected >= (int)IEEE802154_MIN_FRAME_LEN) {
-        int nread;
+#if IS_USED(MODULE_NETDEV_RX_LOAN)
+    nread = gnrc_netif_recv_loaned(netif, &pkt, &rx_info);
+    if ((nread > 0) && (nread < (int)IEEE802154_MIN_FRAME_LEN)) {
+        DEBUG("_recv_ieee802154: received frame is too short\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+#endif
+    if (nread == -ENOBUFS) {
+        nread = _recv_copy(netif, &pkt, &rx_info);
+    }
 
-        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
-        if (pkt == NULL) {
-            DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
-            /* Discard packet on netdev device */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
-            return NULL;
-        }
-        nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
-        if (nread <= 0) {
-            gnrc_pktbuf_release(pkt);
-            return NULL;
-        }
+    if (nread > 0) {
 #ifdef MODULE_NETSTATS_L2
         netif->stats.rx_count++;
         netif->stats.rx_bytes += nread;
@@ -227,9 +257,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 
         DEBUG("_recv_ieee802154: reallocating MAC payload for upper layer.\n");
         gnrc_pktbuf_realloc_data(pkt, nread);
-    } else if (bytes_expected > 0) {
-        DEBUG("_recv_ieee802154: received frame is too short\n");
-        dev->driver->recv(dev, NULL, bytes_expected, NULL);
     }
 
     return pkt;
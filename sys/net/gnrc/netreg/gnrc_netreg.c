@@ -30,13 +30,22 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+/* The registry as lookup table by gnrc_nettype_t and hashed demux_ctx */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type,
+                                            uint32_t demux_ctx)
+{
+    /* ports and protocol numbers differ in their lowest bits, fold in the
+     * upper half so GNRC_NETREG_DEMUX_CTX_ALL does not share a bucket with 0 */
+    demux_ctx ^= demux_ctx >> 16;
+    return &netreg[type][demux_ctx & (GNRC_NETREG_BUCKETS - 1)];
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -61,7 +70,9 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    gnrc_netreg_entry_t **head = _bucket(type, entry->demux_ctx);
+
+    LL_PREPEND(*head, entry);
 
     return 0;
 }
@@ -72,7 +83,9 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    gnrc_netreg_entry_t **head = _bucket(type, entry->demux_ctx);
+
+    LL_DELETE(*head, entry);
 }
 
 /**
@@ -94,7 +107,8 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
+        gnrc_netreg_entry_t *head = (from) ? from->next
+                                           : *_bucket(type, demux_ctx);
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
 
@@ -106,14 +120,33 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
     return _netreg_lookup(NULL, type, demux_ctx);
 }
 
-int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
+gnrc_netreg_entry_t *gnrc_netreg_lookup_num(gnrc_nettype_t type,
+                                            uint32_t demux_ctx, int *num)
 {
-    int num = 0;
-    gnrc_netreg_entry_t *entry = NULL;
+    gnrc_netreg_entry_t *res = NULL;
 
-    while((entry = _netreg_lookup(entry, type, demux_ctx)) != NULL) {
-        num++;
+    assert(num != NULL);
+    *num = 0;
+    if (!_INVALID_TYPE(type)) {
+        gnrc_netreg_entry_t *entry;
+
+        LL_FOREACH(*_bucket(type, demux_ctx), entry) {
+            if (entry->demux_ctx == demux_ctx) {
+                if (res == NULL) {
+                    res = entry;
+                }
+                (*num)++;
+            }
+        }
     }
+    return res;
+}
+
+int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    int num;
+
+    gnrc_netreg_lookup_num(type, demux_ctx, &num);
     return num;
 }
 
@@ -44,6 +44,39 @@ static _nib_dr_entry_t _def_routers[CONFIG_GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static _nib_abr_entry_t _abrs[CONFIG_GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+/* a path-compressed binary trie needs at most one node per prefix and one
+ * branching node less than that */
+#define _TRIE_NUMOF     ((2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF) - 1)
+
+#if _TRIE_NUMOF < UINT8_MAX
+typedef uint8_t _trie_idx_t;
+#define _TRIE_NIL       (UINT8_MAX)
+#else
+typedef uint16_t _trie_idx_t;
+#define _TRIE_NIL       (UINT16_MAX)
+#endif
+
+typedef struct {
+    ipv6_addr_t pfx;            /* bits beyond pfx_len are undefined */
+    _trie_idx_t child[2];       /* indexed by the bit following the prefix */
+    _trie_idx_t dst;            /* first off-link entry with this prefix or
+                                 * _TRIE_NIL for branching nodes */
+    uint8_t pfx_len;
+} _trie_node_t;
+
+static _trie_node_t _trie[_TRIE_NUMOF];
+static _trie_idx_t _trie_root;
+static _trie_idx_t _trie_free;
+/* next off-link entry with the same prefix, in ascending order of index */
+static _trie_idx_t _trie_next_dst[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+
+static void _trie_init(void);
+static void _trie_add(const _nib_offl_entry_t *dst);
+static void _trie_del(const _nib_offl_entry_t *dst);
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
+
 static rmutex_t _nib_mutex = RMUTEX_INIT;
 
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
@@ -66,6 +99,9 @@ void _nib_init(void)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+    _trie_init();
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -514,6 +550,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+        _trie_add(dst);
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
     }
     return dst;
 }
@@ -523,12 +562,12 @@ static inline bool _in_dsts(const _nib_offl_entry_t *dst)
     return (dst < (_dsts + CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF));
 }
 
-#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static inline unsigned _idx_dsts(const _nib_offl_entry_t *dst)
 {
     return (dst - _dsts);
 }
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static inline bool _in_abrs(const _nib_abr_entry_t *abr)
 {
     return (abr < (_abrs + CONFIG_GNRC_IPV6_NIB_ABR_NUMOF));
@@ -550,6 +589,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+        _trie_del(dst);
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -573,10 +615,167 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+static void _trie_init(void)
+{
+    for (unsigned i = 0; i < _TRIE_NUMOF; i++) {
+        _trie[i].child[0] = i + 1;
+    }
+    _trie[_TRIE_NUMOF - 1].child[0] = _TRIE_NIL;
+    _trie_free = 0;
+    _trie_root = _TRIE_NIL;
+}
+
+static inline unsigned _trie_bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return bf_isset((uint8_t *)addr->u8, pos) ? 1 : 0;
+}
+
+static _trie_idx_t _trie_node_alloc(const ipv6_addr_t *pfx, unsigned pfx_len,
+                                    _trie_idx_t dst)
+{
+    _trie_idx_t idx = _trie_free;
+
+    /* can't run out: every branching node has two children */
+    assert(idx != _TRIE_NIL);
+    _trie_node_t *node = &_trie[idx];
+    _trie_free = node->child[0];
+    memcpy(&node->pfx, pfx, sizeof(node->pfx));
+    node->pfx_len = pfx_len;
+    node->child[0] = _TRIE_NIL;
+    node->child[1] = _TRIE_NIL;
+    node->dst = dst;
+    if (dst != _TRIE_NIL) {
+        _trie_next_dst[dst] = _TRIE_NIL;
+    }
+    return idx;
+}
+
+static void _trie_node_free(_trie_idx_t idx)
+{
+    _trie[idx].child[0] = _trie_free;
+    _trie_free = idx;
+}
+
+static void _trie_add(const _nib_offl_entry_t *dst)
+{
+    const _trie_idx_t idx = _idx_dsts(dst);
+    _trie_idx_t *ptr = &_trie_root;
+
+    while (*ptr != _TRIE_NIL) {
+        _trie_node_t *node = &_trie[*ptr];
+        unsigned match = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+
+        if ((match < node->pfx_len) || (dst->pfx_len < node->pfx_len)) {
+            /* prefix diverges from node => insert new node above */
+            unsigned len = (match < dst->pfx_len) ? match : dst->pfx_len;
+            _trie_idx_t sub = *ptr;
+            _trie_idx_t top;
+
+            if (len == dst->pfx_len) {
+                top = _trie_node_alloc(&dst->pfx, len, idx);
+            }
+            else {
+                _trie_idx_t leaf = _trie_node_alloc(&dst->pfx, dst->pfx_len,
+                                                    idx);
+
+                top = _trie_node_alloc(&dst->pfx, len, _TRIE_NIL);
+                _trie[top].child[_trie_bit(&dst->pfx, len)] = leaf;
+            }
+            _trie[top].child[_trie_bit(&node->pfx, len)] = sub;
+            *ptr = top;
+            return;
+        }
+        if (node->pfx_len == dst->pfx_len) {
+            /* keep entries of equal prefixes in order of the _dsts array so
+             * the first one matches, as with the linear search */
+            _trie_idx_t *next = &node->dst;
+
+            while ((*next != _TRIE_NIL) && (*next < idx)) {
+                next = &_trie_next_dst[*next];
+            }
+            _trie_next_dst[idx] = *next;
+            *next = idx;
+            return;
+        }
+        ptr = &node->child[_trie_bit(&dst->pfx, node->pfx_len)];
+    }
+    *ptr = _trie_node_alloc(&dst->pfx, dst->pfx_len, idx);
+}
+
+static void _trie_del(const _nib_offl_entry_t *dst)
+{
+    const _trie_idx_t idx = _idx_dsts(dst);
+    _trie_idx_t *parent = NULL;
+    _trie_idx_t *ptr = &_trie_root;
+
+    while ((*ptr != _TRIE_NIL) && (_trie[*ptr].pfx_len < dst->pfx_len)) {
+        parent = ptr;
+        ptr = &_trie[*ptr].child[_trie_bit(&dst->pfx, _trie[*ptr].pfx_len)];
+    }
+    assert(*ptr != _TRIE_NIL);
+
+    _trie_idx_t node = *ptr;
+    _trie_idx_t *next = &_trie[node].dst;
+
+    while (*next != idx) {
+        assert(*next != _TRIE_NIL);
+        next = &_trie_next_dst[*next];
+    }
+    *next = _trie_next_dst[idx];
+    if ((_trie[node].dst != _TRIE_NIL) ||
+        ((_trie[node].child[0] != _TRIE_NIL) &&
+         (_trie[node].child[1] != _TRIE_NIL))) {
+        /* node still holds a prefix or is needed for branching */
+        return;
+    }
+    *ptr = (_trie[node].child[0] != _TRIE_NIL) ? _trie[node].child[0]
+                                                : _trie[node].child[1];
+    _trie_node_free(node);
+    if ((*ptr == _TRIE_NIL) && (parent != NULL) &&
+        (_trie[*parent].dst == _TRIE_NIL)) {
+        /* parent branching node has only one child left => remove it */
+        node = *parent;
+        *parent = (_trie[node].child[0] != _TRIE_NIL) ? _trie[node].child[0]
+                                                      : _trie[node].child[1];
+        _trie_node_free(node);
+    }
+}
+
+static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    _trie_idx_t idx = _trie_root;
+
+    DEBUG("nib: get match for destination %s from NIB trie\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    while (idx != _TRIE_NIL) {
+        const _trie_node_t *node = &_trie[idx];
+
+        if (ipv6_addr_match_prefix(&node->pfx, dst) < node->pfx_len) {
+            break;
+        }
+        for (_trie_idx_t i = node->dst; i != _TRIE_NIL; i = _trie_next_dst[i]) {
+            if (_dsts[i].mode != _EMPTY) {
+                DEBUG("nib: best match so far %s/%u\n",
+                      ipv6_addr_to_str(addr_str, &node->pfx, sizeof(addr_str)),
+                      node->pfx_len);
+                res = &_dsts[i];
+                break;
+            }
+        }
+        if (node->pfx_len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        idx = node->child[_trie_bit(dst, node->pfx_len)];
+    }
+    return res;
+}
+#else   /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
-    uint8_t best_match = 0;
+    uint8_t best_len = 0;
 
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
@@ -592,15 +791,16 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
                   ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
                                    sizeof(addr_str)),
                   _nib_onl_get_if(entry->next_hop), match);
-            if ((match > best_match) && (match >= entry->pfx_len)) {
-                DEBUG("nib: best match (%u bits)\n", match);
+            if ((entry->pfx_len > best_len) && (match >= entry->pfx_len)) {
+                DEBUG("nib: best match (%u bits)\n", entry->pfx_len);
                 res = entry;
-                best_match = match;
+                best_len = entry->pfx_len;
             }
         }
     }
     return res;
 }
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
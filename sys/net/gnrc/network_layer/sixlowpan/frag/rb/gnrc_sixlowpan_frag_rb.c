@@ -32,7 +32,6 @@
 #include "net/sixlowpan/sfr.h"
 #include "thread.h"
 #include "xtimer.h"
-#include "utlist.h"
 
 #include "net/gnrc/sixlowpan/frag/rb.h"
 
@@ -63,6 +62,22 @@ static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
+#ifndef RBUF_BUCKETS
+#define RBUF_BUCKETS    (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+#endif
+
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE >= UINT8_MAX
+#error "CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE too large for rbuf index"
+#endif
+
+/* Hash index over (src, dst, tag) of the reassembly buffer. All values are
+ * rbuf indexes + 1, 0 marks the end of a bucket. Removed entries stay in
+ * their bucket until they are reused, the lookup skips them. */
+static uint8_t _rbuf_heads[RBUF_BUCKETS];
+static uint8_t _rbuf_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* bucket + 1 an entry is in, 0 if it is in none */
+static uint8_t _rbuf_bucket[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -91,6 +106,12 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
 
+/* bucket of a datagram in the hash index */
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len, uint16_t tag);
+/* adds a newly created entry to the hash index */
+static void _rbuf_index(gnrc_sixlowpan_frag_rb_t *entry);
+
 /* status codes for _rbuf_add() */
 enum {
     RBUF_ADD_SUCCESS = 0,
@@ -117,8 +138,11 @@ static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     *
+     * The intervals are sorted by their start, so no interval after one
+     * starting behind the fragment can overlap it */
+    while ((ptr != NULL) && (ptr->start < (offset + frag_size))) {
         if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
 
             /* "A fresh reassembly may be commenced with the most recently
@@ -188,9 +212,10 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
     const uint8_t src_len = netif_hdr->src_l2addr_len;
     const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    unsigned bucket = _rbuf_hash(src, src_len, dst, dst_len, tag);
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+    for (unsigned i = _rbuf_heads[bucket]; i > 0; i = _rbuf_next[i - 1]) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
 
         if ((e->pkt != NULL) && (e->super.tag == tag) &&
             (e->super.src_len == src_len) &&
@@ -203,6 +228,43 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     return NULL;
 }
 
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len, uint16_t tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U ^ tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash ^ src[i]) * 16777619U;
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash ^ dst[i]) * 16777619U;
+    }
+    return hash % RBUF_BUCKETS;
+}
+
+static void _rbuf_index(gnrc_sixlowpan_frag_rb_t *entry)
+{
+    unsigned idx = entry - rbuf;
+    unsigned bucket = _rbuf_hash(entry->super.src, entry->super.src_len,
+                                 entry->super.dst, entry->super.dst_len,
+                                 entry->super.tag);
+
+    if (_rbuf_bucket[idx] > 0) {
+        /* unlink from the bucket of the datagram the entry was used for
+         * before */
+        uint8_t *ptr = &_rbuf_heads[_rbuf_bucket[idx] - 1];
+
+        while (*ptr != (idx + 1)) {
+            ptr = &_rbuf_next[*ptr - 1];
+        }
+        *ptr = _rbuf_next[idx];
+    }
+    _rbuf_next[idx] = _rbuf_heads[bucket];
+    _rbuf_heads[bucket] = idx + 1;
+    _rbuf_bucket[idx] = bucket + 1;
+}
+
 #ifndef NDEBUG
 static bool _valid_offset(gnrc_pktsnip_t *pkt, size_t offset)
 {
@@ -327,7 +389,6 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return RBUF_ADD_ERROR;
     }
 
-    gnrc_sixlowpan_frag_rb_gc();
     /* only check VRB for subsequent frags, first frags create and not get VRB
      * entries below */
     if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD) &&
@@ -536,7 +597,14 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
+    /* keep intervals sorted by their start for _check_fragments() */
+    gnrc_sixlowpan_frag_rb_int_t **ptr = &entry->ints;
+
+    while ((*ptr != NULL) && ((*ptr)->start < new->start)) {
+        ptr = &(*ptr)->next;
+    }
+    new->next = *ptr;
+    *ptr = new;
 
     return true;
 }
@@ -595,45 +663,60 @@ static int _rbuf_get(const void *src, size_t src_len,
 {
     gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
+    unsigned bucket = _rbuf_hash(src, src_len, dst, dst_len, tag);
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.tag == tag) &&
+    /* check first if entry already available */
+    for (unsigned i = _rbuf_heads[bucket]; i > 0; i = _rbuf_next[i - 1]) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
+
+        if ((e->pkt != NULL) && (e->super.tag == tag) &&
             ((IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
               /* not all SFR fragments carry the datagram size, so make 0 a
                * legal value to not compare datagram size */
-              ((size == 0) || (rbuf[i].super.datagram_size == size))) ||
+              ((size == 0) || (e->super.datagram_size == size))) ||
              (!IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
-              (rbuf[i].super.datagram_size == size))) &&
-            (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+              (e->super.datagram_size == size))) &&
+            (e->super.src_len == src_len) &&
+            (e->super.dst_len == dst_len) &&
+            (memcmp(e->super.src, src, src_len) == 0) &&
+            (memcmp(e->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)e,
+                  gnrc_netif_addr_to_str(e->super.src, e->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(e->super.dst, e->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+                  (unsigned)e->super.datagram_size, e->super.tag);
+            if ((now_usec - e->super.arrival) >
+                CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US) {
+                /* garbage collection did not get to it yet */
+                DEBUG("6lo rfrag: entry timed out, starting fresh\n");
+                _gc_pkt(e);
+                gnrc_sixlowpan_frag_rb_remove(e);
+                break;
+            }
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
+            if (e->super.current_size == 0) {
                 /* ensure that only empty reassembly buffer entries and entries
                  * scheduled for deletion have `current_size == 0` */
                 DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
                 return -1;
             }
 #endif
-            rbuf[i].super.arrival = now_usec;
+            e->super.arrival = now_usec;
             _set_rbuf_timeout();
-            return i;
+            return i - 1;
         }
+    }
 
+    /* since pkt occupies pktbuf, aggressivly collect garbage before creating
+     * a new entry */
+    gnrc_sixlowpan_frag_rb_gc();
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
-        if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+        if (gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
+            break;
         }
 
         /* remember oldest slot */
@@ -718,6 +801,7 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_index(res);
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
     res->offset_diff = 0U;
     memset(res->received, 0U, sizeof(res->received));
@@ -741,6 +825,8 @@ void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
     memset(rbuf_int, 0, sizeof(rbuf_int));
+    memset(_rbuf_heads, 0, sizeof(_rbuf_heads));
+    memset(_rbuf_bucket, 0, sizeof(_rbuf_bucket));
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
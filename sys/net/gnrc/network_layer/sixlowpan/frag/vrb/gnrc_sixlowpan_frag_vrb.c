@@ -30,7 +30,22 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#ifndef VRB_BUCKETS
+#define VRB_BUCKETS     (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE)
+#endif
+
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE >= UINT8_MAX
+#error "CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE too large for VRB index"
+#endif
+
 static gnrc_sixlowpan_frag_vrb_t _vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+/* Hash index over (src, tag) of the VRB. All values are VRB indexes + 1, 0
+ * marks the end of a bucket. Removed entries stay in their bucket until they
+ * are reused, the lookup skips them. */
+static uint8_t _vrb_heads[VRB_BUCKETS];
+static uint8_t _vrb_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+/* bucket + 1 an entry is in, 0 if it is in none */
+static uint8_t _vrb_bucket[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
 #ifdef MODULE_GNRC_IPV6_NIB
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #else   /* MODULE_GNRC_IPV6_NIB */
@@ -46,6 +61,70 @@ static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
             (memcmp(vrbe->super.src, src, src_len) == 0));
 }
 
+static unsigned _hash(const uint8_t *src, size_t src_len, unsigned tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U ^ tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash ^ src[i]) * 16777619U;
+    }
+    return hash % VRB_BUCKETS;
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_lookup(const uint8_t *src, size_t src_len,
+                                          unsigned tag)
+{
+    unsigned bucket = _hash(src, src_len, tag);
+
+    for (unsigned i = _vrb_heads[bucket]; i > 0; i = _vrb_next[i - 1]) {
+        if (_equal_index(&_vrb[i - 1], src, src_len, tag)) {
+            return &_vrb[i - 1];
+        }
+    }
+    return NULL;
+}
+
+/* adds a newly created entry to the hash index */
+static void _index(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    unsigned idx = vrbe - _vrb;
+    unsigned bucket = _hash(vrbe->super.src, vrbe->super.src_len,
+                            vrbe->super.tag);
+
+    if (_vrb_bucket[idx] > 0) {
+        /* unlink from the bucket of the datagram the entry was used for
+         * before */
+        uint8_t *ptr = &_vrb_heads[_vrb_bucket[idx] - 1];
+
+        while (*ptr != (idx + 1)) {
+            ptr = &_vrb_next[*ptr - 1];
+        }
+        *ptr = _vrb_next[idx];
+    }
+    _vrb_next[idx] = _vrb_heads[bucket];
+    _vrb_heads[bucket] = idx + 1;
+    _vrb_bucket[idx] = bucket + 1;
+}
+
+/* merges the intervals of `ints` into the intervals of `vrbe`, keeping them
+ * sorted by their start */
+static void _merge_ints(gnrc_sixlowpan_frag_vrb_t *vrbe,
+                        gnrc_sixlowpan_frag_rb_int_t *ints)
+{
+    gnrc_sixlowpan_frag_rb_int_t **ptr = &vrbe->super.ints;
+
+    while (ints != NULL) {
+        gnrc_sixlowpan_frag_rb_int_t *next = ints->next;
+
+        while ((*ptr != NULL) && ((*ptr)->start < ints->start)) {
+            ptr = &(*ptr)->next;
+        }
+        ints->next = *ptr;
+        *ptr = ints;
+        ints = next;
+    }
+}
 
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
@@ -57,59 +136,49 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
     assert(out_netif != NULL);
     assert(out_dst != NULL);
     assert(out_dst_len > 0);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[i];
-
-        if (gnrc_sixlowpan_frag_vrb_entry_empty(ptr) ||
-            _equal_index(ptr, base->src, base->src_len, base->tag)) {
-            vrbe = ptr;
-            if (gnrc_sixlowpan_frag_vrb_entry_empty(vrbe)) {
-                vrbe->super = *base;
-                vrbe->out_netif = out_netif;
-                memcpy(vrbe->super.dst, out_dst, out_dst_len);
-                vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
-                vrbe->super.dst_len = out_dst_len;
-                DEBUG("6lo vrb: creating entry (%s, ",
-                      gnrc_netif_addr_to_str(vrbe->super.src,
-                                             vrbe->super.src_len,
-                                             addr_str));
-                DEBUG("%s, %u, %u) => ",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str),
-                      (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
-                DEBUG("(%s, %u)\n",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str), vrbe->out_tag);
+    vrbe = _lookup(base->src, base->src_len, base->tag);
+    if (vrbe != NULL) {
+        /* _equal_index() => merge intervals of `base`, so they don't get
+         * lost. */
+        if ((base->ints != NULL) && (vrbe->super.ints != base->ints)) {
+            gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
+
+            /* check if `base->ints` is not already part of list */
+            while ((tmp != NULL) && (tmp != base->ints)) {
+                tmp = tmp->next;
             }
-            /* _equal_index() => append intervals of `base`, so they don't get
-             * lost. We use append, so we don't need to change base! */
-            else if (base->ints != NULL) {
-                gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
-
-                if (tmp != base->ints) {
-                    /* base->ints is not already vrbe->super.ints */
-                    if (tmp != NULL) {
-                        /* iterate before appending and check if `base->ints` is
-                         * not already part of list */
-                        while (tmp->next != NULL) {
-                            if (tmp == base->ints) {
-                                tmp = NULL;
-                                break;
-                            }
-                            tmp = tmp->next;
-                        }
-                        if (tmp != NULL) {
-                            tmp->next = base->ints;
-                        }
-                    }
-                    else {
-                        vrbe->super.ints = base->ints;
-                    }
-                }
+            if (tmp == NULL) {
+                _merge_ints(vrbe, base->ints);
             }
-            break;
+        }
+    }
+    else {
+        for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+            if (gnrc_sixlowpan_frag_vrb_entry_empty(&_vrb[i])) {
+                vrbe = &_vrb[i];
+                break;
+            }
+        }
+        if (vrbe != NULL) {
+            vrbe->super = *base;
+            vrbe->out_netif = out_netif;
+            memcpy(vrbe->super.dst, out_dst, out_dst_len);
+            vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
+            vrbe->super.dst_len = out_dst_len;
+            _index(vrbe);
+            DEBUG("6lo vrb: creating entry (%s, ",
+                  gnrc_netif_addr_to_str(vrbe->super.src,
+                                         vrbe->super.src_len,
+                                         addr_str));
+            DEBUG("%s, %u, %u) => ",
+                  gnrc_netif_addr_to_str(vrbe->super.dst,
+                                         vrbe->super.dst_len,
+                                         addr_str),
+                  (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
+            DEBUG("(%s, %u)\n",
+                  gnrc_netif_addr_to_str(vrbe->super.dst,
+                                         vrbe->super.dst_len,
+                                         addr_str), vrbe->out_tag);
         }
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
@@ -169,16 +238,22 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
 {
     DEBUG("6lo vrb: trying to get entry for (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), src_tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _lookup(src, src_len, src_tag);
 
-        if (_equal_index(vrbe, src, src_len, src_tag)) {
-            DEBUG("6lo vrb: got VRB to (%s, %u)\n",
-                  gnrc_netif_addr_to_str(vrbe->super.dst,
-                                         vrbe->super.dst_len,
-                                         addr_str), vrbe->out_tag);
-            return vrbe;
-        }
+    if ((vrbe != NULL) &&
+        ((xtimer_now_usec() - vrbe->super.arrival) >
+         CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US)) {
+        /* garbage collection did not get to it yet */
+        DEBUG("6lo vrb: entry timed out\n");
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        vrbe = NULL;
+    }
+    if (vrbe != NULL) {
+        DEBUG("6lo vrb: got VRB to (%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+        return vrbe;
     }
     DEBUG("6lo vrb: no entry found\n");
     return NULL;
@@ -232,6 +307,8 @@ void gnrc_sixlowpan_frag_vrb_gc(void)
 void gnrc_sixlowpan_frag_vrb_reset(void)
 {
     memset(_vrb, 0, sizeof(_vrb));
+    memset(_vrb_heads, 0, sizeof(_vrb_heads));
+    memset(_vrb_bucket, 0, sizeof(_vrb_bucket));
 }
 #endif
 
@@ -405,7 +405,12 @@ static void *_event_loop(void *args)
     /* start event loop */
     while (1) {
         DEBUG("6lo: waiting for incoming message.\n");
+        if (msg_avail() == 0) {
+            /* wake up the receivers of the packets handled so far */
+            gnrc_netapi_batch_flush();
+        }
         msg_receive(&msg);
+        gnrc_netapi_batch_start();
 
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
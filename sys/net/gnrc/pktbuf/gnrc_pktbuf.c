@@ -13,6 +13,8 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <assert.h>
+
 #include "mutex.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/tx_sync.h"
@@ -24,6 +26,92 @@
 
 mutex_t gnrc_pktbuf_mutex = MUTEX_INIT;
 
+#if IS_USED(MODULE_GNRC_PKTBUF_LOAN)
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    gnrc_pktbuf_loan_cb_t cb;
+    void *ctx;
+    unsigned refs;          /**< number of snips referring to data, 0 if free */
+} _loan_t;
+
+static _loan_t _loans[CONFIG_GNRC_PKTBUF_LOAN_NUMOF];
+
+static _loan_t *_loan_find(const void *data)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTBUF_LOAN_NUMOF; i++) {
+        _loan_t *loan = &_loans[i];
+
+        if ((loan->refs > 0) &&
+            ((size_t)((const uint8_t *)data - loan->data) < loan->size)) {
+            return loan;
+        }
+    }
+    return NULL;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_loaned(gnrc_pktsnip_t *next, void *data,
+                                       size_t size, gnrc_nettype_t type,
+                                       gnrc_pktbuf_loan_cb_t cb, void *ctx)
+{
+    assert((data != NULL) && (size > 0));
+    /* only the snip descriptor is allocated */
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(next, NULL, 0, type);
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    mutex_lock(&gnrc_pktbuf_mutex);
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTBUF_LOAN_NUMOF; i++) {
+        _loan_t *loan = &_loans[i];
+
+        if (loan->refs == 0) {
+            *loan = (_loan_t){ .data = data, .size = size, .cb = cb,
+                               .ctx = ctx, .refs = 1 };
+            pkt->data = data;
+            pkt->size = size;
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return pkt;
+        }
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    DEBUG("pktbuf: no loan slot left for %p\n", data);
+    pkt->next = NULL;
+    gnrc_pktbuf_release(pkt);
+    return NULL;
+}
+
+bool gnrc_pktbuf_loan_hold(const void *data)
+{
+    _loan_t *loan = _loan_find(data);
+
+    if (loan == NULL) {
+        return false;
+    }
+    loan->refs++;
+    return true;
+}
+
+bool gnrc_pktbuf_loan_release(const void *data)
+{
+    _loan_t *loan = _loan_find(data);
+
+    if (loan == NULL) {
+        return false;
+    }
+    if (--loan->refs == 0) {
+        DEBUG("pktbuf: returning loaned %p\n", (void *)loan->data);
+        loan->cb(loan->ctx, loan->data);
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_loaned(const void *data)
+{
+    return _loan_find(data) != NULL;
+}
+#endif
+
 gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt,
                                         gnrc_pktsnip_t *snip)
 {
@@ -97,7 +185,7 @@ void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
             pkt->users = 0; /* not necessary but to be on the safe side */
             if (!IS_USED(MODULE_GNRC_TX_SYNC)
                 || (pkt->type != GNRC_NETTYPE_TX_SYNC)) {
-                gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+                gnrc_pktbuf_free_data(pkt->data, pkt->size);
             }
             else {
                 gnrc_tx_complete(pkt);
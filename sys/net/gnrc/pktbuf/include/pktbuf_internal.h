@@ -50,6 +50,10 @@ extern mutex_t gnrc_pktbuf_mutex;
 extern uint8_t *gnrc_pktbuf_static_buf;
 #endif
 
+#if IS_USED(MODULE_GNRC_PKTBUF_SLAB)
+#include "pktbuf_slab.h"
+#endif
+
 /**
  * @brief   Check if the given pointer is indeed part of the packet buffer
  *
@@ -65,6 +69,8 @@ static inline bool gnrc_pktbuf_contains(void *ptr)
 {
 #if IS_USED(MODULE_GNRC_PKTBUF_STATIC)
     return (unsigned)((uint8_t *)ptr - gnrc_pktbuf_static_buf) < CONFIG_GNRC_PKTBUF_SIZE;
+#elif IS_USED(MODULE_GNRC_PKTBUF_SLAB)
+    return (size_t)((uint8_t *)ptr - gnrc_pktbuf_slab_buf) < GNRC_PKTBUF_SLAB_SIZE;
 #else
     (void)ptr;
     return true;
@@ -82,6 +88,77 @@ static inline bool gnrc_pktbuf_contains(void *ptr)
  */
 void gnrc_pktbuf_free_internal(void *data, size_t size);
 
+#if IS_USED(MODULE_GNRC_PKTBUF_LOAN) || defined(DOXYGEN)
+/**
+ * @brief   Adds a reference to loaned data
+ *
+ * @warning This function is ***internal***.
+ *
+ * @param   data    pointer into the data of a snip
+ *
+ * @retval  true    @p data is loaned and now referenced once more
+ * @retval  false   @p data is not loaned
+ */
+bool gnrc_pktbuf_loan_hold(const void *data);
+
+/**
+ * @brief   Drops a reference to loaned data, returns it to its owner when
+ *          it was the last one
+ *
+ * @warning This function is ***internal***.
+ *
+ * @param   data    pointer into the data of a snip
+ *
+ * @retval  true    @p data is loaned and the reference was dropped
+ * @retval  false   @p data is not loaned
+ */
+bool gnrc_pktbuf_loan_release(const void *data);
+
+/**
+ * @brief   Checks if data is loaned
+ *
+ * @warning This function is ***internal***.
+ *
+ * @param   data    pointer into the data of a snip
+ *
+ * @return  true, if @p data is loaned
+ */
+bool gnrc_pktbuf_loaned(const void *data);
+#else
+static inline bool gnrc_pktbuf_loan_hold(const void *data)
+{
+    (void)data;
+    return false;
+}
+
+static inline bool gnrc_pktbuf_loan_release(const void *data)
+{
+    (void)data;
+    return false;
+}
+
+static inline bool gnrc_pktbuf_loaned(const void *data)
+{
+    (void)data;
+    return false;
+}
+#endif
+
+/**
+ * @brief   Releases the data of a snip, whether loaned or internal
+ *
+ * @warning This function is ***internal***.
+ *
+ * @param   data    data of the snip
+ * @param   size    size of @p data in bytes
+ */
+static inline void gnrc_pktbuf_free_data(void *data, size_t size)
+{
+    if (!gnrc_pktbuf_loan_release(data)) {
+        gnrc_pktbuf_free_internal(data, size);
+    }
+}
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
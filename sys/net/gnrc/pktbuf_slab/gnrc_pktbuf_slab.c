@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Size-class slab implementation of the packet buffer
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#include "pktbuf_internal.h"
+#include "pktbuf_slab.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define SLAB_SNIP       (0U)    /**< class of the packet snip descriptors */
+#define SLAB_DATA       (1U)    /**< first class used for packet data */
+
+/**
+ * @brief   Marks a free chunk of a class
+ */
+typedef struct _slab_free {
+    struct _slab_free *next;    /**< next free chunk of the same class */
+} _slab_free_t;
+
+/**
+ * @brief   State of a size class
+ */
+typedef struct {
+    _slab_free_t *free;         /**< list of free chunks */
+    uint8_t *start;             /**< first chunk of the class */
+    uint8_t *refs;              /**< reference counters of the chunks */
+    uint16_t size;              /**< size of each chunk */
+    uint16_t numof;             /**< number of chunks */
+    uint16_t used;              /**< number of chunks in use */
+#ifdef DEVELHELP
+    uint16_t max_used;          /**< maximum number of chunks in use */
+#endif
+} _slab_t;
+
+static const uint16_t _sizes[GNRC_PKTBUF_SLAB_CLASS_NUMOF] = {
+    GNRC_PKTBUF_SLAB_ROUND(sizeof(gnrc_pktsnip_t)),
+    GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE),
+    GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE),
+    GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE),
+    GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE),
+};
+
+static const uint16_t _numofs[GNRC_PKTBUF_SLAB_CLASS_NUMOF] = {
+    CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF,
+    CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF,
+    CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF,
+    CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF,
+    CONFIG_GNRC_PKTBUF_SLAB_MTU_NUMOF,
+};
+
+/* The arena needs to be aligned to GNRC_PKTBUF_SLAB_ALIGN, so that every chunk
+ * can be casted to `_slab_free_t *` safely and 64 bit header fields are
+ * accessible. Just allocating an array of uint64_t is a trivial way to do
+ * this */
+static uint64_t _pktbuf_buf[GNRC_PKTBUF_SLAB_SIZE / sizeof(uint64_t)];
+uint8_t *gnrc_pktbuf_slab_buf = (uint8_t *)_pktbuf_buf;
+static uint8_t _refs[GNRC_PKTBUF_SLAB_CHUNK_NUMOF];
+static _slab_t _slabs[GNRC_PKTBUF_SLAB_CLASS_NUMOF];
+
+#ifdef DEVELHELP
+/* number of allocations that failed for lack of a free chunk */
+static unsigned _alloc_fails = 0;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_slab_alloc(_slab_t *slab);
+static void *_pktbuf_alloc(unsigned first, size_t size);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline uint8_t *_slab_end(const _slab_t *slab)
+{
+    return slab->start + ((size_t)slab->size * slab->numof);
+}
+
+/* returns the class @p ptr lies in and stores the chunk index in @p idx */
+static _slab_t *_slab_find(const void *ptr, unsigned *idx)
+{
+    const uint8_t *p = ptr;
+
+    if (p < _slabs[0].start) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        if (p < _slab_end(slab)) {
+            *idx = (p - slab->start) / slab->size;
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+static inline uint8_t *_chunk(const _slab_t *slab, unsigned idx)
+{
+    return slab->start + ((size_t)idx * slab->size);
+}
+
+void gnrc_pktbuf_init(void)
+{
+    uint8_t *start = gnrc_pktbuf_slab_buf;
+    uint8_t *refs = _refs;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        slab->start = start;
+        slab->refs = refs;
+        slab->size = _sizes[i];
+        slab->numof = _numofs[i];
+        slab->used = 0;
+#ifdef DEVELHELP
+        slab->max_used = 0;
+#endif
+        slab->free = NULL;
+        /* build the free list back to front, so chunks are handed out in
+         * ascending order */
+        for (unsigned j = slab->numof; j > 0; j--) {
+            /* chunk sizes are multiples of GNRC_PKTBUF_SLAB_ALIGN. We cast to
+             * uintptr_t as intermediate step to silence -Wcast-align */
+            _slab_free_t *chunk = (_slab_free_t *)(uintptr_t)_chunk(slab, j - 1);
+            chunk->next = slab->free;
+            slab->free = chunk;
+            refs[j - 1] = 0;
+        }
+        start = _slab_end(slab);
+        refs += slab->numof;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE) {
+        DEBUG("pktbuf: size (%u) > CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE (%u)\n",
+              (unsigned)size, CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE);
+        return NULL;
+    }
+    mutex_lock(&gnrc_pktbuf_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(SLAB_SNIP, sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    new_data_marked = pkt->data;
+    if (pkt->size != size) {
+        /* both snips share the chunk or the loaned data from now on */
+        unsigned idx;
+        _slab_t *slab = _slab_find(pkt->data, &idx);
+
+        if (slab == NULL) {
+            bool loaned = gnrc_pktbuf_loan_hold(pkt->data);
+
+            assert(loaned);
+            (void)loaned;
+        }
+        else if (slab->refs[idx] == UINT8_MAX) {
+            DEBUG("pktbuf: chunk %p is referenced too often\n", pkt->data);
+            gnrc_pktbuf_free_internal(marked_snip, sizeof(gnrc_pktsnip_t));
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return NULL;
+        }
+        else {
+            slab->refs[idx]++;
+        }
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    void *new_data;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            (gnrc_pktbuf_contains(pkt->data) || gnrc_pktbuf_loaned(pkt->data))));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        gnrc_pktbuf_free_data(pkt->data, pkt->size);
+        pkt->data = NULL;
+        pkt->size = 0;
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return 0;
+    }
+    if ((size < pkt->size) && gnrc_pktbuf_loaned(pkt->data)) {
+        /* loaned data shrinks in place */
+        pkt->size = size;
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return 0;
+    }
+    if (size < pkt->size) {
+        unsigned idx;
+        _slab_t *slab = _slab_find(pkt->data, &idx);
+
+        /* shrinking in place is always possible, but if this snip is the sole
+         * user of the chunk, try to move its data to a smaller class to make
+         * the chunk available again */
+        new_data = NULL;
+        if (slab->refs[idx] == 1) {
+            for (_slab_t *s = &_slabs[SLAB_DATA]; !new_data && (s < slab); s++) {
+                if (size <= s->size) {
+                    new_data = _slab_alloc(s);
+                }
+            }
+        }
+        if (new_data == NULL) {
+            pkt->size = size;
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return 0;
+        }
+    }
+    else if ((pkt->data != NULL) && !gnrc_pktbuf_loaned(pkt->data)) {
+        unsigned idx;
+        _slab_t *slab = _slab_find(pkt->data, &idx);
+        size_t avail = _chunk(slab, idx + 1) - (uint8_t *)pkt->data;
+
+        if ((size <= avail) && (slab->refs[idx] == 1)) {
+            /* nobody else uses the remainder of the chunk */
+            pkt->size = size;
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return 0;
+        }
+        new_data = _pktbuf_alloc(SLAB_DATA, size);
+    }
+    else {
+        new_data = _pktbuf_alloc(SLAB_DATA, size);
+    }
+    if (new_data == NULL) {
+        DEBUG("pktbuf: error allocating new data section\n");
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return ENOMEM;
+    }
+    if (pkt->data != NULL) {            /* if old data exist */
+        memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        gnrc_pktbuf_free_data(pkt->data, pkt->size);
+    }
+    pkt->data = new_data;
+    pkt->size = size;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return new;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&gnrc_pktbuf_slab_buf[0],
+           (void *)&gnrc_pktbuf_slab_buf[GNRC_PKTBUF_SLAB_SIZE],
+           (unsigned)GNRC_PKTBUF_SLAB_SIZE);
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+
+        printf("  class %u: %4u B x %3u, used: %3u, max. used: %3u\n",
+               i, slab->size, slab->numof, slab->used, slab->max_used);
+    }
+    printf("  failed allocations: %u\n", _alloc_fails);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall chunks in the free list of a class: the chunk is at a chunk
+     *    boundary within the class and its reference counter is 0
+     *  - the length of the free list of a class is (numof - used)
+     *  - the number of chunks with a reference counter > 0 is used
+     */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+        unsigned free = 0, referenced = 0;
+
+        for (_slab_free_t *ptr = slab->free; ptr; ptr = ptr->next) {
+            uint8_t *p = (uint8_t *)ptr;
+            if ((p < slab->start) || (p >= _slab_end(slab)) ||
+                (((p - slab->start) % slab->size) != 0) ||
+                (slab->refs[(p - slab->start) / slab->size] != 0)) {
+                return false;
+            }
+            if (++free > slab->numof) {
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < slab->numof; j++) {
+            if (slab->refs[j] > 0) {
+                referenced++;
+            }
+        }
+        if ((free != (unsigned)(slab->numof - slab->used)) ||
+            (referenced != slab->used)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(SLAB_SNIP, sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(SLAB_DATA, size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            gnrc_pktbuf_free_internal(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_slab_alloc(_slab_t *slab)
+{
+    _slab_free_t *chunk = slab->free;
+
+    if (chunk == NULL) {
+        return NULL;
+    }
+    slab->free = chunk->next;
+    slab->refs[((uint8_t *)chunk - slab->start) / slab->size] = 1;
+    slab->used++;
+#ifdef DEVELHELP
+    if (slab->used > slab->max_used) {
+        slab->max_used = slab->used;
+    }
+#endif
+    return chunk;
+}
+
+static void *_pktbuf_alloc(unsigned first, size_t size)
+{
+    /* take a chunk from the smallest class with a free chunk that fits */
+    for (unsigned i = first; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        if (size <= _slabs[i].size) {
+            void *chunk = _slab_alloc(&_slabs[i]);
+            if (chunk != NULL) {
+                return chunk;
+            }
+        }
+    }
+    DEBUG("pktbuf: no chunk left for %u bytes\n", (unsigned)size);
+#ifdef DEVELHELP
+    _alloc_fails++;
+#endif
+    return NULL;
+}
+
+void gnrc_pktbuf_free_internal(void *data, size_t size)
+{
+    unsigned idx;
+    _slab_t *slab;
+
+    (void)size;
+    if (!gnrc_pktbuf_contains(data)) {
+        return;
+    }
+    slab = _slab_find(data, &idx);
+    assert(slab->refs[idx] > 0);
+    if (--slab->refs[idx] == 0) {
+        _slab_free_t *chunk = (_slab_free_t *)(uintptr_t)_chunk(slab, idx);
+
+        chunk->next = slab->free;
+        slab->free = chunk;
+        slab->used--;
+    }
+}
+
+/** @} */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @brief   Internal definitions of the size-class slab implementation of
+ *          @ref net_gnrc_pktbuf
+ *
+ * The slab implementation carves its arena into a fixed number of chunks per
+ * size class. Packet snip descriptors have their own class, packet data is
+ * placed into the smallest class with a free chunk it fits into. Allocation
+ * and release are O(1) and the arena can not fragment.
+ *
+ * Chunks are reference counted, so gnrc_pktbuf_mark() can split a chunk into
+ * several snips without copying any data. As a consequence, a chunk is only
+ * returned to its class once all snips pointing into it are released.
+ *
+ * The number of chunks per class can be configured at compile time. The size
+ * of the MTU class should be raised to at least 1536 for Ethernet interfaces.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Configuration of the size classes of gnrc_pktbuf_slab
+ */
+#ifndef PKTBUF_SLAB_H
+#define PKTBUF_SLAB_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Alignment of all chunks in the slab arena
+ */
+#define GNRC_PKTBUF_SLAB_ALIGN          (8U)
+
+/**
+ * @brief   Round @p size up to @ref GNRC_PKTBUF_SLAB_ALIGN
+ */
+#define GNRC_PKTBUF_SLAB_ROUND(size)    (((size) + GNRC_PKTBUF_SLAB_ALIGN - 1) & \
+                                         ~(GNRC_PKTBUF_SLAB_ALIGN - 1))
+
+/**
+ * @brief   Number of packet snip descriptors
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF  (48U)
+#endif
+
+/**
+ * @brief   Chunk size of the smallest data class (UDP and netif headers)
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE  (32U)
+#endif
+
+/**
+ * @brief   Number of chunks in the smallest data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF (24U)
+#endif
+
+/**
+ * @brief   Chunk size of the header data class (IPv6 headers)
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE    (48U)
+#endif
+
+/**
+ * @brief   Number of chunks in the header data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF   (16U)
+#endif
+
+/**
+ * @brief   Chunk size of the frame data class (IEEE 802.15.4 frames)
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE  (128U)
+#endif
+
+/**
+ * @brief   Number of chunks in the frame data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF (8U)
+#endif
+
+/**
+ * @brief   Chunk size of the largest data class (full IPv6 packets)
+ *
+ * This is the largest packet that can be allocated.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE    (1280U)
+#endif
+
+/**
+ * @brief   Number of chunks in the largest data class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_MTU_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_MTU_NUMOF   (2U)
+#endif
+
+/**
+ * @brief   Number of size classes
+ */
+#define GNRC_PKTBUF_SLAB_CLASS_NUMOF    (5U)
+
+/**
+ * @brief   Total number of chunks in the arena
+ */
+#define GNRC_PKTBUF_SLAB_CHUNK_NUMOF    (CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF + \
+                                         CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF + \
+                                         CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF + \
+                                         CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF + \
+                                         CONFIG_GNRC_PKTBUF_SLAB_MTU_NUMOF)
+
+/**
+ * @brief   Size of the slab arena in bytes
+ */
+#define GNRC_PKTBUF_SLAB_SIZE \
+    ((GNRC_PKTBUF_SLAB_ROUND(sizeof(gnrc_pktsnip_t)) * \
+      CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_HDR_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_HDR_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_FRAME_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_FRAME_NUMOF) + \
+     (GNRC_PKTBUF_SLAB_ROUND(CONFIG_GNRC_PKTBUF_SLAB_MTU_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SLAB_MTU_NUMOF))
+
+/**
+ * @brief   The arena used when module gnrc_pktbuf_slab is used
+ * @warning This is an internal buffer and should not be touched by external code
+ */
+extern uint8_t *gnrc_pktbuf_slab_buf;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKTBUF_SLAB_H */
+/** @} */
@@ -115,8 +115,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         return NULL;
     }
     /* marked data would not fit _unused_t marker => move data around to allow
-     * for proper free */
-    if ((pkt->size != size) && (size < required_new_size)) {
+     * for proper free. Loaned data is returned as a whole, so it can always
+     * be split in place. */
+    if ((pkt->size != size) && (size < required_new_size) &&
+        !gnrc_pktbuf_loaned(pkt->data)) {
         void *new_data_rest;
         new_data_marked = _pktbuf_alloc(size);
         if (new_data_marked == NULL) {
@@ -141,6 +143,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     }
     else {
         new_data_marked = pkt->data;
+        if (pkt->size != size) {
+            /* both snips share loaned data from now on */
+            gnrc_pktbuf_loan_hold(pkt->data);
+        }
         /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
         pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
                                           NULL;
@@ -159,7 +165,8 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     mutex_lock(&gnrc_pktbuf_mutex);
     assert(pkt != NULL);
     assert(((pkt->size == 0) && (pkt->data == NULL)) ||
-           ((pkt->size > 0) && (pkt->data != NULL) && gnrc_pktbuf_contains(pkt->data)));
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            (gnrc_pktbuf_contains(pkt->data) || gnrc_pktbuf_loaned(pkt->data))));
     /* new size and old size are equal */
     if (size == pkt->size) {
         /* nothing to do */
@@ -169,7 +176,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
-        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        gnrc_pktbuf_free_data(pkt->data, pkt->size);
         pkt->data = NULL;
     }
     /* if new size is bigger than old size */
@@ -183,10 +190,11 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         if (pkt->data != NULL) {            /* if old data exist */
             memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
         }
-        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        gnrc_pktbuf_free_data(pkt->data, pkt->size);
         pkt->data = new_data;
     }
-    else if (_align(pkt->size) > aligned_size) {
+    else if ((_align(pkt->size) > aligned_size) &&
+             !gnrc_pktbuf_loaned(pkt->data)) {
         gnrc_pktbuf_free_internal(((uint8_t *)pkt->data) + aligned_size,
                      pkt->size - aligned_size);
     }
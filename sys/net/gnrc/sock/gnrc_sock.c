@@ -115,7 +115,7 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         return -EINVAL;
     }
 #ifdef MODULE_XTIMER
-    xtimer_t timeout_timer;
+    xtimer_t timeout_timer = { 0 };
 
     if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
         timeout_timer.callback = _callback_put;
@@ -30,6 +30,7 @@
 #include "net/gnrc.h"
 #include "net/gnrc/tcp.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_congure.h"
 #include "include/gnrc_tcp_fsm.h"
 #include "include/gnrc_tcp_pkt.h"
 #include "include/gnrc_tcp_eventloop.h"
@@ -421,6 +422,34 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     TCP_DEBUG_LEAVE;
 }
 
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+void gnrc_tcp_tcb_set_congure(gnrc_tcp_tcb_t *tcb, congure_snd_t *congure)
+{
+    TCP_DEBUG_ENTER;
+    assert(tcb != NULL);
+    assert(_gnrc_tcp_fsm_get_state(tcb) == FSM_STATE_CLOSED);
+    tcb->congure = congure;
+    TCP_DEBUG_LEAVE;
+}
+#endif
+
+#if IS_USED(MODULE_GNRC_TCP_CONGURE) && IS_USED(MODULE_CONGURE_RENO)
+void gnrc_tcp_congure_reno_fr(congure_reno_snd_t *c)
+{
+    TCP_DEBUG_ENTER;
+    /* Called from within the FSM, while processing the ACK */
+    _gnrc_tcp_pkt_resend_oldest(c->super.ctx);
+    TCP_DEBUG_LEAVE;
+}
+
+const congure_reno_snd_consts_t gnrc_tcp_congure_reno_consts = {
+    .fr = gnrc_tcp_congure_reno_fr,
+    .init_mss = CONFIG_GNRC_TCP_MSS,
+    .init_ssthresh = CONGURE_WND_SIZE_MAX,
+    .frthresh = 3,
+};
+#endif
+
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote, uint16_t local_port)
 {
     TCP_DEBUG_ENTER;
@@ -499,11 +528,17 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     mbox_t mbox = MBOX_INIT(msg_queue, TCP_MSG_QUEUE_SIZE);
     evtimer_mbox_event_t event_user_timeout;
     evtimer_mbox_event_t event_probe_timeout;
+    evtimer_mbox_event_t event_pacing_timeout;
     uint32_t probe_timeout_duration_ms = 0;
     ssize_t ret = 0;
     bool probing_mode = false;
+    bool pacing = false;
+    bool timed_out = false;
     _gnrc_tcp_fsm_state_t state = 0;
 
+    /* Without congestion control, return once a single segment was acked */
+    const size_t target = _gnrc_tcp_congure_used(tcb) ? len : 1;
+
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
 
@@ -527,8 +562,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                     MSG_TYPE_USER_SPEC_TIMEOUT, &mbox);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until the data to send was sent and acked */
+    while (!timed_out
+           && ((ret >= 0 && (size_t)ret < target) || tcb->retransmit_numof > 0)) {
         state = _gnrc_tcp_fsm_get_state(tcb);
 
         /* Check if the connections state is closed. If so, a reset was received */
@@ -551,9 +587,18 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                         MSG_TYPE_PROBE_TIMEOUT, &mbox);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Try to send remaining data in case we are neither probing nor pacing */
+        if (ret >= 0 && (size_t)ret < target && !probing_mode && !pacing) {
+            int sent = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (uint8_t *)data + ret,
+                                     len - ret);
+
+            /* Congestion control may want the next segment to be sent later */
+            uint32_t pacing_ms = _gnrc_tcp_congure_pacing_ms(tcb, sent);
+            if (sent > 0 && pacing_ms > 0 && (size_t)(ret + sent) < len) {
+                pacing = true;
+                _sched_mbox(&event_pacing_timeout, pacing_ms, MSG_TYPE_PACING_TIMEOUT, &mbox);
+            }
+            ret += sent;
         }
 
         /* Wait for responses */
@@ -566,12 +611,21 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 ret = -ECONNABORTED;
                 break;
 
-            case MSG_TYPE_USER_SPEC_TIMEOUT:
+            case MSG_TYPE_USER_SPEC_TIMEOUT: {
                 TCP_DEBUG_INFO("Received MSG_TYPE_USER_SPEC_TIMEOUT.");
+                /* Data of this call the peer acked, the caller must not resend it */
+                ssize_t acked = (ret > 0) ? ret - (ssize_t)(tcb->snd_nxt - tcb->snd_una) : 0;
+
                 _gnrc_tcp_fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                timed_out = true;
+                if (acked > 0) {
+                    ret = acked;
+                    break;
+                }
                 TCP_DEBUG_ERROR("-ETIMEDOUT: User specified timeout expired.");
                 ret = -ETIMEDOUT;
                 break;
+            }
 
             case MSG_TYPE_PROBE_TIMEOUT:
                 TCP_DEBUG_INFO("Received MSG_TYPE_PROBE_TIMEOUT.");
@@ -588,6 +642,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 }
                 break;
 
+            case MSG_TYPE_PACING_TIMEOUT:
+                TCP_DEBUG_INFO("Received MSG_TYPE_PACING_TIMEOUT.");
+                pacing = false;
+                break;
+
             case MSG_TYPE_NOTIFY_USER:
                 TCP_DEBUG_INFO("Received MSG_TYPE_NOTIFY_USER.");
 
@@ -611,6 +670,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     _gnrc_tcp_fsm_set_mbox(tcb, NULL);
     _unsched_mbox(&tcb->event_misc);
     _unsched_mbox(&event_probe_timeout);
+    _unsched_mbox(&event_pacing_timeout);
     _unsched_mbox(&event_user_timeout);
     mutex_unlock(&(tcb->function_lock));
     TCP_DEBUG_LEAVE;
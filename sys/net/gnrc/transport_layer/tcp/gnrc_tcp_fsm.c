@@ -25,6 +25,7 @@
 #include "evtimer.h"
 #include "evtimer_msg.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_congure.h"
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_pkt.h"
 #include "include/gnrc_tcp_option.h"
@@ -92,10 +93,15 @@ static uint16_t _get_random_local_port(void)
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
+    if (tcb->retransmit_numof > 0) {
         _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        for (unsigned i = 0; i < tcb->retransmit_numof; i++) {
+            gnrc_pktsnip_t *pkt = tcb->retransmit_queue[i].pkt;
+
+            _gnrc_tcp_congure_discarded(tcb, _gnrc_tcp_pkt_get_seg_len(pkt));
+            gnrc_pktbuf_release(pkt);
+        }
+        tcb->retransmit_numof = 0;
     }
     TCP_DEBUG_LEAVE;
     return 0;
@@ -235,6 +241,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     }
 
     tcb->rcv_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    _gnrc_tcp_congure_init(tcb);
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -278,27 +285,47 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     TCP_DEBUG_ENTER;
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+    uint8_t opts[GNRC_TCP_OPTION_SIZE_MAX];
+
+    /* Options take space from the payload of a segment (RFC 6691) */
+    size_t opts_len = _gnrc_tcp_option_build(tcb, opts, MSK_ACK | MSK_PSH);
+    size_t mss = (tcb->mss < CONFIG_GNRC_TCP_MSS) ? tcb->mss : CONFIG_GNRC_TCP_MSS;
+    mss = (mss > opts_len) ? mss - opts_len : 0;
+
+    /* Send segments while the windows are open and the retransmit queue has space left */
+    while (sent < len && tcb->retransmit_numof < CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        uint32_t wnd = _gnrc_tcp_congure_cwnd(tcb);
+        uint32_t in_flight = tcb->snd_nxt - tcb->snd_una;
+
+        wnd = (wnd < tcb->snd_wnd) ? wnd : tcb->snd_wnd;
+        if (wnd <= in_flight) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = wnd - in_flight;
+        payload = (payload < mss) ? payload : mss;
+        payload = (payload < len - sent) ? payload : len - sent;
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH,
-                            tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt,
+                                tcb->rcv_nxt, (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
-        TCP_DEBUG_LEAVE;
-        return payload;
+        sent += payload;
+
+        /* The caller has to wait before the next segment, if segments are paced */
+        if (_gnrc_tcp_congure_pacing_ms(tcb, payload) > 0) {
+            break;
+        }
     }
     TCP_DEBUG_LEAVE;
-    return 0;
+    return sent;
 }
 
 /**
@@ -424,13 +451,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     uint32_t seg_seq = 0;            /* Sequence number of the incoming packet*/
     uint32_t seg_ack = 0;            /* Acknowledgment number of the incoming packet */
     uint32_t seg_wnd = 0;            /* Receive window of the incoming packet */
+    _gnrc_tcp_option_t opts;         /* Options of the incoming packet */
 
     /* Search for TCP header. */
     snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_TCP);
     tcp_hdr_t *tcp_hdr = (tcp_hdr_t *) snp->data;
 
     /* Parse packet options, return if they are malformed */
-    if (_gnrc_tcp_option_parse(tcb, tcp_hdr) < 0) {
+    if (_gnrc_tcp_option_parse(tcp_hdr, &opts) < 0) {
         TCP_DEBUG_ERROR("Failed to parse TCP header options.");
         TCP_DEBUG_LEAVE;
         return 0;
@@ -442,6 +470,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* The window of a SYN is never scaled (RFC 7323, section 2.2) */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wscale;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_IPV6);
@@ -526,6 +559,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             return 0;
 #endif
 
+            _gnrc_tcp_option_negotiate(tcb, &opts);
             tcb->local_port = dst;
             tcb->peer_port = src;
             tcb->irs = byteorder_ntohl(tcp_hdr->seq_num);
@@ -572,11 +606,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         }
         /* 3) Check SYN: Set TCB values accordingly */
         if (ctl & MSK_SYN) {
+            _gnrc_tcp_option_negotiate(tcb, &opts);
             tcb->rcv_nxt = seg_seq + 1;
             tcb->irs = seg_seq;
             if (ctl & MSK_ACK) {
                 tcb->snd_una = seg_ack;
-                _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                _gnrc_tcp_pkt_acknowledge(tcb, seg_ack, seg_wnd, &opts);
             }
             /* Set local network layer address accordingly */
 #ifdef MODULE_GNRC_IPV6
@@ -626,6 +661,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             TCP_DEBUG_LEAVE;
             return 0;
         }
+#ifdef MODULE_GNRC_TCP_TIMESTAMPS
+        /* Remember the timestamp to echo (RFC 7323, section 4.3) */
+        if ((tcb->options & GNRC_TCP_OPTION_TS) && opts.ts &&
+            LEQ_32_BIT(seg_seq, tcb->rcv_nxt)) {
+            tcb->ts_recent = opts.ts_val;
+        }
+#endif
         /* 2) Check RST: If RST is set ... */
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
@@ -674,7 +716,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     tcb->snd_una = seg_ack;
-                    _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                    _gnrc_tcp_pkt_acknowledge(tcb, seg_ack, seg_wnd, &opts);
+                }
+                /* Duplicate ACK: Congestion control decides on fast retransmit */
+                else if (seg_ack == tcb->snd_una && tcb->retransmit_numof > 0) {
+                    _gnrc_tcp_congure_acked(tcb, &tcb->retransmit_queue[0], 0, seg_ack,
+                                            seg_wnd, pay_len, !(ctl & (MSK_SYN | MSK_FIN)));
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -696,28 +743,33 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                         tcb->status |= STATUS_NOTIFY_USER;
                     }
                 }
+                /* Resend segments the peer reported as missing */
+                if (opts.sack_numof > 0) {
+                    _gnrc_tcp_pkt_sack_update(tcb, &opts);
+                    _gnrc_tcp_pkt_sack_recover(tcb);
+                }
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_numof == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         TCP_DEBUG_LEAVE;
                         return 0;
@@ -743,11 +795,18 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                         tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
                         snp = snp->next;
                     }
+                    /* Copy queued out-of-order data that became contiguous */
+                    _gnrc_tcp_rcvbuf_ooo_drain(tcb);
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+                /* Keep data beyond a gap, it is reported via SACK */
+                else if ((tcb->options & GNRC_TCP_OPTION_SACK) &&
+                         LSS_32_BIT(tcb->rcv_nxt, seg_seq)) {
+                    _gnrc_tcp_rcvbuf_ooo_add(tcb, in_pkt, seg_seq, pay_len);
+                }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
@@ -774,7 +833,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->retransmit_numof == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -818,9 +877,19 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->retransmit_numof > 0) {
+        gnrc_pktsnip_t *pkt = tcb->retransmit_queue[0].pkt;
+
+        /* All segments in flight are assumed lost: Resend them one by one as ACKs arrive.
+         * The peer may have discarded data it selectively acknowledged, so SACK
+         * information is cleared as well (RFC 2018, section 8) */
+        _gnrc_tcp_congure_timeout(tcb);
+        for (unsigned i = 0; i < tcb->retransmit_numof; i++) {
+            tcb->retransmit_queue[i].sacked = false;
+            tcb->retransmit_queue[i].lost = (i > 0);
+        }
+        _gnrc_tcp_pkt_setup_retransmit(tcb, pkt, true);
+        _gnrc_tcp_pkt_send(tcb, pkt, 0, true);
     }
     else {
         TCP_DEBUG_INFO("Retransmission queue is empty.");
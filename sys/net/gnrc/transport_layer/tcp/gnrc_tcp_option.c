@@ -16,17 +16,43 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
+#include "byteorder.h"
+#include "evtimer.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_option.h"
+#include "include/gnrc_tcp_pkt.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
-int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+/**
+ * @brief Options offered in a SYN.
+ */
+#define OPTIONS_OFFERED ((IS_USED(MODULE_GNRC_TCP_SACK) ? GNRC_TCP_OPTION_SACK : 0) | \
+                         (IS_USED(MODULE_GNRC_TCP_TIMESTAMPS) ? GNRC_TCP_OPTION_TS : 0) | \
+                         (IS_USED(MODULE_GNRC_TCP_WSCALE) ? GNRC_TCP_OPTION_WS : 0))
+
+uint8_t _gnrc_tcp_option_rcv_wscale(void)
+{
+    uint8_t shift = 0;
+
+    while ((((uint32_t) GNRC_TCP_RCV_BUF_SIZE) >> shift) > UINT16_MAX &&
+           shift < TCP_OPTION_WS_MAX) {
+        shift++;
+    }
+    return shift;
+}
+
+int _gnrc_tcp_option_parse(tcp_hdr_t *hdr, _gnrc_tcp_option_t *opts)
 {
     TCP_DEBUG_ENTER;
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+
+    memset(opts, 0, sizeof(*opts));
+
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         TCP_DEBUG_LEAVE;
         return 0;
@@ -61,7 +87,71 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                     return -1;
                 }
                 TCP_DEBUG_INFO("MSS option found.");
-                tcb->mss = (option->value[0] << 8) | option->value[1];
+                opts->mss = (option->value[0] << 8) | option->value[1];
+                break;
+
+            case TCP_OPTION_KIND_WS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WS) {
+                    TCP_DEBUG_ERROR("Invalid window scale option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("Window scale option found.");
+                /* The window scale is only valid in a SYN (RFC 7323, section 2.2) */
+                if (IS_USED(MODULE_GNRC_TCP_WSCALE) && (ctl & MSK_SYN)) {
+                    opts->syn_options |= GNRC_TCP_OPTION_WS;
+                    opts->wscale = (option->value[0] < TCP_OPTION_WS_MAX)
+                                 ? option->value[0] : TCP_OPTION_WS_MAX;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    TCP_DEBUG_ERROR("Invalid SACK permitted option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK permitted option found.");
+                if (IS_USED(MODULE_GNRC_TCP_SACK) && (ctl & MSK_SYN)) {
+                    opts->syn_options |= GNRC_TCP_OPTION_SACK;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    ((option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK)) {
+                    TCP_DEBUG_ERROR("Invalid SACK option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK option found.");
+                for (unsigned i = TCP_OPTION_LENGTH_MIN;
+                     i < option->length && opts->sack_numof < GNRC_TCP_SACK_BLOCKS_MAX;
+                     i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                    _gnrc_tcp_sack_block_t *block = &opts->sack[opts->sack_numof++];
+
+                    block->left = byteorder_bebuftohl(opt_ptr + i);
+                    block->right = byteorder_bebuftohl(opt_ptr + i + 4);
+                }
+                break;
+
+            case TCP_OPTION_KIND_TS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_TS) {
+                    TCP_DEBUG_ERROR("Invalid timestamps option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("Timestamps option found.");
+                opts->ts = true;
+                opts->ts_val = byteorder_bebuftohl(option->value);
+                opts->ts_ecr = byteorder_bebuftohl(option->value + 4);
+                if (IS_USED(MODULE_GNRC_TCP_TIMESTAMPS) && (ctl & MSK_SYN)) {
+                    opts->syn_options |= GNRC_TCP_OPTION_TS;
+                }
                 break;
 
             default:
@@ -83,3 +173,192 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     TCP_DEBUG_LEAVE;
     return 0;
 }
+
+void _gnrc_tcp_option_negotiate(gnrc_tcp_tcb_t *tcb, const _gnrc_tcp_option_t *opts)
+{
+    TCP_DEBUG_ENTER;
+    if (opts->mss) {
+        tcb->mss = opts->mss;
+    }
+    tcb->options = opts->syn_options;
+    tcb->snd_wscale = 0;
+    tcb->rcv_wscale = 0;
+    if (opts->syn_options & GNRC_TCP_OPTION_WS) {
+        tcb->snd_wscale = opts->wscale;
+        tcb->rcv_wscale = _gnrc_tcp_option_rcv_wscale();
+    }
+#ifdef MODULE_GNRC_TCP_TIMESTAMPS
+    if (opts->syn_options & GNRC_TCP_OPTION_TS) {
+        tcb->ts_recent = opts->ts_val;
+    }
+#endif
+    TCP_DEBUG_LEAVE;
+}
+
+#ifdef MODULE_GNRC_TCP_SACK
+/**
+ * @brief Collects the SACK blocks describing the out-of-order queue.
+ *
+ * The block holding the latest received segment comes first (RFC 2018,
+ * section 4), the others follow in sequence number order.
+ *
+ * @param[in]  tcb      TCB holding the connection information.
+ * @param[out] blocks   Buffer for the blocks.
+ * @param[in]  max      Number of blocks @p blocks can hold.
+ *
+ * @returns   Number of blocks stored in @p blocks.
+ */
+static uint8_t _sack_blocks(const gnrc_tcp_tcb_t *tcb, _gnrc_tcp_sack_block_t *blocks,
+                            uint8_t max)
+{
+    _gnrc_tcp_sack_block_t all[CONFIG_GNRC_TCP_OOO_QUEUE_SIZE];
+    unsigned numof = 0;
+    unsigned first = 0;
+    uint8_t res = 0;
+
+    /* Merge adjacent and overlapping segments into blocks */
+    for (unsigned i = 0; i < tcb->ooo_numof; i++) {
+        gnrc_pktsnip_t *pkt = tcb->ooo_queue[i];
+        gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+        uint32_t left = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+        uint32_t right = left + _gnrc_tcp_pkt_get_pay_len(pkt);
+
+        if (numof > 0 && LEQ_32_BIT(left, all[numof - 1].right)) {
+            if (LSS_32_BIT(all[numof - 1].right, right)) {
+                all[numof - 1].right = right;
+            }
+        }
+        else {
+            all[numof].left = left;
+            all[numof].right = right;
+            numof++;
+        }
+        if (left == tcb->ooo_last) {
+            first = numof - 1;
+        }
+    }
+
+    if (max > 0 && numof > 0) {
+        blocks[res++] = all[first];
+    }
+    for (unsigned i = 0; i < numof && res < max; i++) {
+        if (i != first) {
+            blocks[res++] = all[i];
+        }
+    }
+    return res;
+}
+#endif
+
+uint8_t _gnrc_tcp_option_build(const gnrc_tcp_tcb_t *tcb, uint8_t *buf,
+                               uint16_t ctl)
+{
+    TCP_DEBUG_ENTER;
+    uint8_t *pos = buf;
+    bool syn = (ctl & MSK_SYN);
+    /* A SYN offers all enabled options, all other segments use the agreed ones */
+    uint8_t options = (syn && !(ctl & MSK_ACK)) ? OPTIONS_OFFERED : tcb->options;
+
+    /* Segments resetting the connection carry no options */
+    if (ctl & MSK_RST) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+
+    /* If SYN flag is set: Add MSS option */
+    if (syn) {
+        network_uint32_t mss_option = byteorder_htonl(
+            _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
+
+        memcpy(pos, &mss_option, sizeof(mss_option));
+        pos += sizeof(mss_option);
+    }
+
+    /* SACK permitted, placed in front of timestamps to save padding */
+    if (syn && (options & GNRC_TCP_OPTION_SACK)) {
+        if (!(options & GNRC_TCP_OPTION_TS)) {
+            *pos++ = TCP_OPTION_KIND_NOP;
+            *pos++ = TCP_OPTION_KIND_NOP;
+        }
+        *pos++ = TCP_OPTION_KIND_SACK_PERM;
+        *pos++ = TCP_OPTION_LENGTH_SACK_PERM;
+    }
+    else if (options & GNRC_TCP_OPTION_TS) {
+        *pos++ = TCP_OPTION_KIND_NOP;
+        *pos++ = TCP_OPTION_KIND_NOP;
+    }
+
+#ifdef MODULE_GNRC_TCP_TIMESTAMPS
+    if (options & GNRC_TCP_OPTION_TS) {
+        *pos++ = TCP_OPTION_KIND_TS;
+        *pos++ = TCP_OPTION_LENGTH_TS;
+        byteorder_htobebufl(pos, evtimer_now_msec());
+        byteorder_htobebufl(pos + 4, (ctl & MSK_ACK) ? tcb->ts_recent : 0);
+        pos += 8;
+    }
+#endif
+
+    if (syn && (options & GNRC_TCP_OPTION_WS)) {
+        *pos++ = TCP_OPTION_KIND_NOP;
+        *pos++ = TCP_OPTION_KIND_WS;
+        *pos++ = TCP_OPTION_LENGTH_WS;
+        *pos++ = _gnrc_tcp_option_rcv_wscale();
+    }
+
+#ifdef MODULE_GNRC_TCP_SACK
+    /* Report out-of-order data in acknowledgements */
+    if (!syn && (options & GNRC_TCP_OPTION_SACK) && tcb->ooo_numof > 0) {
+        _gnrc_tcp_sack_block_t blocks[GNRC_TCP_SACK_BLOCKS_MAX];
+        uint8_t max = (GNRC_TCP_OPTION_SIZE_MAX - (pos - buf) - 2 - TCP_OPTION_LENGTH_MIN) /
+                      TCP_OPTION_LENGTH_SACK_BLOCK;
+        uint8_t numof = _sack_blocks(tcb, blocks, (max < GNRC_TCP_SACK_BLOCKS_MAX)
+                                                  ? max : GNRC_TCP_SACK_BLOCKS_MAX);
+
+        *pos++ = TCP_OPTION_KIND_NOP;
+        *pos++ = TCP_OPTION_KIND_NOP;
+        *pos++ = TCP_OPTION_KIND_SACK;
+        *pos++ = TCP_OPTION_LENGTH_MIN + numof * TCP_OPTION_LENGTH_SACK_BLOCK;
+        for (unsigned i = 0; i < numof; i++) {
+            byteorder_htobebufl(pos, blocks[i].left);
+            byteorder_htobebufl(pos + 4, blocks[i].right);
+            pos += TCP_OPTION_LENGTH_SACK_BLOCK;
+        }
+    }
+#endif
+    TCP_DEBUG_LEAVE;
+    return pos - buf;
+}
+
+void _gnrc_tcp_option_refresh_ts(const gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+{
+    TCP_DEBUG_ENTER;
+#ifdef MODULE_GNRC_TCP_TIMESTAMPS
+    uint8_t *opt_ptr = (uint8_t *) hdr + sizeof(tcp_hdr_t);
+    uint8_t *opt_end = (uint8_t *) hdr + GET_OFFSET(byteorder_ntohs(hdr->off_ctl)) * 4;
+
+    if (!(tcb->options & GNRC_TCP_OPTION_TS)) {
+        TCP_DEBUG_LEAVE;
+        return;
+    }
+
+    /* Options were built by _gnrc_tcp_option_build() and are well-formed */
+    while (opt_ptr < opt_end && *opt_ptr != TCP_OPTION_KIND_EOL) {
+        if (*opt_ptr == TCP_OPTION_KIND_NOP) {
+            opt_ptr++;
+            continue;
+        }
+        if (*opt_ptr == TCP_OPTION_KIND_TS) {
+            byteorder_htobebufl(opt_ptr + 2, evtimer_now_msec());
+            if (byteorder_ntohs(hdr->off_ctl) & MSK_ACK) {
+                byteorder_htobebufl(opt_ptr + 6, tcb->ts_recent);
+            }
+            break;
+        }
+        opt_ptr += opt_ptr[1];
+    }
+#else
+    (void) tcb;
+    (void) hdr;
+#endif
+    TCP_DEBUG_LEAVE;
+}
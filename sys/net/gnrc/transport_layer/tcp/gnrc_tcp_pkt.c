@@ -25,6 +25,7 @@
 #include "net/inet_csum.h"
 #include "net/gnrc.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_congure.h"
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_pkt.h"
@@ -49,6 +50,13 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Number of segments SACKed above a hole that mark it as lost.
+ *
+ * See DupThresh in RFC 6675, section 2.
+ */
+#define SACK_DUPTHRESH (3U)
+
 int _gnrc_tcp_pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt,
                                        gnrc_pktsnip_t *in_pkt)
 {
@@ -155,6 +163,9 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
+    uint8_t opts[GNRC_TCP_OPTION_SIZE_MAX];
+    uint8_t opts_len = 0;
+    uint32_t wnd = tcb->rcv_wnd;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -173,14 +184,17 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
-    /* Calculate option field size. */
-    /* Add MSS option if SYN is sent */
-    if (ctl & MSK_SYN) {
-        offset += 1;
+    /* The window of a SYN is never scaled (RFC 7323, section 2.2) */
+    if (!(ctl & MSK_SYN)) {
+        wnd >>= tcb->rcv_wscale;
     }
+    tcp_hdr.window = byteorder_htons((wnd > UINT16_MAX) ? UINT16_MAX : wnd);
+
+    /* Calculate option field size. */
+    opts_len = _gnrc_tcp_option_build(tcb, opts, ctl);
+    offset += opts_len / sizeof(network_uint32_t);
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(
         _gnrc_tcp_option_build_offset_control(offset, ctl));
@@ -204,22 +218,8 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
         }
 
         /* Add options if existing */
-        if (TCP_HDR_OFFSET_MIN < offset) {
-            uint8_t *opt_ptr = (uint8_t *) tcp_snp->data + sizeof(tcp_hdr);
-            uint8_t opt_left = (offset - TCP_HDR_OFFSET_MIN) * sizeof(network_uint32_t);
-
-            /* Init options field with 'End Of List' - option (0) */
-            memset(opt_ptr, TCP_OPTION_KIND_EOL, opt_left);
-
-            /* If SYN flag is set: Add MSS option */
-            if (ctl & MSK_SYN) {
-                network_uint32_t mss_option = byteorder_htonl(
-                    _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
-
-                memcpy(opt_ptr, &mss_option, sizeof(mss_option));
-            }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
-            /* NOTE: Add additional options here */
+        if (opts_len > 0) {
+            memcpy((uint8_t *) tcp_snp->data + sizeof(tcp_hdr), opts, opts_len);
         }
         *(out_pkt) = tcp_snp;
     }
@@ -285,14 +285,32 @@ int _gnrc_tcp_pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt,
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = evtimer_now_msec();
     }
     else {
         tcb->retries += 1;
+
+        /* Refresh the timestamps, if no earlier transmission still uses the header */
+        gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(out_pkt, GNRC_NETTYPE_TCP);
+        if (snp != NULL && snp->users <= 2) {
+            _gnrc_tcp_option_refresh_ts(tcb, (tcp_hdr_t *) snp->data);
+        }
+    }
+
+    /* Measure time of segments in the retransmission queue */
+    for (unsigned i = 0; i < tcb->retransmit_numof; i++) {
+        gnrc_tcp_retransmit_t *entry = &tcb->retransmit_queue[i];
+
+        if (entry->pkt == out_pkt) {
+            entry->send_time = evtimer_now_msec();
+            if (retransmit) {
+                entry->resends += 1;
+                entry->lost = false;
+            }
+            break;
+        }
     }
 
     /* Pass packet down the network stack */
@@ -375,6 +393,45 @@ uint32_t _gnrc_tcp_pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the RTO from the current RTT estimation.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no RTT estimation: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
+                                    CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief (Re)starts the retransmission timer for the oldest segment in the
+ *        retransmission queue.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _sched_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
+                              MSG_TYPE_RETRANSMISSION, tcb);
+}
+
 int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
                                    const bool retransmit)
 {
@@ -390,13 +447,6 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
-        TCP_DEBUG_LEAVE;
-        return -ENOMEM;
-    }
-
     /* Extract control bits and segment length */
     snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
     ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
@@ -408,20 +458,40 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    if (!retransmit) {
+        /* Check if retransmit queue is full */
+        if (tcb->retransmit_numof >= CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+            TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
+            TCP_DEBUG_LEAVE;
+            return -ENOMEM;
+        }
+
+        /* Append pkt to retransmit queue */
+        gnrc_tcp_retransmit_t *entry = &tcb->retransmit_queue[tcb->retransmit_numof++];
+        entry->pkt = pkt;
+        entry->resends = 0;
+        entry->lost = false;
+        entry->sacked = false;
+        _gnrc_tcp_congure_sent(tcb, _gnrc_tcp_pkt_get_seg_len(pkt));
+    }
+    /* Only the oldest segment is retransmitted on timeout */
+    else if (tcb->retransmit_numof == 0 || tcb->retransmit_queue[0].pkt != pkt) {
+        TCP_DEBUG_ERROR("-EINVAL: pkt is not the oldest packet in retransmit queue.");
+        TCP_DEBUG_LEAVE;
+        return -EINVAL;
+    }
+
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
     /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
-                                        CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* Timer is already running if an older segment is unacknowledged */
+        if (tcb->retransmit_numof > 1) {
+            TCP_DEBUG_LEAVE;
+            return 0;
         }
+        _calc_rto(tcb);
     }
     else {
         /* If this is a retransmission: Double the rto (Timer Backoff) */
@@ -434,65 +504,190 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
     }
+    _sched_retransmit(tcb);
+    TCP_DEBUG_LEAVE;
+    return 0;
+}
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-    }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+/**
+ * @brief Resends a segment from the retransmission queue.
+ *
+ * The segment is not assumed lost by a timeout, so there is no timer backoff.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     idx   Index of the segment in the retransmission queue.
+ */
+static void _resend(gnrc_tcp_tcb_t *tcb, unsigned idx)
+{
+    gnrc_pktsnip_t *pkt = tcb->retransmit_queue[idx].pkt;
+
+    gnrc_pktbuf_hold(pkt, 1);
+    if (idx == 0) {
+        _calc_rto(tcb);
+        _sched_retransmit(tcb);
     }
+    _gnrc_tcp_pkt_send(tcb, pkt, 0, true);
+}
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
-                              MSG_TYPE_RETRANSMISSION, tcb);
+int _gnrc_tcp_pkt_resend_oldest(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    if (tcb->retransmit_numof == 0) {
+        TCP_DEBUG_ERROR("-ENODATA: Retransmit queue is empty.");
+        TCP_DEBUG_LEAVE;
+        return -ENODATA;
+    }
+    _resend(tcb, 0);
     TCP_DEBUG_LEAVE;
     return 0;
 }
 
-int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
+void _gnrc_tcp_pkt_sack_update(gnrc_tcp_tcb_t *tcb, const _gnrc_tcp_option_t *opts)
 {
     TCP_DEBUG_ENTER;
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    if (!(tcb->options & GNRC_TCP_OPTION_SACK)) {
+        TCP_DEBUG_LEAVE;
+        return;
+    }
+
+    for (unsigned i = 0; i < opts->sack_numof; i++) {
+        const _gnrc_tcp_sack_block_t *block = &opts->sack[i];
+
+        /* Ignore blocks outside of the data in flight (RFC 2018, section 4) */
+        if (LEQ_32_BIT(block->right, block->left) ||
+            LEQ_32_BIT(block->left, tcb->snd_una) ||
+            LSS_32_BIT(tcb->snd_nxt, block->right)) {
+            continue;
+        }
+        for (unsigned j = 0; j < tcb->retransmit_numof; j++) {
+            gnrc_tcp_retransmit_t *entry = &tcb->retransmit_queue[j];
+            gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(entry->pkt, GNRC_NETTYPE_TCP);
+            uint32_t seq = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+            uint32_t end = seq + _gnrc_tcp_pkt_get_seg_len(entry->pkt);
+
+            if (LEQ_32_BIT(block->left, seq) && LEQ_32_BIT(end, block->right)) {
+                entry->sacked = true;
+                entry->lost = false;
+            }
+        }
+    }
+    TCP_DEBUG_LEAVE;
+}
+
+int _gnrc_tcp_pkt_sack_recover(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    unsigned sacked_above = 0;
+    int hole = -ENODATA;
+
+    if (!(tcb->options & GNRC_TCP_OPTION_SACK)) {
+        TCP_DEBUG_LEAVE;
+        return -ENODATA;
+    }
+
+    /* Find the oldest segment that was neither resent nor SACKed, but enough
+     * segments after it were SACKed to consider it lost (IsLost() in RFC 6675) */
+    for (int i = tcb->retransmit_numof - 1; i >= 0; i--) {
+        gnrc_tcp_retransmit_t *entry = &tcb->retransmit_queue[i];
+
+        if (entry->sacked) {
+            sacked_above++;
+        }
+        else if (sacked_above >= SACK_DUPTHRESH && entry->resends == 0 && !entry->lost) {
+            hole = i;
+        }
+    }
+    if (hole >= 0) {
+        _resend(tcb, hole);
+    }
+    TCP_DEBUG_LEAVE;
+    return hole;
+}
+
+int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack,
+                              const uint32_t wnd, const _gnrc_tcp_option_t *opts)
+{
+    TCP_DEBUG_ENTER;
+    gnrc_tcp_retransmit_t newest;
+    uint32_t acked = 0;
+    unsigned numof = 0;
+    bool resent = false;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->retransmit_numof == 0) {
         TCP_DEBUG_ERROR("-ENODATA: No packet to acknowledge.");
         TCP_DEBUG_LEAVE;
         return -ENODATA;
     }
 
-    snp = gnrc_pktsnip_search_type(tcb->pkt_retransmit, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
+    /* Release all segments that were acknowledged completely */
+    while (numof < tcb->retransmit_numof) {
+        gnrc_tcp_retransmit_t *entry = &tcb->retransmit_queue[numof];
+        gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(entry->pkt, GNRC_NETTYPE_TCP);
+        tcp_hdr_t *hdr = (tcp_hdr_t *) snp->data;
+        uint32_t seg_len = _gnrc_tcp_pkt_get_seg_len(entry->pkt);
+        uint32_t seg = byteorder_ntohl(hdr->seq_num) + seg_len - 1;
+
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        acked += seg_len;
+        resent |= (entry->resends > 0);
+        newest = *entry;
+        gnrc_pktbuf_release(entry->pkt);
+        numof++;
+    }
+    if (numof == 0) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+    tcb->retransmit_numof -= numof;
+    memmove(tcb->retransmit_queue, &tcb->retransmit_queue[numof],
+            tcb->retransmit_numof * sizeof(tcb->retransmit_queue[0]));
+    tcb->retries = 0;
+
+    /* Measure round trip time */
+    int32_t rtt = evtimer_now_msec() - newest.send_time;
 
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _gnrc_tcp_pkt_get_seg_len(
-        tcb->pkt_retransmit) - 1;
+    /* The echoed timestamp tells which transmission was acknowledged, so
+     * retransmitted segments can be measured as well (RFC 7323, section 4.1) */
+    if ((tcb->options & GNRC_TCP_OPTION_TS) && opts->ts && opts->ts_ecr != 0) {
+        rtt = evtimer_now_msec() - opts->ts_ecr;
+        resent = false;
+    }
 
-        /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
+    /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
+    if (!resent && rtt > 0) {
+        /* If this is the first sample taken */
+        if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
+            tcb->srtt = rtt;
+            tcb->rtt_var = (rtt >> 1);
+        }
+        /* If this is a subsequent sample */
+        else {
+            tcb->rtt_var = (tcb->rtt_var / CONFIG_GNRC_TCP_RTO_B_DIV) * (CONFIG_GNRC_TCP_RTO_B_DIV-1);
+            tcb->rtt_var += labs(tcb->srtt - rtt) / CONFIG_GNRC_TCP_RTO_B_DIV;
+            tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
+            tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
+        }
+    }
+
+    /* Congestion control may resend the oldest segment on partial ACKs */
+    _gnrc_tcp_congure_acked(tcb, &newest, acked, ack, wnd, 0, true);
+
+    /* Stop timer if everything was acknowledged, otherwise restart it for the oldest segment */
+    if (tcb->retransmit_numof == 0) {
         _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
-
-        /* Measure round trip time */
-        int32_t rtt = evtimer_now_msec() - tcb->rtt_start;
-
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
-            /* If this is the first sample taken */
-            if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
-                tcb->srtt = rtt;
-                tcb->rtt_var = (rtt >> 1);
-            }
-            /* If this is a subsequent sample */
-            else {
-                tcb->rtt_var = (tcb->rtt_var / CONFIG_GNRC_TCP_RTO_B_DIV) * (CONFIG_GNRC_TCP_RTO_B_DIV-1);
-                tcb->rtt_var += labs(tcb->srtt - rtt) / CONFIG_GNRC_TCP_RTO_B_DIV;
-                tcb->srtt = (tcb->srtt / CONFIG_GNRC_TCP_RTO_A_DIV) * (CONFIG_GNRC_TCP_RTO_A_DIV-1);
-                tcb->srtt += rtt / CONFIG_GNRC_TCP_RTO_A_DIV;
+    }
+    else {
+        _calc_rto(tcb);
+        _sched_retransmit(tcb);
+
+        /* Resend segments that were in flight on the last timeout, one per ACK */
+        for (unsigned i = 0; i < tcb->retransmit_numof; i++) {
+            if (tcb->retransmit_queue[i].lost) {
+                _resend(tcb, i);
+                break;
             }
         }
     }
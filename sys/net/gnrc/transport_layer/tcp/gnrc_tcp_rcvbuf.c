@@ -18,8 +18,12 @@
 #include <errno.h>
 #include <mutex.h>
 #include <stdint.h>
+#include <string.h>
+#include "byteorder.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/tcp/config.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_pkt.h"
 #include "include/gnrc_tcp_rcvbuf.h"
 
 #define ENABLE_DEBUG 0
@@ -122,5 +126,122 @@ void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
         _rcvbuf_free(tcb->rcv_buf_raw);
         tcb->rcv_buf_raw = NULL;
     }
+#ifdef MODULE_GNRC_TCP_SACK
+    for (unsigned i = 0; i < tcb->ooo_numof; i++) {
+        gnrc_pktbuf_release(tcb->ooo_queue[i]);
+    }
+    tcb->ooo_numof = 0;
+#endif
+    TCP_DEBUG_LEAVE;
+}
+
+#ifdef MODULE_GNRC_TCP_SACK
+/**
+ * @brief Get the sequence number of a received segment.
+ *
+ * @param[in] pkt   Received segment.
+ *
+ * @returns   Sequence number of @p pkt.
+ */
+static uint32_t _get_seq(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+#endif
+
+int _gnrc_tcp_rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                             uint32_t seq, uint32_t len)
+{
+    TCP_DEBUG_ENTER;
+#ifdef MODULE_GNRC_TCP_SACK
+    unsigned pos = 0;
+
+    /* The first SACK block must report the latest segment, even a duplicate */
+    tcb->ooo_last = seq;
+
+    /* Only keep data that fits into the receive buffer once the gap is filled */
+    if (LSS_32_BIT(tcb->rcv_nxt + tcb->rcv_wnd, seq + len)) {
+        TCP_DEBUG_INFO("-ENOSPC: Segment exceeds receive window.");
+        TCP_DEBUG_LEAVE;
+        return -ENOSPC;
+    }
+
+    /* Find position, queue is ordered by sequence number */
+    while (pos < tcb->ooo_numof) {
+        uint32_t cur = _get_seq(tcb->ooo_queue[pos]);
+
+        if (cur == seq) {
+            TCP_DEBUG_INFO("-EALREADY: Segment is kept already.");
+            TCP_DEBUG_LEAVE;
+            return -EALREADY;
+        }
+        if (LSS_32_BIT(seq, cur)) {
+            break;
+        }
+        pos++;
+    }
+    if (tcb->ooo_numof >= CONFIG_GNRC_TCP_OOO_QUEUE_SIZE) {
+        TCP_DEBUG_INFO("-ENOMEM: Out-of-order queue is full.");
+        TCP_DEBUG_LEAVE;
+        return -ENOMEM;
+    }
+    memmove(&tcb->ooo_queue[pos + 1], &tcb->ooo_queue[pos],
+            (tcb->ooo_numof - pos) * sizeof(tcb->ooo_queue[0]));
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->ooo_queue[pos] = pkt;
+    tcb->ooo_numof++;
+    TCP_DEBUG_LEAVE;
+    return 0;
+#else
+    (void) tcb;
+    (void) pkt;
+    (void) seq;
+    (void) len;
+    TCP_DEBUG_LEAVE;
+    return -ENOTSUP;
+#endif
+}
+
+uint32_t _gnrc_tcp_rcvbuf_ooo_drain(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    uint32_t moved = 0;
+#ifdef MODULE_GNRC_TCP_SACK
+    while (tcb->ooo_numof > 0) {
+        gnrc_pktsnip_t *pkt = tcb->ooo_queue[0];
+        uint32_t seq = _get_seq(pkt);
+
+        /* Stop at the next gap */
+        if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+            break;
+        }
+
+        /* Copy the payload following rcv_nxt, skip what was received already */
+        uint32_t skip = tcb->rcv_nxt - seq;
+        gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UNDEF);
+        while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+            if (skip < snp->size) {
+                uint32_t added = ringbuffer_add(&(tcb->rcv_buf), (char *) snp->data + skip,
+                                                snp->size - skip);
+                tcb->rcv_nxt += added;
+                moved += added;
+                skip = 0;
+            }
+            else {
+                skip -= snp->size;
+            }
+            snp = snp->next;
+        }
+
+        gnrc_pktbuf_release(pkt);
+        tcb->ooo_numof--;
+        memmove(&tcb->ooo_queue[0], &tcb->ooo_queue[1],
+                tcb->ooo_numof * sizeof(tcb->ooo_queue[0]));
+    }
+#else
+    (void) tcb;
+#endif
     TCP_DEBUG_LEAVE;
+    return moved;
 }
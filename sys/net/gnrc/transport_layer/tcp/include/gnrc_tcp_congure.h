@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Glue between TCP and the congestion control of a connection.
+ *
+ * All functions do nothing if module gnrc_tcp_congure is not used or if no
+ * congestion control was set for a connection.
+ */
+
+#ifndef GNRC_TCP_CONGURE_H
+#define GNRC_TCP_CONGURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "evtimer.h"
+#include "timex.h"
+#include "net/gnrc/tcp/tcb.h"
+#include "gnrc_tcp_pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_USED(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+/**
+ * @brief Initializes the congestion control for a new connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static inline void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->congure) {
+        tcb->congure->driver->init(tcb->congure, tcb);
+    }
+}
+
+/**
+ * @brief Checks if a connection uses congestion control.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   true if a congure object was assigned to @p tcb.
+ */
+static inline bool _gnrc_tcp_congure_used(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->congure != NULL;
+}
+
+/**
+ * @brief Get the congestion window.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The congestion window in bytes, UINT32_MAX without congestion control.
+ */
+static inline uint32_t _gnrc_tcp_congure_cwnd(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->congure) ? tcb->congure->cwnd : UINT32_MAX;
+}
+
+/**
+ * @brief Get the time to wait after sending a segment.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     size   Size of the segment in bytes.
+ *
+ * @returns   Pacing interval in milliseconds. Zero if segments are not paced.
+ */
+static inline uint32_t _gnrc_tcp_congure_pacing_ms(gnrc_tcp_tcb_t *tcb, unsigned size)
+{
+    if (tcb->congure) {
+        int32_t interval = tcb->congure->driver->inter_msg_interval(tcb->congure, size);
+
+        if (interval > 0) {
+            return interval / US_PER_MS;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reports that a new segment was sent.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     size   Sequence number consumption of the segment.
+ */
+static inline void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, unsigned size)
+{
+    if (tcb->congure) {
+        tcb->congure->driver->report_msg_sent(tcb->congure, size);
+    }
+}
+
+/**
+ * @brief Reports that a segment was dropped from the retransmission queue.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     size   Sequence number consumption of the segment.
+ */
+static inline void _gnrc_tcp_congure_discarded(gnrc_tcp_tcb_t *tcb, unsigned size)
+{
+    if (tcb->congure) {
+        tcb->congure->driver->report_msg_discarded(tcb->congure, size);
+    }
+}
+
+/**
+ * @brief Reports a received acknowledgement.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     seg       Newest segment acknowledged or, for a duplicate
+ *                          acknowledgement, the oldest unacknowledged segment.
+ * @param[in]     acked     Bytes newly acknowledged, zero for a duplicate.
+ * @param[in]     seg_ack   Acknowledgement number of the received segment.
+ * @param[in]     seg_wnd   Window of the received segment.
+ * @param[in]     pay_len   Payload length of the received segment.
+ * @param[in]     clean     True if the received segment had neither SYN nor FIN set.
+ */
+static inline void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb,
+                                           const gnrc_tcp_retransmit_t *seg,
+                                           unsigned acked, uint32_t seg_ack,
+                                           uint32_t seg_wnd, uint16_t pay_len,
+                                           bool clean)
+{
+    if (tcb->congure) {
+        congure_snd_msg_t msg = {
+            .send_time = seg->send_time,
+            .size = acked,
+            .resends = seg->resends,
+        };
+        congure_snd_ack_t ack = {
+            .recv_time = evtimer_now_msec(),
+            .id = seg_ack,
+            .size = pay_len,
+            .wnd = (seg_wnd > CONGURE_WND_SIZE_MAX) ? CONGURE_WND_SIZE_MAX : seg_wnd,
+            .clean = clean,
+        };
+
+        tcb->congure->driver->report_msg_acked(tcb->congure, &msg, &ack);
+    }
+}
+
+/**
+ * @brief Reports that the retransmission timer expired.
+ *
+ * All segments in the retransmission queue are reported.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static inline void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->congure && (tcb->retransmit_numof > 0)) {
+        congure_snd_msg_t msgs[CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE];
+        clist_node_t list = { .next = NULL };
+
+        for (unsigned i = 0; i < tcb->retransmit_numof; i++) {
+            msgs[i].send_time = tcb->retransmit_queue[i].send_time;
+            msgs[i].size = _gnrc_tcp_pkt_get_seg_len(tcb->retransmit_queue[i].pkt);
+            msgs[i].resends = tcb->retransmit_queue[i].resends;
+            clist_rpush(&list, &msgs[i].super);
+        }
+        tcb->congure->driver->report_msgs_timeout(tcb->congure,
+                                                  (congure_snd_msg_t *)list.next);
+    }
+}
+#else
+static inline void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline bool _gnrc_tcp_congure_used(const gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+    return false;
+}
+
+static inline uint32_t _gnrc_tcp_congure_cwnd(const gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+    return UINT32_MAX;
+}
+
+static inline uint32_t _gnrc_tcp_congure_pacing_ms(gnrc_tcp_tcb_t *tcb, unsigned size)
+{
+    (void)tcb;
+    (void)size;
+    return 0;
+}
+
+static inline void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, unsigned size)
+{
+    (void)tcb;
+    (void)size;
+}
+
+static inline void _gnrc_tcp_congure_discarded(gnrc_tcp_tcb_t *tcb, unsigned size)
+{
+    (void)tcb;
+    (void)size;
+}
+
+static inline void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb,
+                                           const gnrc_tcp_retransmit_t *seg,
+                                           unsigned acked, uint32_t seg_ack,
+                                           uint32_t seg_wnd, uint16_t pay_len,
+                                           bool clean)
+{
+    (void)tcb;
+    (void)seg;
+    (void)acked;
+    (void)seg_ack;
+    (void)seg_wnd;
+    (void)pay_len;
+    (void)clean;
+}
+
+static inline void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_CONGURE_H */
+/** @} */
@@ -20,6 +20,7 @@
 #ifndef GNRC_TCP_OPTION_H
 #define GNRC_TCP_OPTION_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "assert.h"
 #include "net/tcp.h"
@@ -29,6 +30,51 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Option flags in gnrc_tcp_tcb_t::options.
+ *
+ * A flag is set when the peer sent the option in its SYN. As the option is
+ * only sent if enabled, a flag set after the handshake means the option is
+ * in use.
+ * @{
+ */
+#define GNRC_TCP_OPTION_SACK    (1 << 0)   /**< SACK permitted (RFC 2018) */
+#define GNRC_TCP_OPTION_TS      (1 << 1)   /**< Timestamps (RFC 7323) */
+#define GNRC_TCP_OPTION_WS      (1 << 2)   /**< Window scaling (RFC 7323) */
+/** @} */
+
+/**
+ * @brief Maximum size of the option field in bytes.
+ */
+#define GNRC_TCP_OPTION_SIZE_MAX ((TCP_HDR_OFFSET_MAX - TCP_HDR_OFFSET_MIN) * 4)
+
+/**
+ * @brief Maximum number of blocks in a SACK option.
+ */
+#define GNRC_TCP_SACK_BLOCKS_MAX (4U)
+
+/**
+ * @brief Block of data reported in a SACK option.
+ */
+typedef struct {
+    uint32_t left;    /**< First sequence number of the block */
+    uint32_t right;   /**< Sequence number following the block */
+} _gnrc_tcp_sack_block_t;
+
+/**
+ * @brief Options of a received segment.
+ */
+typedef struct {
+    uint16_t mss;           /**< MSS of the peer, zero if not present */
+    uint8_t syn_options;    /**< Option flags of the options valid in a SYN */
+    uint8_t wscale;         /**< Window scale of the peer */
+    bool ts;                /**< Timestamps option present */
+    uint32_t ts_val;        /**< Timestamp value of the peer */
+    uint32_t ts_ecr;        /**< Timestamp echoed by the peer */
+    uint8_t sack_numof;     /**< Number of blocks in @p sack */
+    _gnrc_tcp_sack_block_t sack[GNRC_TCP_SACK_BLOCKS_MAX]; /**< SACK blocks */
+} _gnrc_tcp_option_t;
+
 /**
  * @brief Helper function to build the MSS option.
  *
@@ -56,16 +102,59 @@ static inline uint16_t _gnrc_tcp_option_build_offset_control(uint16_t nopts, uin
     return (nopts << 12) | ctl;
 }
 
+/**
+ * @brief Get the window scale to announce for the receive buffer.
+ *
+ * @returns   Smallest shift count that makes the receive buffer size fit into
+ *            the 16 bit window field of the TCP header.
+ */
+uint8_t _gnrc_tcp_option_rcv_wscale(void);
+
 /**
  * @brief Parses options of a given TCP header.
  *
- * @param[in,out] tcb   TCB holding the connection information.
- * @param[in]     hdr   TCP header to be parsed.
+ * The connection is not touched, options negotiated in a SYN are applied by
+ * _gnrc_tcp_option_negotiate() once the SYN was accepted.
+ *
+ * @param[in]  hdr    TCP header to be parsed.
+ * @param[out] opts   Options of @p hdr.
  *
  * @returns   Zero on success.
  *            Negative value on error.
  */
-int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
+int _gnrc_tcp_option_parse(tcp_hdr_t *hdr, _gnrc_tcp_option_t *opts);
+
+/**
+ * @brief Applies the options negotiated by an accepted SYN to a connection.
+ *
+ * Must only be called for a SYN received in LISTEN or SYN_SENT, options of
+ * a former negotiation are dropped.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     opts   Options of the SYN, parsed by _gnrc_tcp_option_parse().
+ */
+void _gnrc_tcp_option_negotiate(gnrc_tcp_tcb_t *tcb, const _gnrc_tcp_option_t *opts);
+
+/**
+ * @brief Builds the option field for an outgoing segment.
+ *
+ * @param[in]  tcb   TCB holding the connection information.
+ * @param[out] buf   Buffer for the option field, must hold at least
+ *                   GNRC_TCP_OPTION_SIZE_MAX bytes.
+ * @param[in]  ctl   Control bits of the outgoing segment.
+ *
+ * @returns   Size of the option field in bytes, a multiple of four.
+ */
+uint8_t _gnrc_tcp_option_build(const gnrc_tcp_tcb_t *tcb, uint8_t *buf,
+                               uint16_t ctl);
+
+/**
+ * @brief Refreshes the timestamps option of a segment to be retransmitted.
+ *
+ * @param[in]     tcb   TCB holding the connection information.
+ * @param[in,out] hdr   TCP header of the segment.
+ */
+void _gnrc_tcp_option_refresh_ts(const gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
 
 #ifdef __cplusplus
 }
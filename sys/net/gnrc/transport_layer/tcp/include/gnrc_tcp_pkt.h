@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include "net/gnrc.h"
 #include "net/gnrc/tcp/tcb.h"
+#include "gnrc_tcp_option.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,25 +114,63 @@ uint32_t _gnrc_tcp_pkt_get_pay_len(gnrc_pktsnip_t *pkt);
  *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
- * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
+ * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit
+ *                             of the oldest packet after a timeout.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or not the oldest packet on retransmit.
  */
 int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
                                    const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Resends the oldest packet of the retransmission queue without timer backoff.
  *
  * @param[in,out] tcb   TCB holding the connection information.
- * @param[in]     ack   Acknowldegment number used to acknowledge packets.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if the retransmission queue is empty.
+ */
+int _gnrc_tcp_pkt_resend_oldest(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Marks segments of the retransmission queue as selectively acknowledged.
+ *
+ * Does nothing unless SACK was negotiated for the connection.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     opts   Options of the received segment, holding the SACK blocks.
+ */
+void _gnrc_tcp_pkt_sack_update(gnrc_tcp_tcb_t *tcb, const _gnrc_tcp_option_t *opts);
+
+/**
+ * @brief Resends the oldest segment that is considered lost because of SACKs.
+ *
+ * A segment is considered lost if it was not resent yet and enough later
+ * segments were selectively acknowledged, see IsLost() in RFC 6675.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Index of the resent segment in the retransmission queue.
+ *            -ENODATA if no segment is considered lost.
+ */
+int _gnrc_tcp_pkt_sack_recover(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     ack    Acknowldegment number used to acknowledge packets.
+ * @param[in]     wnd    Unscaled window of the acknowledging segment.
+ * @param[in]     opts   Options of the acknowledging segment. The echoed
+ *                       timestamp is used for RTT measurements.
  *
  * @returns   Zero on success.
  *            -ENODATA if there is nothing to acknowledge.
  */
-int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
+int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack,
+                              const uint32_t wnd, const _gnrc_tcp_option_t *opts);
 
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
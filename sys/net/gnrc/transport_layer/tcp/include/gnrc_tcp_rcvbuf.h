@@ -20,6 +20,8 @@
 #ifndef GNRC_TCP_RCVBUF_H
 #define GNRC_TCP_RCVBUF_H
 
+#include <stdint.h>
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -44,10 +46,42 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 /**
  * @brief Release allocated receive buffer.
  *
+ * Out-of-order segments of @p tcb are released as well.
+ *
  * @param[in,out] tcb   TCB holding the receive buffer that should be released.
  */
 void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Keep a segment that was received out of order.
+ *
+ * The segment is held until the data in front of it was received, see
+ * _gnrc_tcp_rcvbuf_ooo_drain(). Does nothing without module gnrc_tcp_sack.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     pkt   Received segment.
+ * @param[in]     seq   Sequence number of the segment.
+ * @param[in]     len   Payload length of the segment.
+ *
+ * @returns   Zero on success.
+ *            -EALREADY if a segment with @p seq is kept already.
+ *            -ENOSPC if the segment exceeds the receive window.
+ *            -ENOMEM if the out-of-order queue is full.
+ *            -ENOTSUP without module gnrc_tcp_sack.
+ */
+int _gnrc_tcp_rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                             uint32_t seq, uint32_t len);
+
+/**
+ * @brief Move out-of-order segments that became in order into the receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information. rcv_nxt is
+ *                      advanced by the data moved.
+ *
+ * @returns   Number of bytes moved into the receive buffer.
+ */
+uint32_t _gnrc_tcp_rcvbuf_ooo_drain(gnrc_tcp_tcb_t *tcb);
+
 #ifdef __cplusplus
 }
 #endif
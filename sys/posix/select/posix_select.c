@@ -73,7 +73,7 @@ int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
 {
     uint32_t start_time = xtimer_now_usec();
     fd_set ret_readfds;
-    xtimer_t timeout_timer;
+    xtimer_t timeout_timer = { 0 };
     int fds_set = 0;
     bool wait = true;
 
@@ -20,44 +20,164 @@
  * @}
  */
 
+#include <errno.h>
+#include <inttypes.h>
 #include <stdio.h>
 
+#include "cpu.h"
 #include "irq.h"
+#include "msg.h"
+#include "periph_conf.h"
+#include "sched.h"
+#include "stdio_base.h"
+#include "thread.h"
+#include "timex.h"
+#include "trace.h"
+
+#ifdef CPU_NATIVE
+#include <fcntl.h>
+#include <time.h>
+#include "native_internal.h"
+#elif !defined(DWT_CTRL_CYCCNTENA_Msk)
 #include "xtimer.h"
+#endif
 
 #ifndef CONFIG_TRACE_BUFSIZE
 #define CONFIG_TRACE_BUFSIZE 512
 #endif
 
-typedef struct {
-    uint32_t time;
-    uint32_t val;
-} tracebuf_entry_t;
+#if defined(CPU_NATIVE)
+#define TRACE_FREQ      (NS_PER_SEC)
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+#ifdef CLOCK_CORECLOCK
+#define TRACE_FREQ      (CLOCK_CORECLOCK)
+#else
+#define TRACE_FREQ      (0)
+#endif
+#else
+#define TRACE_FREQ      (US_PER_SEC)
+#endif
+
+static trace_entry_t tracebuf[CONFIG_TRACE_BUFSIZE];
+/* next entry to write */
+static unsigned tracebuf_pos;
+/* number of entries not exported yet */
+static unsigned tracebuf_fill;
+/* number of entries overwritten before they were exported */
+static uint32_t tracebuf_lost;
 
-static tracebuf_entry_t tracebuf[CONFIG_TRACE_BUFSIZE];
-static size_t tracebuf_pos;
+static inline uint32_t _now(void)
+{
+#if defined(CPU_NATIVE)
+    struct timespec ts;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * NS_PER_SEC + ts.tv_nsec;
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+    return DWT->CYCCNT;
+#else
+    return xtimer_now_usec();
+#endif
+}
+
+#if IS_USED(MODULE_TRACE_SCHED)
+static void _sched_cb(kernel_pid_t active, kernel_pid_t next)
+{
+    if (next == KERNEL_PID_UNDEF) {
+        trace_sched(TRACE_EVENT_SCHED_OUT, active);
+    }
+    else {
+        trace_sched(TRACE_EVENT_SCHED_IN, next);
+    }
+}
+#endif
+
+void trace_init(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && !defined(CPU_NATIVE)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+#if IS_USED(MODULE_TRACE_SCHED)
+    sched_register_cb(_sched_cb);
+#endif
+}
 
-void trace(uint32_t val)
+void trace_event(uint16_t event, uint32_t arg)
 {
     unsigned state = irq_disable();
+    trace_entry_t *entry = &tracebuf[tracebuf_pos];
 
-    tracebuf[tracebuf_pos % CONFIG_TRACE_BUFSIZE] =
-        (tracebuf_entry_t){ .time = xtimer_now_usec(), .val = val };
-    tracebuf_pos++;
+    entry->time = _now();
+    entry->event = event;
+    entry->pid = irq_is_in() ? KERNEL_PID_ISR : thread_getpid();
+    entry->arg = arg;
+    if (++tracebuf_pos == CONFIG_TRACE_BUFSIZE) {
+        tracebuf_pos = 0;
+    }
+    if (tracebuf_fill < CONFIG_TRACE_BUFSIZE) {
+        tracebuf_fill++;
+    }
+    else {
+        tracebuf_lost++;
+    }
     irq_restore(state);
 }
 
+static unsigned _oldest(void)
+{
+    return (tracebuf_pos + CONFIG_TRACE_BUFSIZE - tracebuf_fill) %
+           CONFIG_TRACE_BUFSIZE;
+}
+
+static const char *_event_name(uint16_t event)
+{
+    static const char *names[] = {
+        [TRACE_EVENT_LOST] = "lost",
+        [TRACE_EVENT_SCHED_OUT] = "sched_out",
+        [TRACE_EVENT_SCHED_IN] = "sched_in",
+        [TRACE_EVENT_ISR_ENTER] = "isr_enter",
+        [TRACE_EVENT_ISR_EXIT] = "isr_exit",
+        [TRACE_EVENT_MUTEX_LOCK] = "mutex_lock",
+        [TRACE_EVENT_MUTEX_LOCKED] = "mutex_locked",
+        [TRACE_EVENT_MUTEX_UNLOCK] = "mutex_unlock",
+        [TRACE_EVENT_MSG_SEND] = "msg_send",
+        [TRACE_EVENT_MSG_RECEIVE] = "msg_receive",
+        [TRACE_EVENT_NETAPI_DISPATCH] = "netapi_dispatch",
+        [TRACE_EVENT_NETAPI_SEND] = "netapi_send",
+    };
+
+    if ((event < ARRAY_SIZE(names)) && (names[event] != NULL)) {
+        return names[event];
+    }
+    return "app";
+}
+
 void trace_dump(void)
 {
-    size_t n = tracebuf_pos >
-               CONFIG_TRACE_BUFSIZE ? CONFIG_TRACE_BUFSIZE : tracebuf_pos;
+    unsigned state = irq_disable();
+    unsigned pos = _oldest();
+    size_t n = tracebuf_fill;
     uint32_t t_last = 0;
 
+    irq_restore(state);
+
     for (size_t i = 0; i < n; i++) {
-        printf("n=%4lu t=%s%8" PRIu32 " v=0x%08lx\n", (unsigned long)i,
+        trace_entry_t *entry = &tracebuf[pos];
+
+        printf("n=%4lu t=%s%8" PRIu32 " v=0x%08lx", (unsigned long)i,
                i ? "+" : " ",
-               tracebuf[i].time - t_last, (unsigned long)tracebuf[i].val);
-        t_last = tracebuf[i].time;
+               entry->time - t_last, (unsigned long)entry->arg);
+        if (entry->event != TRACE_EVENT_USER) {
+            printf(" e=%s(0x%04x) pid=%d", _event_name(entry->event),
+                   entry->event, entry->pid);
+        }
+        puts("");
+        t_last = entry->time;
+        if (++pos == CONFIG_TRACE_BUFSIZE) {
+            pos = 0;
+        }
     }
 }
 
@@ -66,5 +186,94 @@ void trace_reset(void)
     unsigned state = irq_disable();
 
     tracebuf_pos = 0;
+    tracebuf_fill = 0;
+    tracebuf_lost = 0;
+    irq_restore(state);
+}
+
+/* takes the oldest entry out of the buffer, lost entries come first */
+static void _pop(trace_entry_t *entry)
+{
+    unsigned state = irq_disable();
+
+    /* an empty buffer only happens if trace_reset() was called meanwhile */
+    if (tracebuf_lost || !tracebuf_fill) {
+        /* keep timestamps in order: the gap is right before the oldest
+         * entry left */
+        *entry = (trace_entry_t){
+            .time = tracebuf_fill ? tracebuf[_oldest()].time : _now(),
+            .event = TRACE_EVENT_LOST,
+            .pid = KERNEL_PID_UNDEF,
+            .arg = tracebuf_lost,
+        };
+        tracebuf_lost = 0;
+    }
+    else {
+        *entry = tracebuf[_oldest()];
+        tracebuf_fill--;
+    }
     irq_restore(state);
 }
+
+int trace_export(trace_write_t write, void *ctx)
+{
+    unsigned state = irq_disable();
+    trace_hdr_t hdr = {
+        .magic = TRACE_MAGIC,
+        .version = TRACE_VERSION,
+        .entry_size = sizeof(trace_entry_t),
+        .freq = TRACE_FREQ,
+        .numof = tracebuf_fill + (tracebuf_lost ? 1 : 0),
+    };
+    irq_restore(state);
+
+    ssize_t res = write(ctx, &hdr, sizeof(hdr));
+    if (res < 0) {
+        return res;
+    }
+    /* Entries recorded in the meantime may overwrite older ones. Then
+     * _pop() yields a TRACE_EVENT_LOST entry and newer ones instead, so
+     * there are always enough entries for the header's numof. */
+    for (uint32_t i = 0; i < hdr.numof; i++) {
+        trace_entry_t entry;
+
+        _pop(&entry);
+        res = write(ctx, &entry, sizeof(entry));
+        if (res < 0) {
+            return res;
+        }
+    }
+    return hdr.numof;
+}
+
+static ssize_t _write_stdio(void *ctx, const void *data, size_t len)
+{
+    (void)ctx;
+    return stdio_write(data, len);
+}
+
+int trace_export_stdio(void)
+{
+    return trace_export(_write_stdio, NULL);
+}
+
+#ifdef CPU_NATIVE
+static ssize_t _write_file(void *ctx, const void *data, size_t len)
+{
+    ssize_t res = real_write(*(int *)ctx, data, len);
+
+    return (res < 0) ? -errno : res;
+}
+
+int trace_export_file(const char *path)
+{
+    int fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        return -errno;
+    }
+    int res = trace_export(_write_file, &fd);
+    real_close(fd);
+    return res;
+}
+#endif
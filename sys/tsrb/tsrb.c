@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "irq.h"
 #include "tsrb.h"
 
@@ -30,6 +32,17 @@ static uint8_t _pop(tsrb_t *rb)
     return rb->buf[rb->reads++ & (rb->size - 1)];
 }
 
+/* the following helpers expect interrupts to be disabled */
+static size_t _avail(const tsrb_t *rb)
+{
+    return rb->writes - rb->reads;
+}
+
+static size_t _free(const tsrb_t *rb)
+{
+    return rb->size - _avail(rb);
+}
+
 int tsrb_get_one(tsrb_t *rb)
 {
     int retval = -1;
@@ -43,26 +56,33 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t tmp = n;
     unsigned irq_state = irq_disable();
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    unsigned pos = rb->reads & (rb->size - 1);
+
+    if (n > _avail(rb)) {
+        n = _avail(rb);
     }
+    if (n > rb->size - pos) {
+        memcpy(dst, &rb->buf[pos], rb->size - pos);
+        memcpy(dst + (rb->size - pos), rb->buf, n - (rb->size - pos));
+    }
+    else {
+        memcpy(dst, &rb->buf[pos], n);
+    }
+    rb->reads += n;
     irq_restore(irq_state);
-    return (n - tmp);
+    return n;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
     unsigned irq_state = irq_disable();
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
+    if (n > _avail(rb)) {
+        n = _avail(rb);
     }
+    rb->reads += n;
     irq_restore(irq_state);
-    return (n - tmp);
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, uint8_t c)
@@ -79,12 +99,50 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c)
 
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n)
 {
-    size_t tmp = n;
     unsigned irq_state = irq_disable();
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    unsigned pos = rb->writes & (rb->size - 1);
+
+    if (n > _free(rb)) {
+        n = _free(rb);
+    }
+    if (n > rb->size - pos) {
+        memcpy(&rb->buf[pos], src, rb->size - pos);
+        memcpy(rb->buf, src + (rb->size - pos), n - (rb->size - pos));
     }
+    else {
+        memcpy(&rb->buf[pos], src, n);
+    }
+    rb->writes += n;
+    irq_restore(irq_state);
+    return n;
+}
+
+size_t tsrb_peek_contiguous(tsrb_t *rb, const uint8_t **data)
+{
+    unsigned irq_state = irq_disable();
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t n = _avail(rb);
+
+    irq_restore(irq_state);
+    *data = &rb->buf[pos];
+    return (n > rb->size - pos) ? rb->size - pos : n;
+}
+
+size_t tsrb_reserve_contiguous(tsrb_t *rb, uint8_t **data)
+{
+    unsigned irq_state = irq_disable();
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t n = _free(rb);
+
+    irq_restore(irq_state);
+    *data = &rb->buf[pos];
+    return (n > rb->size - pos) ? rb->size - pos : n;
+}
+
+void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    unsigned irq_state = irq_disable();
+    assert(n <= _free(rb));
+    rb->writes += n;
     irq_restore(irq_state);
-    return (n - tmp);
 }
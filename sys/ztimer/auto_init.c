@@ -277,6 +277,10 @@ void ztimer_init(void)
               CONFIG_ZTIMER_USEC_ADJUST_SLEEP );
     ZTIMER_USEC->adjust_sleep = CONFIG_ZTIMER_USEC_ADJUST_SLEEP;
 #  endif
+#  if IS_USED(MODULE_ZTIMER_HEAP) && CONFIG_ZTIMER_USEC_HEAP
+    LOG_DEBUG("ztimer_init(): ZTIMER_USEC using pairing heap\n");
+    ztimer_clock_use_heap(ZTIMER_USEC);
+#  endif
 #endif
 
 #if MODULE_ZTIMER_MSEC
@@ -291,6 +295,10 @@ void ztimer_init(void)
               CONFIG_ZTIMER_MSEC_ADJUST);
     ZTIMER_MSEC->adjust = CONFIG_ZTIMER_MSEC_ADJUST;
 #  endif
+#  if IS_USED(MODULE_ZTIMER_HEAP) && CONFIG_ZTIMER_MSEC_HEAP
+    LOG_DEBUG("ztimer_init(): ZTIMER_MSEC using pairing heap\n");
+    ztimer_clock_use_heap(ZTIMER_MSEC);
+#  endif
 #endif
 
 #if MODULE_ZTIMER_SEC
@@ -300,6 +308,10 @@ void ztimer_init(void)
     ztimer_convert_frac_init(&_ztimer_convert_frac_sec, ZTIMER_SEC_BASE,
                              FREQ_1HZ, ZTIMER_SEC_CONVERT_LOWER_FREQ);
 #  endif
+#  if IS_USED(MODULE_ZTIMER_HEAP) && CONFIG_ZTIMER_SEC_HEAP
+    LOG_DEBUG("ztimer_init(): ZTIMER_SEC using pairing heap\n");
+    ztimer_clock_use_heap(ZTIMER_SEC);
+#  endif
 #endif
 }
 #endif /* IS_USED(MODULE_AUTO_INIT_ZTIMER) */
@@ -23,6 +23,7 @@
  * @}
  */
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <inttypes.h>
 
@@ -48,8 +49,189 @@ static inline uint32_t _min_u32(uint32_t a, uint32_t b)
 }
 #endif
 
+static inline bool _uses_heap(const ztimer_clock_t *clock)
+{
+#ifdef MODULE_ZTIMER_HEAP
+    return clock->use_heap;
+#else
+    (void)clock;
+    return false;
+#endif
+}
+
+/* relative offset of the first timer to the clock's base (list.offset) */
+static inline uint32_t _head_offset(const ztimer_clock_t *clock)
+{
+    if (_uses_heap(clock)) {
+        return clock->list.next->offset - clock->list.offset;
+    }
+    return clock->list.next->offset;
+}
+
+#ifdef MODULE_ZTIMER_HEAP
+/*
+ * Pairing heap implementation
+ *
+ * In heap mode, clock->list.next points to the root of the heap and every entry
+ * stores its absolute target time in "offset". As all targets lie within 2^32
+ * ticks from the clock's base (clock->list.offset), targets are compared by
+ * their distance to that base. ztimer_update_head_offset() makes sure that the
+ * base never overtakes a pending target, by clamping expired targets to the new
+ * base, just like the list clamps their offsets to zero.
+ *
+ * A set entry always has a non-NULL "prev" pointer: the root points to the
+ * clock's list head, all other entries to their parent (if they are the first
+ * child) or to their previous sibling. An unset entry has its links cleared,
+ * so "prev" doubles as the flag telling whether the entry is set, and
+ * _is_set() never follows the links of an entry. This relies on timers being
+ * zero-initialized before their first use, as documented for ztimer_t.
+ */
+static inline bool _heap_before(const ztimer_clock_t *clock,
+                                const ztimer_base_t *a, const ztimer_base_t *b)
+{
+    return (a->offset - clock->list.offset) < (b->offset - clock->list.offset);
+}
+
+static ztimer_base_t *_heap_meld(const ztimer_clock_t *clock,
+                                 ztimer_base_t *a, ztimer_base_t *b)
+{
+    if (_heap_before(clock, b, a)) {
+        ztimer_base_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* standard two-pass pairing of a sibling list */
+static ztimer_base_t *_heap_merge_pairs(const ztimer_clock_t *clock,
+                                        ztimer_base_t *first)
+{
+    ztimer_base_t *pairs = NULL;
+
+    /* first pass: meld pairs from left to right, collect them reversed */
+    while (first) {
+        ztimer_base_t *a = first;
+        ztimer_base_t *b = a->next;
+        if (b) {
+            first = b->next;
+            a = _heap_meld(clock, a, b);
+        }
+        else {
+            first = NULL;
+        }
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* second pass: meld the pairs from right to left */
+    ztimer_base_t *root = pairs;
+    if (root) {
+        pairs = root->next;
+        while (pairs) {
+            ztimer_base_t *next = pairs->next;
+            root = _heap_meld(clock, root, pairs);
+            pairs = next;
+        }
+        root->next = NULL;
+    }
+    return root;
+}
+
+static void _heap_set_root(ztimer_clock_t *clock, ztimer_base_t *root)
+{
+    clock->list.next = root;
+    if (root) {
+        root->next = NULL;
+        root->prev = &clock->list;
+    }
+}
+
+static void _heap_insert(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    entry->child = NULL;
+    entry->next = NULL;
+    if (clock->list.next) {
+        _heap_set_root(clock, _heap_meld(clock, clock->list.next, entry));
+    }
+    else {
+        _heap_set_root(clock, entry);
+    }
+}
+
+static void _heap_remove(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    /* fails for timers that were not zero-initialized before their first use */
+    assert((entry == clock->list.next) || (entry->prev->child == entry) ||
+           (entry->prev->next == entry));
+
+    ztimer_base_t *sub = _heap_merge_pairs(clock, entry->child);
+
+    if (entry == clock->list.next) {
+        _heap_set_root(clock, sub);
+    }
+    else {
+        /* unlink entry (and with it its subtree) from its sibling list */
+        if (entry->prev->child == entry) {
+            entry->prev->child = entry->next;
+        }
+        else {
+            entry->prev->next = entry->next;
+        }
+        if (entry->next) {
+            entry->next->prev = entry->prev;
+        }
+        if (sub) {
+            _heap_set_root(clock, _heap_meld(clock, clock->list.next, sub));
+        }
+    }
+
+    /* reset the entry so _is_set() considers it unset */
+    entry->next = NULL;
+    entry->child = NULL;
+    entry->prev = NULL;
+}
+
+static void _heap_update_head_offset(ztimer_clock_t *clock, uint32_t now)
+{
+    uint32_t diff = now - clock->list.offset;
+    ztimer_base_t *expired = NULL;
+
+    /* take out all timers whose target has passed ... */
+    while (clock->list.next &&
+           (clock->list.next->offset - clock->list.offset) < diff) {
+        ztimer_base_t *entry = clock->list.next;
+        _heap_remove(clock, entry);
+        entry->next = expired;
+        expired = entry;
+    }
+
+    clock->list.offset = now;
+
+    /* ... and re-insert them with their target clamped to now */
+    while (expired) {
+        ztimer_base_t *entry = expired;
+        expired = entry->next;
+        entry->offset = now;
+        _heap_insert(clock, entry);
+    }
+}
+#endif /* MODULE_ZTIMER_HEAP */
+
 static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 {
+#ifdef MODULE_ZTIMER_HEAP
+    if (_uses_heap(clock)) {
+        return t->base.prev != NULL;
+    }
+#endif
     if (!clock->list.next) {
         return 0;
     }
@@ -130,6 +312,16 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
     }
 #endif
 
+#ifdef MODULE_ZTIMER_HEAP
+    if (_uses_heap(clock)) {
+        entry->offset += clock->list.offset;
+        _heap_insert(clock, entry);
+        DEBUG("_add_entry_to_list() %p target %" PRIu32 "\n", (void *)entry,
+              entry->offset);
+        return;
+    }
+#endif
+
     /* Jump past all entries which are set to an earlier target than the new entry */
     while (list->next) {
         ztimer_base_t *list_entry = list->next;
@@ -197,6 +389,12 @@ void ztimer_update_head_offset(ztimer_clock_t *clock)
     DEBUG(
         "clock %p: ztimer_update_head_offset(): diff=%" PRIu32 " old head %p\n",
         (void *)clock, diff, (void *)entry);
+#ifdef MODULE_ZTIMER_HEAP
+    if (_uses_heap(clock)) {
+        _heap_update_head_offset(clock, now);
+        return;
+    }
+#endif
     if (entry) {
         do {
             if (diff <= entry->offset) {
@@ -235,6 +433,19 @@ static void _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 
     assert(_is_set(clock, (ztimer_t *)entry));
 
+#ifdef MODULE_ZTIMER_HEAP
+    if (_uses_heap(clock)) {
+        _heap_remove(clock, entry);
+#ifdef MODULE_PM_LAYERED
+        if (clock->list.next == NULL &&
+            clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+            pm_unblock(clock->block_pm_mode);
+        }
+#endif
+        return;
+    }
+#endif
+
     while (list->next) {
         ztimer_base_t *list_entry = list->next;
         if (list_entry == entry) {
@@ -270,6 +481,22 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
 {
     ztimer_base_t *entry = clock->list.next;
 
+#ifdef MODULE_ZTIMER_HEAP
+    if (_uses_heap(clock)) {
+        if (!entry || (entry->offset != clock->list.offset)) {
+            return NULL;
+        }
+        _heap_remove(clock, entry);
+#ifdef MODULE_PM_LAYERED
+        if (!clock->list.next &&
+            clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+            pm_unblock(clock->block_pm_mode);
+        }
+#endif
+        return (ztimer_t *)entry;
+    }
+#endif
+
     if (entry && (entry->offset == 0)) {
         clock->list.next = entry->next;
         if (!entry->next) {
@@ -298,7 +525,7 @@ static void _ztimer_update(ztimer_clock_t *clock)
     if (clock->max_value < UINT32_MAX) {
         if (clock->list.next) {
             clock->ops->set(clock,
-                            _min_u32(clock->list.next->offset,
+                            _min_u32(_head_offset(clock),
                                      clock->max_value >> 1));
         }
         else {
@@ -310,7 +537,7 @@ static void _ztimer_update(ztimer_clock_t *clock)
     }
     else {
         if (clock->list.next) {
-            clock->ops->set(clock, clock->list.next->offset);
+            clock->ops->set(clock, _head_offset(clock));
         }
         else {
             if (IS_USED(MODULE_ZTIMER_NOW64)) {
@@ -338,7 +565,7 @@ void ztimer_handler(ztimer_clock_t *clock)
         uint32_t now = ztimer_now(clock);
 
         if (clock->list.next) {
-            uint32_t target = clock->list.offset + clock->list.next->offset;
+            uint32_t target = clock->list.offset + _head_offset(clock);
             int32_t diff = (int32_t)(target - now);
             if (diff > 0) {
                 DEBUG("ztimer_handler(): %p postponing by %" PRIi32 "\n",
@@ -362,8 +589,14 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 #endif
 
-    clock->list.offset += clock->list.next->offset;
-    clock->list.next->offset = 0;
+    if (_uses_heap(clock)) {
+        /* the head's absolute target becomes the new base */
+        clock->list.offset = clock->list.next->offset;
+    }
+    else {
+        clock->list.offset += clock->list.next->offset;
+        clock->list.next->offset = 0;
+    }
 
     ztimer_t *entry = _now_next(clock);
     while (entry) {
@@ -395,6 +628,16 @@ static void _ztimer_print(const ztimer_clock_t *clock)
     const ztimer_base_t *entry = &clock->list;
     uint32_t last_offset = 0;
 
+    if (_uses_heap(clock)) {
+        printf("0x%08x:%" PRIu32 " heap root 0x%08x", (unsigned)entry,
+               entry->offset, (unsigned)entry->next);
+        if (entry->next) {
+            printf(" target %" PRIu32, entry->next->offset);
+        }
+        puts("");
+        return;
+    }
+
     do {
         printf("0x%08x:%" PRIu32 "(%" PRIu32 ")%s", (unsigned)entry,
                entry->offset, entry->offset +
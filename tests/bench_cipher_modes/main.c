@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of the block cipher modes with AES-128
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "crypto/modes/gcm.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL)
+#endif
+
+#define BUF_SIZE            (1024U)
+#define MAC_LEN             (8U)
+#define LENGTH_ENCODING     (2U)
+
+typedef struct {
+    const char *name;
+    int (*func)(void);
+    bool decrypt;           /**< output must equal the plaintext */
+} bench_mode_t;
+
+static const uint8_t _key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t _nonce[13] = {
+    0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+    0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+};
+static const uint8_t _adata[8] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+};
+
+static cipher_t _cipher;
+static uint8_t _plain[BUF_SIZE];
+static uint8_t _encrypted[BUF_SIZE + GCM_MAC_MAX_LEN];
+static uint8_t _decrypted[BUF_SIZE];
+
+static int _ecb_encrypt(void)
+{
+    return cipher_encrypt_ecb(&_cipher, _plain, BUF_SIZE, _encrypted);
+}
+
+static int _ecb_decrypt(void)
+{
+    return cipher_decrypt_ecb(&_cipher, _encrypted, BUF_SIZE, _decrypted);
+}
+
+static int _cbc_encrypt(void)
+{
+    uint8_t iv[16] = { 0 };
+    return cipher_encrypt_cbc(&_cipher, iv, _plain, BUF_SIZE, _encrypted);
+}
+
+static int _cbc_decrypt(void)
+{
+    uint8_t iv[16] = { 0 };
+    return cipher_decrypt_cbc(&_cipher, iv, _encrypted, BUF_SIZE, _decrypted);
+}
+
+static int _ctr_encrypt(void)
+{
+    uint8_t ctr[16] = { 0 };
+    return cipher_encrypt_ctr(&_cipher, ctr, 8, _plain, BUF_SIZE, _encrypted);
+}
+
+static int _ctr_decrypt(void)
+{
+    uint8_t ctr[16] = { 0 };
+    return cipher_decrypt_ctr(&_cipher, ctr, 8, _encrypted, BUF_SIZE,
+                              _decrypted);
+}
+
+static int _ccm_encrypt(void)
+{
+    return cipher_encrypt_ccm(&_cipher, _adata, sizeof(_adata), MAC_LEN,
+                              LENGTH_ENCODING, _nonce, sizeof(_nonce),
+                              _plain, BUF_SIZE, _encrypted);
+}
+
+static int _ccm_decrypt(void)
+{
+    return cipher_decrypt_ccm(&_cipher, _adata, sizeof(_adata), MAC_LEN,
+                              LENGTH_ENCODING, _nonce, sizeof(_nonce),
+                              _encrypted, BUF_SIZE + MAC_LEN, _decrypted);
+}
+
+static int _gcm_encrypt(void)
+{
+    return cipher_encrypt_gcm(&_cipher, _adata, sizeof(_adata),
+                              GCM_MAC_MAX_LEN, _nonce, GCM_NONCE_LEN,
+                              _plain, BUF_SIZE, _encrypted);
+}
+
+static int _gcm_decrypt(void)
+{
+    return cipher_decrypt_gcm(&_cipher, _adata, sizeof(_adata),
+                              GCM_MAC_MAX_LEN, _nonce, GCM_NONCE_LEN,
+                              _encrypted, BUF_SIZE + GCM_MAC_MAX_LEN,
+                              _decrypted);
+}
+
+static const bench_mode_t _modes[] = {
+    { "ecb encrypt", _ecb_encrypt, false },
+    { "ecb decrypt", _ecb_decrypt, true },
+    { "cbc encrypt", _cbc_encrypt, false },
+    { "cbc decrypt", _cbc_decrypt, true },
+    { "ctr encrypt", _ctr_encrypt, false },
+    { "ctr decrypt", _ctr_decrypt, true },
+    { "ccm encrypt", _ccm_encrypt, false },
+    { "ccm decrypt", _ccm_decrypt, true },
+    { "gcm encrypt", _gcm_encrypt, false },
+    { "gcm decrypt", _gcm_decrypt, true },
+};
+
+static int _bench(const bench_mode_t *mode)
+{
+    uint32_t time = xtimer_now_usec();
+
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        if (mode->func() < 0) {
+            printf("error: %s failed\n", mode->name);
+            return -1;
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    if (mode->decrypt && memcmp(_decrypted, _plain, BUF_SIZE)) {
+        printf("error: %s: wrong plaintext\n", mode->name);
+        return -1;
+    }
+
+    uint64_t bytes = (uint64_t)BENCH_RUNS * BUF_SIZE * US_PER_SEC;
+    printf("%14s: %" PRIu32 " bytes/s\n", mode->name,
+           (uint32_t)(bytes / (time ? time : 1)));
+    return 0;
+}
+
+int main(void)
+{
+    puts("cipher modes benchmark\n");
+
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        _plain[i] = i;
+    }
+    if (cipher_init(&_cipher, CIPHER_AES_128, _key, sizeof(_key))
+            != CIPHER_INIT_SUCCESS) {
+        puts("error: cannot init cipher");
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_modes); i++) {
+        memset(_decrypted, 0, sizeof(_decrypted));
+        if (_bench(&_modes[i])) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
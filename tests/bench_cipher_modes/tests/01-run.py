@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+MODES = ("ecb encrypt", "ecb decrypt", "cbc encrypt", "cbc decrypt",
+         "ctr encrypt", "ctr decrypt", "ccm encrypt", "ccm decrypt",
+         "gcm encrypt", "gcm decrypt")
+
+
+def testfunc(child):
+    child.expect_exact('cipher modes benchmark')
+    for mode in MODES:
+        child.expect(r"\s+{}:\s+\d+ bytes/s".format(mode), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
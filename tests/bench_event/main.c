@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure events handled per second
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include "macros/units.h"
+#include "thread.h"
+
+#include "event.h"
+#include "xtimer.h"
+
+#ifndef BENCH_MODE_PINGPONG
+#define BENCH_MODE_PINGPONG (0)
+#endif
+
+#ifndef BENCH_MODE_DEADLINE
+#define BENCH_MODE_DEADLINE (0)
+#endif
+
+#ifndef TEST_DURATION_US
+#define TEST_DURATION_US    (1000000U)
+#endif
+
+#ifndef BENCH_BURST
+#define BENCH_BURST         (16U)
+#endif
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+
+static event_queue_t _queue;
+static event_t _events[BENCH_BURST];
+static uint32_t _handled;
+#if BENCH_MODE_DEADLINE
+static uint32_t _last_deadline;
+static uint32_t _misordered;
+#endif
+
+static void _timer_callback(void *flag)
+{
+    atomic_flag_clear(flag);
+}
+
+static void _handler(event_t *event)
+{
+    (void)event;
+    _handled++;
+#if BENCH_MODE_DEADLINE
+    /* deadlines grow from burst to burst, so they never decrease */
+    if (event->deadline < _last_deadline) {
+        _misordered++;
+    }
+    _last_deadline = event->deadline;
+#endif
+}
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_queue);
+    event_loop(&_queue);
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < BENCH_BURST; i++) {
+        _events[i].handler = _handler;
+    }
+    event_queue_init_detached(&_queue);
+
+    /* in burst mode, the handler thread only runs when main yields */
+    thread_create(_stack,
+                  sizeof(_stack),
+                  (THREAD_PRIORITY_MAIN - BENCH_MODE_PINGPONG),
+                  THREAD_CREATE_STACKTEST,
+                  _second_thread,
+                  NULL,
+                  "second_thread");
+    thread_yield();
+
+    atomic_flag flag = ATOMIC_FLAG_INIT;
+
+    xtimer_t timer = {
+        .callback = _timer_callback,
+        .arg = &flag,
+    };
+
+    atomic_flag_test_and_set(&flag);
+    xtimer_set(&timer, TEST_DURATION_US);
+
+#if BENCH_MODE_DEADLINE
+    uint32_t base = 0;
+#endif
+    while (atomic_flag_test_and_set(&flag)) {
+        for (unsigned i = 0; i < BENCH_BURST; i++) {
+#if BENCH_MODE_DEADLINE
+            /* scrambles the deadlines as long as 7 does not divide the burst */
+            event_post_deadline(&_queue, &_events[i],
+                                base + (i * 7) % BENCH_BURST);
+#else
+            event_post(&_queue, &_events[i]);
+#endif
+        }
+#if BENCH_MODE_DEADLINE
+        base += BENCH_BURST;
+#endif
+        thread_yield();
+    }
+
+    uint32_t n = _handled;
+
+    printf("{ \"result\" : %"PRIu32, n);
+#ifdef CLOCK_CORECLOCK
+    printf(", \"ticks\" : %"PRIu32,
+           (uint32_t)((TEST_DURATION_US/US_PER_MS) * (CLOCK_CORECLOCK/KHZ(1)))/n);
+#endif
+    puts(" }");
+
+#if BENCH_MODE_DEADLINE
+    if (_misordered) {
+        printf("error: %" PRIu32 " events handled out of order\n", _misordered);
+        return 1;
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Cost of matching responses with many concurrent gcoap requests
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#ifndef BENCH_REQS
+#define BENCH_REQS          (CONFIG_GCOAP_REQ_WAITING_MAX)
+#endif
+
+#define PEER_PORT           (CONFIG_GCOAP_PORT + 1)
+#define RESP_BUF_SIZE       (sizeof(coap_hdr_t) + GCOAP_TOKENLEN_MAX)
+
+typedef struct {
+    uint16_t mid;
+    uint8_t token_len;
+    uint8_t token[GCOAP_TOKENLEN_MAX];
+} req_t;
+
+static req_t _reqs[BENCH_REQS];
+static sock_udp_t _peer;
+static sock_udp_ep_t _peer_ep = { .family = AF_INET6, .port = PEER_PORT };
+static sock_udp_ep_t _gcoap_ep = { .family = AF_INET6,
+                                   .port = CONFIG_GCOAP_PORT };
+static unsigned _next;
+static unsigned _responses;
+static unsigned _errors;
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)remote;
+    if ((memo->state == GCOAP_MEMO_RESP)
+            && (coap_get_code_raw(pdu) == COAP_CODE_205)) {
+        _responses++;
+    }
+    else {
+        _errors++;
+    }
+}
+
+static void _request(void)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    req_t *req = &_reqs[_next++];
+
+    if (gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, "/bench")) {
+        _errors++;
+        return;
+    }
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+    ssize_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+
+    req->mid = coap_get_id(&pdu);
+    req->token_len = coap_get_token_len(&pdu);
+    memcpy(req->token, pdu.token, req->token_len);
+
+    if (gcoap_req_send(buf, len, &_peer_ep, _resp_handler, NULL) == 0) {
+        _errors++;
+    }
+}
+
+static void _respond(void)
+{
+    uint8_t buf[RESP_BUF_SIZE];
+    /* last request first, the worst case of a linear scan */
+    req_t *req = &_reqs[--_next];
+
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, req->token,
+                                 req->token_len, COAP_CODE_205, req->mid);
+    if (sock_udp_send(&_peer, buf, len, &_gcoap_ep) <= 0) {
+        _errors++;
+    }
+}
+
+int main(void)
+{
+    puts("gcoap request memo benchmark\n");
+
+    memcpy(&_peer_ep.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    memcpy(&_gcoap_ep.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    /* bind to the loopback address, so responses come from _peer_ep */
+    if (sock_udp_create(&_peer, &_peer_ep, NULL, 0) < 0) {
+        puts("error: cannot create peer sock");
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    BENCHMARK_FUNC("request", BENCH_REQS, _request());
+    BENCHMARK_FUNC("response", BENCH_REQS, _respond());
+
+    /* let gcoap handle the responses still queued */
+    xtimer_msleep(100);
+
+    if ((_errors > 0) || (_responses != BENCH_REQS)) {
+        printf("error: %u responses, %u errors\n", _responses, _errors);
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup cost of the NIB's forwarding table
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "byteorder.h"
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/ipv6/addr.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#ifndef BENCH_ROUTES_MAX
+#define BENCH_ROUTES_MAX    (1024U)
+#endif
+
+/* every SUBNET_INTERVAL-th route is a route to another /64 */
+#define SUBNET_INTERVAL     (16U)
+#define NEXT_HOP_NUMOF      (4U)
+#define IFACE               (6U)
+
+static const ipv6_addr_t _prefix = { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } };
+static const ipv6_addr_t _miss = { .u8 = { 0x20, 0x01, 0x0d, 0xb9 } };
+static const ipv6_addr_t _link_local = { .u8 = { 0xfe, 0x80 } };
+static unsigned _next;
+
+static bool _is_host(unsigned idx)
+{
+    return (idx % SUBNET_INTERVAL) != (SUBNET_INTERVAL - 1);
+}
+
+static unsigned _route(unsigned idx, ipv6_addr_t *dst, ipv6_addr_t *next_hop)
+{
+    *dst = _prefix;
+    if (_is_host(idx)) {
+        /* scramble the interface identifiers as they would be in practice */
+        dst->u32[2] = byteorder_htonl(0x02000000 | idx);
+        dst->u32[3] = byteorder_htonl(idx * 2654435761U);
+    }
+    else {
+        dst->u16[3] = byteorder_htons(idx);
+    }
+    if (next_hop != NULL) {
+        *next_hop = _link_local;
+        next_hop->u8[15] = 1 + (idx % NEXT_HOP_NUMOF);
+    }
+    return _is_host(idx) ? IPV6_ADDR_BIT_LEN : 64;
+}
+
+static int _lookup_hit(unsigned numof)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    ipv6_addr_t dst;
+
+    do {
+        _next = (_next + 1) % numof;
+    } while (!_is_host(_next));
+    _route(_next, &dst, NULL);
+    return gnrc_ipv6_nib_ft_get(&dst, NULL, &fte);
+}
+
+static int _lookup_miss(void)
+{
+    gnrc_ipv6_nib_ft_t fte;
+
+    return gnrc_ipv6_nib_ft_get(&_miss, NULL, &fte);
+}
+
+static int _bench(unsigned numof)
+{
+    ipv6_addr_t dst, next_hop;
+    gnrc_ipv6_nib_ft_t fte;
+    char name[32];
+    int res = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        unsigned dst_len = _route(i, &dst, &next_hop);
+
+        if (gnrc_ipv6_nib_ft_add(&dst, dst_len, &next_hop, IFACE, 0) < 0) {
+            printf("error: unable to add route %u\n", i);
+            res = -1;
+            goto out;
+        }
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        if (!_is_host(i)) {
+            continue;
+        }
+        _route(i, &dst, &next_hop);
+        if ((gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) < 0) ||
+            (fte.dst_len != IPV6_ADDR_BIT_LEN) ||
+            !ipv6_addr_equal(&fte.next_hop, &next_hop)) {
+            printf("error: wrong route for host %u\n", i);
+            res = -1;
+            goto out;
+        }
+    }
+
+    snprintf(name, sizeof(name), "%u routes hit", numof);
+    BENCHMARK_FUNC(name, BENCH_RUNS, _lookup_hit(numof));
+    snprintf(name, sizeof(name), "%u routes miss", numof);
+    BENCHMARK_FUNC(name, BENCH_RUNS, _lookup_miss());
+
+out:
+    for (unsigned i = 0; i < numof; i++) {
+        unsigned dst_len = _route(i, &dst, NULL);
+
+        gnrc_ipv6_nib_ft_del(&dst, dst_len);
+    }
+    return res;
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 16, 256, 1024 };
+
+    puts("NIB forwarding table benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(numofs); i++) {
+        if (numofs[i] > BENCH_ROUTES_MAX) {
+            break;
+        }
+        if (_bench(numofs[i])) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+        puts("");
+    }
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput and context switches of batched netapi dispatch
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "schedstatistics.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BURSTS
+#define BENCH_BURSTS        (10000UL)
+#endif
+
+#ifndef BENCH_BURST
+#define BENCH_BURST         (4U)
+#endif
+
+#define QUEUE_SIZE          (16U)
+#define PORT                (5683U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_pktsnip_t *_pkts[BENCH_BURST];
+static kernel_pid_t _pid;
+static unsigned long _received;
+
+static void *_receiver(void *arg)
+{
+    msg_t msg, msg_queue[QUEUE_SIZE];
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(PORT,
+                                                           thread_getpid());
+
+    (void)arg;
+    msg_init_queue(msg_queue, QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            /* the packets are reused, so they are not released */
+            _received++;
+        }
+    }
+    return NULL;
+}
+
+static int _bench(bool batch)
+{
+    const char *mode = batch ? "batch" : "single";
+    unsigned long packets = BENCH_BURSTS * BENCH_BURST;
+
+    _received = 0;
+    unsigned schedules = sched_pidlist[_pid].schedules;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_BURSTS; i++) {
+        if (batch) {
+            gnrc_netapi_dispatch_receive_batch(GNRC_NETTYPE_UDP, PORT, _pkts,
+                                               BENCH_BURST);
+        }
+        else {
+            for (unsigned j = 0; j < BENCH_BURST; j++) {
+                gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, PORT, _pkts[j]);
+            }
+        }
+    }
+    uint32_t time = xtimer_now_usec() - start;
+    schedules = sched_pidlist[_pid].schedules - schedules;
+
+    if (_received != packets) {
+        printf("error: %lu of %lu packets received\n", _received, packets);
+        return -1;
+    }
+    /* context switches per packet with two decimal places */
+    unsigned long switches = ((unsigned long)schedules * 100) / packets;
+    printf("%s: %lu packets per sec, %lu.%02lu context switches per packet\n",
+           mode, (unsigned long)(((uint64_t)packets * US_PER_SEC) / time),
+           switches / 100, switches % 100);
+    return 0;
+}
+
+int main(void)
+{
+    puts("GNRC netapi batched dispatch benchmark\n");
+
+    for (unsigned i = 0; i < BENCH_BURST; i++) {
+        _pkts[i] = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+        if (_pkts[i] == NULL) {
+            puts("error: unable to allocate packet\n[FAILURE]");
+            return 1;
+        }
+    }
+    _pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                         THREAD_CREATE_STACKTEST, _receiver, NULL, "receiver");
+
+    if (_bench(false) || _bench(true)) {
+        puts("\n[FAILURE]");
+        return 1;
+    }
+    for (unsigned i = 0; i < BENCH_BURST; i++) {
+        gnrc_pktbuf_release(_pkts[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
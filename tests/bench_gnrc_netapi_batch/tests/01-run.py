@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+RESULT_REGEXP = r"{mode}: \d+ packets per sec, (\d+)\.(\d+) context switches per packet"
+
+
+def testfunc(child):
+    child.expect_exact('GNRC netapi batched dispatch benchmark')
+    child.expect(RESULT_REGEXP.format(mode="single"), timeout=TIMEOUT)
+    single = float("{}.{}".format(*child.match.groups()))
+    child.expect(RESULT_REGEXP.format(mode="batch"), timeout=TIMEOUT)
+    batch = float("{}.{}".format(*child.match.groups()))
+    assert batch < single
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Dispatch cost of the network protocol registry
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#ifndef BENCH_ENTRIES_MAX
+#define BENCH_ENTRIES_MAX   (1000U)
+#endif
+
+/* start of the dynamic port range, as used for client sockets */
+#define PORT_MIN            (49152U)
+
+static void _cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+static gnrc_netreg_entry_t _entries[BENCH_ENTRIES_MAX];
+static gnrc_netreg_entry_cbd_t _cbd = { .cb = _cb };
+static gnrc_pktsnip_t *_pkt;
+static unsigned long _received;
+static uint32_t _rand_state = 0x12345678;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, good enough to pick a random entry */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void _cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)pkt;
+    (void)ctx;
+    _received++;
+}
+
+static void _dispatch(unsigned numof)
+{
+    gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, PORT_MIN + (_rand() % numof),
+                                 _pkt);
+}
+
+static int _bench(unsigned numof)
+{
+    char name[32];
+
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_entry_init_cb(&_entries[i], PORT_MIN + i, &_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_entries[i]);
+    }
+
+    _received = 0;
+    snprintf(name, sizeof(name), "%u entries dispatch", numof);
+    BENCHMARK_FUNC(name, BENCH_RUNS, _dispatch(numof));
+
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &_entries[i]);
+    }
+
+    if (_received != BENCH_RUNS) {
+        printf("error: %lu of %lu packets received\n", _received, BENCH_RUNS);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 10, 100, 1000 };
+
+    puts("GNRC netreg dispatch benchmark\n");
+
+    /* the callback does not release the packet, so it can be reused */
+    _pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+    if (_pkt == NULL) {
+        puts("error: unable to allocate packet\n[FAILURE]");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(numofs); i++) {
+        if (numofs[i] > BENCH_ENTRIES_MAX) {
+            break;
+        }
+        if (_bench(numofs[i])) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+    }
+    gnrc_pktbuf_release(_pkt);
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
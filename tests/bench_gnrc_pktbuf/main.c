@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Allocation rate and fragmentation of the packet buffer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS        (100000UL)
+#endif
+
+#ifndef BENCH_SLOTS
+#define BENCH_SLOTS         (12U)
+#endif
+
+#define MTU_PROBE_INTERVAL  (32U)
+#define MTU                 (1280U)
+
+#define IPV6_HDR_LEN        (40U)
+#define UDP_HDR_LEN         (8U)
+#define NETIF_HDR_LEN       (28U)
+#define FRAME_LEN           (127U)
+
+static gnrc_pktsnip_t *_slots[BENCH_SLOTS];
+static uint32_t _rand_state = 0x12345678;
+static unsigned _allocs;
+static unsigned _fails;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, so all implementations see the same workload */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static gnrc_pktsnip_t *_add(gnrc_pktsnip_t *next, size_t size)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(next, NULL, size, GNRC_NETTYPE_UNDEF);
+
+    if (pkt == NULL) {
+        _fails++;
+        gnrc_pktbuf_release(next);
+    }
+    else {
+        _allocs++;
+    }
+    return pkt;
+}
+
+/* received 802.15.4 frame: headers are marked in place */
+static gnrc_pktsnip_t *_rx_frame(void)
+{
+    gnrc_pktsnip_t *pkt = _add(NULL, 60 + (_rand() % (FRAME_LEN - 60)));
+
+    if ((pkt != NULL) &&
+        (gnrc_pktbuf_mark(pkt, IPV6_HDR_LEN, GNRC_NETTYPE_UNDEF) != NULL)) {
+        _allocs++;
+        if (gnrc_pktbuf_mark(pkt, UDP_HDR_LEN, GNRC_NETTYPE_UNDEF) != NULL) {
+            _allocs++;
+        }
+    }
+    return pkt;
+}
+
+/* UDP packet sent by an application: headers are prepended */
+static gnrc_pktsnip_t *_tx_udp(void)
+{
+    gnrc_pktsnip_t *pkt = _add(NULL, 1 + (_rand() % 200));
+
+    if (pkt != NULL) {
+        pkt = _add(pkt, UDP_HDR_LEN);
+    }
+    if (pkt != NULL) {
+        pkt = _add(pkt, IPV6_HDR_LEN);
+    }
+    if (pkt != NULL) {
+        pkt = _add(pkt, NETIF_HDR_LEN);
+    }
+    return pkt;
+}
+
+/* reassembly buffer, shrunk to the actual datagram size once complete */
+static gnrc_pktsnip_t *_reassembly(void)
+{
+    gnrc_pktsnip_t *pkt = _add(NULL, MTU);
+
+    if (pkt != NULL) {
+        gnrc_pktbuf_realloc_data(pkt, 100 + (_rand() % (MTU - 100)));
+    }
+    return pkt;
+}
+
+static void _fill(gnrc_pktsnip_t *pkt, unsigned slot)
+{
+    while (pkt) {
+        memset(pkt->data, slot + 1, pkt->size);
+        pkt = pkt->next;
+    }
+}
+
+static int _check(gnrc_pktsnip_t *pkt, unsigned slot)
+{
+    while (pkt) {
+        for (unsigned i = 0; i < pkt->size; i++) {
+            if (((uint8_t *)pkt->data)[i] != slot + 1) {
+                return -1;
+            }
+        }
+        pkt = pkt->next;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    unsigned probes = 0, probe_fails = 0;
+
+    puts("GNRC packet buffer benchmark\n");
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long round = 0; round < BENCH_ROUNDS; round++) {
+        unsigned slot = _rand() % BENCH_SLOTS;
+
+        if (_slots[slot] != NULL) {
+            if (_check(_slots[slot], slot) < 0) {
+                printf("error: packet in slot %u corrupted\n", slot);
+                puts("[FAILURE]");
+                return 1;
+            }
+            gnrc_pktbuf_release(_slots[slot]);
+            _slots[slot] = NULL;
+        }
+        else {
+            uint32_t kind = _rand() % 16;
+            gnrc_pktsnip_t *pkt;
+
+            if (kind < 8) {
+                pkt = _rx_frame();
+            }
+            else if (kind < 15) {
+                pkt = _tx_udp();
+            }
+            else {
+                pkt = _reassembly();
+            }
+            if (pkt != NULL) {
+                _fill(pkt, slot);
+                _slots[slot] = pkt;
+            }
+        }
+        if ((round % MTU_PROBE_INTERVAL) == 0) {
+            gnrc_pktsnip_t *probe = gnrc_pktbuf_add(NULL, NULL, MTU,
+                                                    GNRC_NETTYPE_UNDEF);
+            probes++;
+            if (probe == NULL) {
+                probe_fails++;
+            }
+            gnrc_pktbuf_release(probe);
+        }
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    for (unsigned slot = 0; slot < BENCH_SLOTS; slot++) {
+        gnrc_pktbuf_release(_slots[slot]);
+    }
+
+    printf("allocations: %u (%lu per sec), failed: %u\n", _allocs,
+           (unsigned long)(((uint64_t)_allocs * US_PER_SEC) / time), _fails);
+    printf("MTU probes: %u, failed: %u\n", probes, probe_fails);
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Cost of 6LoWPAN reassembly with many concurrent datagrams
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "byteorder.h"
+#include "kernel_defines.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/sixlowpan.h"
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS        (200U)
+#endif
+
+#ifndef BENCH_DATAGRAMS_MAX
+#define BENCH_DATAGRAMS_MAX (64U)
+#endif
+
+#define FRAG_NUMOF          (4U)
+#define FRAG_PAYLOAD_SIZE   (64U)
+#define DATAGRAM_SIZE       (FRAG_NUMOF * FRAG_PAYLOAD_SIZE)
+#define L2ADDR_LEN          (8U)
+
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[L2ADDR_LEN];
+    uint8_t dst[L2ADDR_LEN];
+} _netif_hdr;
+
+static const uint8_t _src[L2ADDR_LEN] = {
+    0xb3, 0x47, 0x60, 0x49, 0x78, 0xfe, 0x00, 0x00
+};
+static const uint8_t _dst[L2ADDR_LEN] = {
+    0xa4, 0xf2, 0xd2, 0xc9, 0x13, 0xb9, 0xbb, 0x25
+};
+
+static uint16_t _tags[BENCH_DATAGRAMS_MAX];
+static unsigned _numof;
+static unsigned _next;
+static unsigned _completed;
+static unsigned _errors;
+
+/* adds the next fragment, the fragments of all datagrams are interleaved */
+static void _feed(void)
+{
+    unsigned datagram = _next % _numof;
+    unsigned frag = (_next / _numof) % FRAG_NUMOF;
+    size_t hdr_size = (frag == 0) ? sizeof(sixlowpan_frag_t)
+                                  : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *pkt;
+    gnrc_sixlowpan_frag_rb_t *entry;
+    sixlowpan_frag_n_t *hdr;
+    uint8_t src[L2ADDR_LEN];
+
+    _next++;
+    pkt = gnrc_pktbuf_add(NULL, NULL, hdr_size + FRAG_PAYLOAD_SIZE,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        _errors++;
+        return;
+    }
+    hdr = pkt->data;
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->disp_size.u8[0] |= (frag == 0) ? SIXLOWPAN_FRAG_1_DISP
+                                        : SIXLOWPAN_FRAG_N_DISP;
+    hdr->tag = byteorder_htons(_tags[datagram]);
+    if (frag > 0) {
+        hdr->offset = (frag * FRAG_PAYLOAD_SIZE) / 8;
+    }
+    memset((uint8_t *)pkt->data + hdr_size, 0x54, FRAG_PAYLOAD_SIZE);
+
+    /* every datagram comes from another neighbor */
+    memcpy(src, _src, sizeof(src));
+    src[L2ADDR_LEN - 2] = datagram >> 8;
+    src[L2ADDR_LEN - 1] = datagram & 0xff;
+    gnrc_netif_hdr_set_src_addr(&_netif_hdr.hdr, src, sizeof(src));
+
+    entry = gnrc_sixlowpan_frag_rb_add(&_netif_hdr.hdr, pkt,
+                                       frag * FRAG_PAYLOAD_SIZE, 0);
+    if (entry == NULL) {
+        _errors++;
+    }
+    else if (frag == (FRAG_NUMOF - 1)) {
+        if (gnrc_sixlowpan_frag_rb_dispatch_when_complete(entry,
+                                                          &_netif_hdr.hdr) > 0) {
+            _completed++;
+        }
+        else {
+            _errors++;
+        }
+        _tags[datagram]++;
+    }
+}
+
+static int _bench(unsigned numof)
+{
+    unsigned runs = BENCH_ROUNDS * numof * FRAG_NUMOF;
+    char name[32];
+
+    _numof = numof;
+    _next = 0;
+    _completed = 0;
+    _errors = 0;
+
+    snprintf(name, sizeof(name), "%u datagrams", numof);
+    BENCHMARK_FUNC(name, runs, _feed());
+
+    if ((_errors > 0) || (_completed != (runs / FRAG_NUMOF))) {
+        printf("error: %u of %u datagrams reassembled, %u errors\n",
+               _completed, runs / FRAG_NUMOF, _errors);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 4, 16, 64 };
+
+    puts("6LoWPAN reassembly buffer benchmark\n");
+
+    gnrc_netif_hdr_init(&_netif_hdr.hdr, L2ADDR_LEN, L2ADDR_LEN);
+    gnrc_netif_hdr_set_dst_addr(&_netif_hdr.hdr, _dst, sizeof(_dst));
+    for (unsigned i = 0; i < ARRAY_SIZE(numofs); i++) {
+        if (numofs[i] > BENCH_DATAGRAMS_MAX) {
+            break;
+        }
+        if (_bench(numofs[i])) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
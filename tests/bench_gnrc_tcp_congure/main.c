@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Goodput of gnrc_tcp with different congestion controls over
+ *              an emulated lossy link, and the result of a send that times
+ *              out after part of the data was acknowledged
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "congure/cocoa.h"
+#include "congure/reno.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES             (16U * 1024U)
+#endif
+
+#ifndef BENCH_LOSS_PERMILLE
+#define BENCH_LOSS_PERMILLE     (20U)
+#endif
+
+#ifndef BENCH_RATE_BPS
+#define BENCH_RATE_BPS          (20000U)    /**< link rate in bytes per second */
+#endif
+
+#ifndef BENCH_DELAY_MS
+#define BENCH_DELAY_MS          (20U)
+#endif
+
+#ifndef BENCH_QUEUE_LEN
+#define BENCH_QUEUE_LEN         (6U)
+#endif
+
+#define SERVER_PORT             (8080U)
+#define CHUNK_SIZE              (512U)
+#define USER_TIMEOUT_MS         (60U * MS_PER_SEC)
+#define PARTIAL_TIMEOUT_MS      (2U * MS_PER_SEC)
+#define MSG_TYPE_DELIVER        (0x4c01)
+#define MSG_TYPE_SERVER_DONE    (0x4c02)
+#define LINK_MSG_QUEUE_SIZE     (8U)
+
+#define TCP_CTL_SYN             (0x0002)
+#define TCP_OFFSET(off_ctl)     (((off_ctl) >> 12) * 4U)
+
+typedef struct {
+    xtimer_t timer;
+    msg_t msg;
+    gnrc_pktsnip_t *pkt;
+} link_slot_t;
+
+typedef enum {
+    MODE_NONE,
+    MODE_RENO,
+    MODE_COCOA,
+    MODE_NUMOF,
+} bench_mode_t;
+
+static const char *_mode_names[MODE_NUMOF] = { "none", "reno", "cocoa" };
+
+static char _link_stack[THREAD_STACKSIZE_DEFAULT];
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static msg_t _link_msg_queue[LINK_MSG_QUEUE_SIZE];
+static kernel_pid_t _link_pid;
+static kernel_pid_t _main_pid;
+
+static link_slot_t _slots[BENCH_QUEUE_LEN];
+static uint32_t _link_free_us;
+static uint16_t _client_port;
+static uint32_t _client_isn;
+static uint32_t _client_max_end;
+static uint32_t _cut_bytes;     /**< if not zero, client data beyond is lost */
+static unsigned _retransmissions;
+static unsigned _dropped;
+
+static gnrc_tcp_tcb_t _client_tcb;
+static gnrc_tcp_tcb_t _server_tcb;
+static congure_reno_snd_t _reno;
+static congure_cocoa_snd_t _cocoa;
+static uint8_t _tx_buf[CHUNK_SIZE];
+static uint8_t _rx_buf[CHUNK_SIZE];
+
+/* counts retransmitted data segments of the client */
+static void _count_client_seg(const gnrc_pktsnip_t *tcp)
+{
+    tcp_hdr_t *hdr = tcp->data;
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    uint32_t seq = byteorder_ntohl(hdr->seq_num);
+    size_t len = gnrc_pkt_len(tcp) - TCP_OFFSET(ctl);
+
+    if (byteorder_ntohs(hdr->src_port) != _client_port) {
+        return;
+    }
+    if (ctl & TCP_CTL_SYN) {
+        _client_isn = seq;
+        _client_max_end = seq + 1;
+    }
+    else if (len > 0) {
+        if ((int32_t)(seq + len - _client_max_end) <= 0) {
+            _retransmissions++;
+        }
+        else {
+            _client_max_end = seq + len;
+        }
+    }
+}
+
+/* does the job of IPv6 for a packet sent over the link and converts it into
+ * the form the receiving TCP expects */
+static gnrc_pktsnip_t *_to_rcv(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    gnrc_pktsnip_t *tcp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    gnrc_pktsnip_t *rcv;
+    ipv6_hdr_t *hdr = ip->data;
+    uint8_t *data;
+
+    if (ipv6_addr_is_unspecified(&hdr->src)) {
+        hdr->src = ipv6_addr_loopback;
+    }
+    hdr->len = byteorder_htons(gnrc_pkt_len(tcp));
+    hdr->nh = PROTNUM_TCP;
+    gnrc_tcp_calc_csum(tcp, ip);
+    _count_client_seg(tcp);
+
+    rcv = gnrc_pktbuf_add(NULL, hdr, sizeof(*hdr), GNRC_NETTYPE_IPV6);
+    if (rcv != NULL) {
+        rcv = gnrc_pktbuf_add(rcv, NULL, gnrc_pkt_len(tcp), GNRC_NETTYPE_TCP);
+    }
+    if (rcv == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    data = rcv->data;
+    for (gnrc_pktsnip_t *snip = tcp; snip != NULL; snip = snip->next) {
+        memcpy(data, snip->data, snip->size);
+        data += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    return rcv;
+}
+
+/* checks if a packet as returned by _to_rcv() carries client data the link
+ * does not deliver anymore */
+static bool _is_cut(const gnrc_pktsnip_t *tcp)
+{
+    tcp_hdr_t *hdr = tcp->data;
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    uint32_t seq = byteorder_ntohl(hdr->seq_num);
+
+    return (_cut_bytes > 0)
+           && (byteorder_ntohs(hdr->src_port) == _client_port)
+           && (tcp->size > TCP_OFFSET(ctl))
+           && ((seq - (_client_isn + 1)) >= _cut_bytes);
+}
+
+static void _link_send(gnrc_pktsnip_t *pkt)
+{
+    link_slot_t *slot = NULL;
+    uint32_t now = xtimer_now_usec();
+
+    pkt = _to_rcv(pkt);
+    if (pkt == NULL) {
+        return;
+    }
+    for (unsigned i = 0; i < BENCH_QUEUE_LEN; i++) {
+        if (_slots[i].pkt == NULL) {
+            slot = &_slots[i];
+            break;
+        }
+    }
+    if ((slot == NULL) || _is_cut(pkt) ||
+        ((_cut_bytes == 0) &&
+         (random_uint32_range(0, 1000) < BENCH_LOSS_PERMILLE))) {
+        _dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    /* serialize packets with the link rate */
+    if ((int32_t)(_link_free_us - now) < 0) {
+        _link_free_us = now;
+    }
+    _link_free_us += (gnrc_pkt_len(pkt) * US_PER_SEC) / BENCH_RATE_BPS;
+    slot->pkt = pkt;
+    slot->msg.type = MSG_TYPE_DELIVER;
+    slot->msg.content.ptr = slot;
+    xtimer_set_msg(&slot->timer,
+                   (_link_free_us - now) + (BENCH_DELAY_MS * US_PER_MS),
+                   &slot->msg, _link_pid);
+}
+
+static void *_link_thread(void *arg)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                        GNRC_NETREG_DEMUX_CTX_ALL,
+                                        thread_getpid());
+    (void)arg;
+    msg_init_queue(_link_msg_queue, LINK_MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &entry);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        switch (msg.type) {
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            _link_send(msg.content.ptr);
+            break;
+        case MSG_TYPE_DELIVER: {
+            link_slot_t *slot = msg.content.ptr;
+
+            if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_TCP,
+                                              GNRC_NETREG_DEMUX_CTX_ALL,
+                                              slot->pkt)) {
+                gnrc_pktbuf_release(slot->pkt);
+            }
+            slot->pkt = NULL;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void *_server_thread(void *arg)
+{
+    gnrc_tcp_ep_t local = { .family = AF_INET6, .port = SERVER_PORT };
+    msg_t msg = { .type = MSG_TYPE_SERVER_DONE };
+    (void)arg;
+
+    while (1) {
+        uint32_t received = 0;
+        ssize_t res;
+
+        gnrc_tcp_tcb_init(&_server_tcb);
+        if (gnrc_tcp_open_passive(&_server_tcb, &local) < 0) {
+            continue;
+        }
+        do {
+            res = gnrc_tcp_recv(&_server_tcb, _rx_buf, sizeof(_rx_buf),
+                                USER_TIMEOUT_MS);
+            if (res > 0) {
+                received += res;
+            }
+        } while (res > 0);
+        gnrc_tcp_close(&_server_tcb);
+        msg.content.value = received;
+        msg_send(&msg, _main_pid);
+    }
+    return NULL;
+}
+
+static congure_snd_t *_congure(bench_mode_t mode)
+{
+    switch (mode) {
+    case MODE_RENO:
+        congure_reno_snd_setup(&_reno, &gnrc_tcp_congure_reno_consts);
+        return &_reno.super;
+    case MODE_COCOA:
+        congure_cocoa_snd_setup(&_cocoa, &gnrc_tcp_congure_reno_consts);
+        return &_cocoa.super.super;
+    default:
+        return NULL;
+    }
+}
+
+static int _run(bench_mode_t mode)
+{
+    gnrc_tcp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+    uint32_t sent = 0;
+    uint32_t start, duration;
+    msg_t msg;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    _client_port = SERVER_PORT + 1 + mode;
+    _retransmissions = 0;
+    _dropped = 0;
+    gnrc_tcp_tcb_init(&_client_tcb);
+    gnrc_tcp_tcb_set_congure(&_client_tcb, _congure(mode));
+
+    start = xtimer_now_usec();
+    if (gnrc_tcp_open_active(&_client_tcb, &remote, _client_port) < 0) {
+        printf("%s: connection failed\n", _mode_names[mode]);
+        return -1;
+    }
+    while (sent < BENCH_BYTES) {
+        size_t len = BENCH_BYTES - sent;
+        ssize_t res;
+
+        if (len > sizeof(_tx_buf)) {
+            len = sizeof(_tx_buf);
+        }
+        res = gnrc_tcp_send(&_client_tcb, _tx_buf, len, USER_TIMEOUT_MS);
+        if (res < 0) {
+            printf("%s: send failed: %d\n", _mode_names[mode], (int)res);
+            gnrc_tcp_abort(&_client_tcb);
+            return -1;
+        }
+        sent += res;
+    }
+    /* gnrc_tcp_send() returns once all data is acknowledged */
+    duration = xtimer_now_usec() - start;
+    gnrc_tcp_close(&_client_tcb);
+    msg_receive(&msg);
+    if (msg.content.value != BENCH_BYTES) {
+        printf("%s: received %u of %u bytes\n", _mode_names[mode],
+               (unsigned)msg.content.value, BENCH_BYTES);
+        return -1;
+    }
+    printf("%s: %u bytes, %u B/s goodput, %u retransmissions, "
+           "%u packets dropped\n", _mode_names[mode], BENCH_BYTES,
+           (unsigned)(((uint64_t)BENCH_BYTES * US_PER_SEC) / duration),
+           _retransmissions, _dropped);
+    return 0;
+}
+
+/* the link stops delivering data after the first segment, so the peer only
+ * acknowledges that one until the user timeout expires */
+static int _run_partial_timeout(void)
+{
+    gnrc_tcp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+    const size_t len = 2 * CONFIG_GNRC_TCP_MSS;
+    ssize_t res;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    _client_port = SERVER_PORT + 1 + MODE_NUMOF;
+    gnrc_tcp_tcb_init(&_client_tcb);
+    gnrc_tcp_tcb_set_congure(&_client_tcb, _congure(MODE_RENO));
+    if (gnrc_tcp_open_active(&_client_tcb, &remote, _client_port) < 0) {
+        puts("partial timeout: connection failed");
+        return -1;
+    }
+    _cut_bytes = CONFIG_GNRC_TCP_MSS;
+    res = gnrc_tcp_send(&_client_tcb, _tx_buf, len, PARTIAL_TIMEOUT_MS);
+    _cut_bytes = 0;
+    gnrc_tcp_abort(&_client_tcb);
+    printf("partial timeout: %d of %u bytes acknowledged\n", (int)res,
+           (unsigned)len);
+    return (res == CONFIG_GNRC_TCP_MSS) ? 0 : -1;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("gnrc_tcp congestion control benchmark");
+    printf("link: %u B/s, %u ms delay, %u packets queue, %u permille loss\n",
+           BENCH_RATE_BPS, BENCH_DELAY_MS, BENCH_QUEUE_LEN,
+           BENCH_LOSS_PERMILLE);
+    _main_pid = thread_getpid();
+    _link_pid = thread_create(_link_stack, sizeof(_link_stack),
+                              THREAD_PRIORITY_MAIN - 2, THREAD_CREATE_STACKTEST,
+                              _link_thread, NULL, "link");
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server_thread, NULL, "server");
+    for (unsigned mode = 0; mode < MODE_NUMOF; mode++) {
+        res |= _run(mode);
+    }
+    /* last, as the server is left waiting for the aborted connection */
+    res |= _run_partial_timeout();
+    puts((res == 0) ? "[SUCCESS]" : "[FAILURE]");
+    return 0;
+}
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 300
+RESULT_REGEXP = r"{mode}: (\d+) bytes, (\d+) B/s goodput, (\d+) retransmissions"
+
+
+def testfunc(child):
+    child.expect_exact('gnrc_tcp congestion control benchmark')
+    for mode in ("none", "reno", "cocoa"):
+        child.expect(RESULT_REGEXP.format(mode=mode), timeout=TIMEOUT)
+        assert int(child.match.group(1)) > 0
+        assert int(child.match.group(2)) > 0
+    child.expect(r"partial timeout: (-?\d+) of (\d+) bytes acknowledged",
+                 timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
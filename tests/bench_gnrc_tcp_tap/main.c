@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Goodput of gnrc_tcp with SACK, window scaling and timestamps
+ *              over a tap device
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8U)
+#define CHUNK_SIZE          (4096U)
+#define USER_TIMEOUT_MS     (30U * MS_PER_SEC)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_tcp_tcb_t _tcb;
+static congure_reno_snd_t _reno;
+static uint8_t _buf[CHUNK_SIZE];
+
+static void _print_result(const char *cmd, uint32_t bytes, uint32_t duration)
+{
+    if (duration == 0) {
+        duration = 1;
+    }
+    printf("%s: %" PRIu32 " bytes in %" PRIu32 " us, %" PRIu32 " B/s goodput\n",
+           cmd, bytes, duration,
+           (uint32_t)(((uint64_t)bytes * US_PER_SEC) / duration));
+}
+
+static void _init_tcb(void)
+{
+    gnrc_tcp_tcb_init(&_tcb);
+    congure_reno_snd_setup(&_reno, &gnrc_tcp_congure_reno_consts);
+    gnrc_tcp_tcb_set_congure(&_tcb, &_reno.super);
+}
+
+static int _send_cmd(int argc, char **argv)
+{
+    gnrc_tcp_ep_t remote;
+    uint32_t bytes, sent = 0, start;
+    int res;
+
+    if (argc < 3) {
+        printf("usage: %s <[addr%%netif]:port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_from_str(&remote, argv[1]) < 0) {
+        printf("%s: invalid endpoint\n", argv[0]);
+        return 1;
+    }
+    bytes = strtoul(argv[2], NULL, 10);
+    memset(_buf, 'x', sizeof(_buf));
+
+    _init_tcb();
+    start = xtimer_now_usec();
+    res = gnrc_tcp_open_active(&_tcb, &remote, 0);
+    if (res < 0) {
+        printf("%s: open failed: %d\n", argv[0], res);
+        return 1;
+    }
+    while (sent < bytes) {
+        size_t len = bytes - sent;
+
+        if (len > sizeof(_buf)) {
+            len = sizeof(_buf);
+        }
+        res = gnrc_tcp_send(&_tcb, _buf, len, USER_TIMEOUT_MS);
+        if (res < 0) {
+            printf("%s: send failed: %d\n", argv[0], res);
+            gnrc_tcp_abort(&_tcb);
+            return 1;
+        }
+        sent += res;
+    }
+    /* gnrc_tcp_send() returns once all data is acknowledged */
+    _print_result(argv[0], sent, xtimer_now_usec() - start);
+    gnrc_tcp_close(&_tcb);
+    return 0;
+}
+
+static int _recv_cmd(int argc, char **argv)
+{
+    gnrc_tcp_ep_t local = { .family = AF_INET6 };
+    uint32_t bytes, received = 0, start = 0;
+    int res;
+
+    if (argc < 3) {
+        printf("usage: %s <port> <bytes>\n", argv[0]);
+        return 1;
+    }
+    local.port = atoi(argv[1]);
+    bytes = strtoul(argv[2], NULL, 10);
+
+    _init_tcb();
+    res = gnrc_tcp_open_passive(&_tcb, &local);
+    if (res < 0) {
+        printf("%s: open failed: %d\n", argv[0], res);
+        return 1;
+    }
+    while (received < bytes) {
+        res = gnrc_tcp_recv(&_tcb, _buf, sizeof(_buf), USER_TIMEOUT_MS);
+        if (res <= 0) {
+            break;
+        }
+        /* start measuring with the first data received */
+        if (received == 0) {
+            start = xtimer_now_usec();
+        }
+        received += res;
+    }
+    _print_result(argv[0], received, xtimer_now_usec() - start);
+    gnrc_tcp_close(&_tcb);
+    return (received == bytes) ? 0 : 1;
+}
+
+static const shell_command_t _shell_commands[] = {
+    { "bench_send", "send data to a TCP peer and measure goodput", _send_cmd },
+    { "bench_recv", "receive data from a TCP peer and measure goodput", _recv_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("gnrc_tcp tap benchmark");
+    shell_run(_shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import random
+import re
+import socket
+import subprocess
+import sys
+import threading
+
+from testrunner import run
+
+BENCH_BYTES = int(os.environ.get('BENCH_BYTES', 1024 * 1024))
+# loss in percent, applied to packets the host sends over the tap device
+BENCH_LOSS = [0, 1, 5]
+
+
+def get_host_tap_device():
+    # Check if given tap device is part of a network bridge
+    # if so use bridged interface instead of given tap device
+    tap = os.environ["TAPDEV"]
+    result = os.popen('bridge link show dev {}'.format(tap))
+    bridge = re.search('master (.*) state', result.read())
+
+    return bridge.group(1).strip() if bridge else tap
+
+
+def get_host_ll_addr(interface):
+    result = os.popen('ip addr show dev ' + interface + ' scope link')
+    return re.search('inet6 (.*)/64', result.read()).group(1).strip()
+
+
+def get_riot_ll_addr(child):
+    child.sendline('ifconfig')
+    child.expect(r'(fe80:[0-9a-f:]+)\s')
+    return child.match.group(1).strip()
+
+
+def get_riot_if_id(child):
+    child.sendline('ifconfig')
+    child.expect(r'Iface\s+(\d+)\s')
+    return child.match.group(1).strip()
+
+
+def set_loss(dev, loss):
+    subprocess.run(['tc', 'qdisc', 'del', 'dev', dev, 'root'],
+                   stderr=subprocess.DEVNULL)
+    if loss > 0:
+        subprocess.run(['tc', 'qdisc', 'add', 'dev', dev, 'root', 'netem',
+                        'loss', '{}%'.format(loss)], check=True)
+
+
+def tcp_sink(sock):
+    conn, _ = sock.accept()
+    while conn.recv(65536):
+        pass
+    conn.close()
+
+
+def bench_send(child, dev, loss):
+    # RIOT sends, the host drops ACKs
+    port = random.randint(1024, 65535)
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(('::', port))
+    sock.listen(1)
+    sink = threading.Thread(target=tcp_sink, args=(sock,))
+    sink.start()
+
+    addr = get_host_ll_addr(dev) + '%' + get_riot_if_id(child)
+    set_loss(dev, loss)
+    child.sendline('bench_send [{}]:{} {}'.format(addr, port, BENCH_BYTES))
+    child.expect(r'bench_send: (\d+) bytes in \d+ us, (\d+) B/s goodput')
+    set_loss(dev, 0)
+    sink.join()
+    sock.close()
+    assert int(child.match.group(1)) == BENCH_BYTES
+    return int(child.match.group(2))
+
+
+def bench_recv(child, dev, loss):
+    # RIOT receives, the host drops data segments
+    port = random.randint(1024, 65535)
+    addr = get_riot_ll_addr(child)
+    ifindex = socket.if_nametoindex(dev)
+
+    set_loss(dev, loss)
+    child.sendline('bench_recv {} {}'.format(port, BENCH_BYTES))
+    sock = socket.create_connection((addr, port, 0, ifindex))
+    sock.sendall(b'x' * BENCH_BYTES)
+    child.expect(r'bench_recv: (\d+) bytes in \d+ us, (\d+) B/s goodput')
+    sock.close()
+    set_loss(dev, 0)
+    assert int(child.match.group(1)) == BENCH_BYTES
+    return int(child.match.group(2))
+
+
+def testfunc(child):
+    dev = get_host_tap_device()
+
+    print('loss  send [B/s]  recv [B/s]')
+    for loss in BENCH_LOSS:
+        send = bench_send(child, dev, loss)
+        recv = bench_recv(child, dev, loss)
+        print('{:3d}%  {:10d}  {:10d}'.format(loss, send, recv))
+
+    print(os.path.basename(sys.argv[0]) + ': success')
+
+
+if __name__ == '__main__':
+    if os.geteuid() != 0:
+        print("\x1b[1;31mThis test requires root privileges to configure "
+              "netem.\x1b[0m\n", file=sys.stderr)
+        sys.exit(1)
+    sys.exit(run(testfunc, timeout=120, echo=False, traceback=True))
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of the Internet Checksum
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/inet_csum.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#define BUF_SIZE            (1280U)
+
+/* one spare byte to benchmark an unaligned buffer */
+static uint32_t _buf[(BUF_SIZE / sizeof(uint32_t)) + 1];
+static volatile uint16_t _sum;
+
+int main(void)
+{
+    static const unsigned lens[] = { 8, 64, 256, BUF_SIZE };
+    uint8_t *buf = (uint8_t *)_buf;
+    char name[32];
+
+    puts("Internet Checksum benchmark\n");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        buf[i] = i * 7;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        snprintf(name, sizeof(name), "%u bytes aligned", lens[i]);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _sum = inet_csum(0, buf, lens[i]));
+        snprintf(name, sizeof(name), "%u bytes unaligned", lens[i]);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _sum = inet_csum(0, buf + 1, lens[i]));
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
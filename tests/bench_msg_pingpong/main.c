@@ -26,12 +26,35 @@
 #include "msg.h"
 #include "xtimer.h"
 
+#ifndef BENCH_MODE_BATCH
+#define BENCH_MODE_BATCH    (0)
+#endif
+
+#ifndef BENCH_MODE_CHAN
+#define BENCH_MODE_CHAN     (0)
+#endif
+
+#if BENCH_MODE_CHAN
+#include "msg_chan.h"
+#endif
+
 #ifndef TEST_DURATION_US
 #define TEST_DURATION_US    (1000000U)
 #endif
 
+#ifndef BENCH_BURST
+#define BENCH_BURST         (16U)
+#endif
+
+#define BENCH_BATCHED       (BENCH_MODE_BATCH || BENCH_MODE_CHAN)
+
 static char _stack[THREAD_STACKSIZE_MAIN];
 
+#if BENCH_MODE_CHAN
+static msg_chan_slot_t _slots[BENCH_BURST];
+static msg_chan_t _chan;
+#endif
+
 static void _timer_callback(void *flag)
 {
     atomic_flag_clear(flag);
@@ -41,21 +64,58 @@ static void *_second_thread(void *arg)
 {
     (void)arg;
 
+#if BENCH_MODE_BATCH
+    msg_t queue[BENCH_BURST];
+    msg_init_queue(queue, BENCH_BURST);
+#elif BENCH_MODE_CHAN
+    msg_chan_init(&_chan, _slots, BENCH_BURST, 0x1);
+#endif
+
     while (1) {
+#if BENCH_BATCHED
+        msg_t test[BENCH_BURST];
+#  if BENCH_MODE_BATCH
+        msg_receive_batch(test, BENCH_BURST);
+#  else
+        msg_chan_receive_batch(&_chan, test, BENCH_BURST);
+#  endif
+#else
         msg_t test;
         msg_receive(&test);
+#endif
     }
 
     return NULL;
 }
 
+#if BENCH_BATCHED
+static uint32_t _send_burst(kernel_pid_t other)
+{
+    uint32_t n = 0;
+
+    for (unsigned i = 0; i < BENCH_BURST; i++) {
+        msg_t test;
+#  if BENCH_MODE_BATCH
+        n += (msg_try_send(&test, other) == 1);
+#  else
+        (void)other;
+        n += msg_chan_try_put(&_chan, &test);
+#  endif
+    }
+    /* the receiver runs at the same priority and drains the whole burst */
+    thread_yield();
+    return n;
+}
+#endif
+
 int main(void)
 {
     puts("main starting");
 
+    /* in the batched modes, the receiver only runs when main yields */
     kernel_pid_t other = thread_create(_stack,
                                        sizeof(_stack),
-                                       (THREAD_PRIORITY_MAIN - 1),
+                                       (THREAD_PRIORITY_MAIN - !BENCH_BATCHED),
                                        THREAD_CREATE_STACKTEST,
                                        _second_thread,
                                        NULL,
@@ -73,9 +133,13 @@ int main(void)
     xtimer_set(&timer, TEST_DURATION_US);
 
     while (atomic_flag_test_and_set(&flag)) {
+#if BENCH_BATCHED
+        n += _send_burst(other);
+#else
         msg_t test;
         msg_send(&test, other);
         n++;
+#endif
     }
 
     printf("{ \"result\" : %"PRIu32, n);
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of the native MTD emulation
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "mtd.h"
+#include "xtimer.h"
+
+/* an odd stride visits every page once if the number of pages is a power
+ * of two */
+#ifndef BENCH_RANDOM_STRIDE
+#define BENCH_RANDOM_STRIDE     (2654435761UL)
+#endif
+
+static uint8_t _buf[MTD_PAGE_SIZE];
+static uint8_t _cmp[MTD_PAGE_SIZE];
+
+static uint32_t _pages(void)
+{
+    return mtd0->sector_count * mtd0->pages_per_sector;
+}
+
+static uint32_t _page(uint32_t i, bool random)
+{
+    return random ? (i * BENCH_RANDOM_STRIDE) % _pages() : i;
+}
+
+static void _fill(uint8_t *buf, uint32_t page)
+{
+    memset(buf, page, MTD_PAGE_SIZE);
+    memcpy(buf, &page, sizeof(page));
+}
+
+static void _print(const char *what, uint64_t bytes, uint32_t time)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    /* in units of 10 kB/s */
+    unsigned long tput = (bytes * US_PER_SEC) / (time * 10000ULL);
+
+    printf("%s: %lu.%02lu MB/s\n", what, tput / 100, tput % 100);
+}
+
+static int _erase(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    if (mtd_erase_sector(mtd0, 0, mtd0->sector_count)) {
+        puts("error: erase failed");
+        return -1;
+    }
+    _print("erase", (uint64_t)_pages() * MTD_PAGE_SIZE,
+           xtimer_now_usec() - start);
+    return 0;
+}
+
+static int _write(bool random)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (uint32_t i = 0; i < _pages(); i++) {
+        uint32_t page = _page(i, random);
+
+        _fill(_buf, page);
+        if (mtd_write_page_raw(mtd0, _buf, page, 0, MTD_PAGE_SIZE)) {
+            printf("error: writing page %lu failed\n", (unsigned long)page);
+            return -1;
+        }
+    }
+    _print(random ? "random write" : "sequential write",
+           (uint64_t)_pages() * MTD_PAGE_SIZE, xtimer_now_usec() - start);
+    return 0;
+}
+
+static int _read(bool random)
+{
+    uint32_t time = 0;
+
+    for (uint32_t i = 0; i < _pages(); i++) {
+        uint32_t page = _page(i, random);
+        uint32_t start = xtimer_now_usec();
+
+        if (mtd_read_page(mtd0, _buf, page, 0, MTD_PAGE_SIZE)) {
+            printf("error: reading page %lu failed\n", (unsigned long)page);
+            return -1;
+        }
+        time += xtimer_now_usec() - start;
+        _fill(_cmp, page);
+        if (memcmp(_buf, _cmp, MTD_PAGE_SIZE)) {
+            printf("error: page %lu has wrong content\n", (unsigned long)page);
+            return -1;
+        }
+    }
+    _print(random ? "random read" : "sequential read",
+           (uint64_t)_pages() * MTD_PAGE_SIZE, time);
+    return 0;
+}
+
+static int _bench(bool random)
+{
+    if (_erase() || _write(random) || _read(random)) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("native MTD benchmark\n");
+
+    if (mtd_init(mtd0)) {
+        puts("error: init failed\n[FAILURE]");
+        return 1;
+    }
+    printf("%lu pages of %u bytes\n", (unsigned long)_pages(),
+           (unsigned)MTD_PAGE_SIZE);
+
+    if (_bench(false) || _bench(true)) {
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
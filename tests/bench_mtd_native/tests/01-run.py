@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 120
+
+
+def testfunc(child):
+    child.expect_exact('native MTD benchmark')
+    for mode in ("sequential", "random"):
+        child.expect(r"erase: \d+\.\d+ MB/s", timeout=TIMEOUT)
+        child.expect(r"{} write: \d+\.\d+ MB/s".format(mode), timeout=TIMEOUT)
+        child.expect(r"{} read: \d+\.\d+ MB/s".format(mode), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Wake-up latency of a high priority thread blocked on a mutex
+ *              held by a low priority thread, with a medium priority thread
+ *              wanting to run, also while the low priority thread holds
+ *              and unlocks a second mutex, or after it slept via ztimer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "ztimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100U)
+#endif
+
+#ifndef BENCH_LOW_BUSY_US
+#define BENCH_LOW_BUSY_US   (1000U)
+#endif
+
+#ifndef BENCH_MID_BUSY_US
+#define BENCH_MID_BUSY_US   (5000U)
+#endif
+
+#ifndef BENCH_SLEEP_US
+#define BENCH_SLEEP_US      (100U)
+#endif
+
+typedef enum {
+    ROUND_SINGLE,
+    ROUND_NESTED,
+    ROUND_SLEEP,
+} round_t;
+
+static const char *_round_names[] = {
+    [ROUND_SINGLE] = "single",
+    [ROUND_NESTED] = "nested",
+    [ROUND_SLEEP] = "sleep",
+};
+
+static char _stack_high[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+
+static kernel_pid_t _pid_high;
+static kernel_pid_t _pid_mid;
+
+static mutex_t _mutex = MUTEX_INIT;
+static mutex_t _mutex_inner = MUTEX_INIT;
+
+static round_t _round;
+
+static uint32_t _latency_max;
+static uint64_t _latency_sum;
+
+static void _busy(uint32_t usec)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while ((xtimer_now_usec() - start) < usec) {}
+}
+
+static void *_high(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+
+        uint32_t start = xtimer_now_usec();
+        mutex_lock(&_mutex);
+        uint32_t latency = xtimer_now_usec() - start;
+        mutex_unlock(&_mutex);
+
+        if (latency > _latency_max) {
+            _latency_max = latency;
+        }
+        _latency_sum += latency;
+    }
+
+    return NULL;
+}
+
+static void *_mid(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        _busy(BENCH_MID_BUSY_US);
+    }
+
+    return NULL;
+}
+
+static void *_low(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+
+        if (_round == ROUND_SLEEP) {
+            /* this hands a mutex on the stack over to this thread, which
+             * never unlocks it */
+            ztimer_sleep(ZTIMER_USEC, BENCH_SLEEP_US);
+        }
+        mutex_lock(&_mutex);
+        if (_round == ROUND_NESTED) {
+            mutex_lock(&_mutex_inner);
+        }
+        /* both preempt this thread right away, the high priority thread
+         * blocks on the mutex */
+        thread_wakeup(_pid_high);
+        thread_wakeup(_pid_mid);
+        if (_round == ROUND_NESTED) {
+            _busy(BENCH_LOW_BUSY_US / 2);
+            /* this must not drop the priority inherited through _mutex */
+            mutex_unlock(&_mutex_inner);
+            _busy(BENCH_LOW_BUSY_US / 2);
+        }
+        else {
+            _busy(BENCH_LOW_BUSY_US);
+        }
+        mutex_unlock(&_mutex);
+    }
+
+    return NULL;
+}
+
+static bool _run(kernel_pid_t pid_low, round_t round)
+{
+    _round = round;
+    _latency_max = 0;
+    _latency_sum = 0;
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        /* all other threads have a higher priority, so they are done with
+         * the round when this returns, unless the low priority thread
+         * sleeps in between */
+        while (thread_wakeup(pid_low) != 1) {}
+    }
+    while (thread_getstatus(pid_low) != STATUS_SLEEPING) {}
+
+    printf("%s: worst case: %" PRIu32 " us, average: %" PRIu32 " us\n",
+           _round_names[round], _latency_max,
+           (uint32_t)(_latency_sum / BENCH_RUNS));
+
+    return !IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+           || (_latency_max < BENCH_MID_BUSY_US);
+}
+
+int main(void)
+{
+    puts("mutex priority inheritance benchmark\n");
+    printf("priority inheritance: %s\n",
+           IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) ? "on" : "off");
+
+    _pid_high = thread_create(_stack_high, sizeof(_stack_high),
+                              THREAD_PRIORITY_MAIN - 3, THREAD_CREATE_STACKTEST,
+                              _high, NULL, "high");
+    _pid_mid = thread_create(_stack_mid, sizeof(_stack_mid),
+                             THREAD_PRIORITY_MAIN - 2, THREAD_CREATE_STACKTEST,
+                             _mid, NULL, "mid");
+    kernel_pid_t pid_low = thread_create(_stack_low, sizeof(_stack_low),
+                                         THREAD_PRIORITY_MAIN - 1,
+                                         THREAD_CREATE_STACKTEST,
+                                         _low, NULL, "low");
+
+    /* evaluate both, so that both latencies are printed */
+    bool single_ok = _run(pid_low, ROUND_SINGLE);
+    bool nested_ok = _run(pid_low, ROUND_NESTED);
+    bool sleep_ok = _run(pid_low, ROUND_SLEEP);
+
+    if (!single_ok || !nested_ok || !sleep_ok) {
+        puts("error: high priority thread waited for medium priority thread");
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+
+
+def testfunc(child):
+    child.expect_exact('mutex priority inheritance benchmark')
+    child.expect(r"priority inheritance: (on|off)")
+    child.expect(r"single: worst case: \d+ us, average: \d+ us",
+                 timeout=TIMEOUT)
+    child.expect(r"nested: worst case: \d+ us, average: \d+ us",
+                 timeout=TIMEOUT)
+    child.expect(r"sleep: worst case: \d+ us, average: \d+ us",
+                 timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of nanocoap request parsing and routing
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/nanocoap.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100000UL)
+#endif
+
+#define REQ_BUF_SIZE        (128U)
+#define RESP_BUF_SIZE       (64U)
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *ctx);
+
+/* sorted by path, as nanocoap expects */
+const coap_resource_t coap_resources[] = {
+    { "/", COAP_GET, _handler, NULL },
+    { "/.well-known/core", COAP_GET, _handler, NULL },
+    { "/actuators/led/0", COAP_GET | COAP_PUT, _handler, NULL },
+    { "/actuators/led/1", COAP_GET | COAP_PUT, _handler, NULL },
+    { "/config", COAP_GET | COAP_MATCH_SUBTREE, _handler, NULL },
+    { "/riot/board", COAP_GET, _handler, NULL },
+    { "/riot/cpu", COAP_GET, _handler, NULL },
+    { "/riot/ver", COAP_GET, _handler, NULL },
+    { "/sensors/hum/0", COAP_GET, _handler, NULL },
+    { "/sensors/hum/1", COAP_GET, _handler, NULL },
+    { "/sensors/temp/0", COAP_GET, _handler, NULL },
+    { "/sensors/temp/0/raw", COAP_GET, _handler, NULL },
+    { "/sensors/temp/1", COAP_GET, _handler, NULL },
+    { "/sensors/temp/1/raw", COAP_GET, _handler, NULL },
+    { "/sensors/temp/2", COAP_GET, _handler, NULL },
+    { "/sensors/temp/2/raw", COAP_GET, _handler, NULL },
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static uint8_t _req[REQ_BUF_SIZE];
+static size_t _req_len;
+static uint8_t _resp[RESP_BUF_SIZE];
+static coap_pkt_t _pkt;
+static unsigned _handled;
+static unsigned _errors;
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+    _handled++;
+    return coap_reply_simple(pkt, COAP_CODE_205, buf, len, COAP_FORMAT_NONE,
+                             NULL, 0);
+}
+
+static int _build_req(const char *path)
+{
+    coap_pkt_t pkt;
+    uint8_t token[2] = { 0xda, 0xec };
+
+    ssize_t len = coap_build_hdr((coap_hdr_t *)_req, COAP_TYPE_NON, token,
+                                 sizeof(token), COAP_METHOD_GET, 0x1234);
+    coap_pkt_init(&pkt, _req, sizeof(_req), len);
+
+    if ((coap_opt_add_uri_path(&pkt, path) < 0)
+            || (coap_opt_add_format(&pkt, COAP_FORMAT_TEXT) < 0)
+            || (coap_opt_add_uri_query(&pkt, "id", "17") < 0)) {
+        return -1;
+    }
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    if (len < 0) {
+        return -1;
+    }
+    _req_len = len;
+    return 0;
+}
+
+static void _parse(void)
+{
+    if (coap_parse(&_pkt, _req, _req_len) < 0) {
+        _errors++;
+    }
+}
+
+static void _route(void)
+{
+    if ((coap_parse(&_pkt, _req, _req_len) < 0)
+            || (coap_handle_req(&_pkt, _resp, sizeof(_resp)) <= 0)) {
+        _errors++;
+    }
+}
+
+static int _bench(const char *name, const char *path, bool route,
+                  bool found)
+{
+    if (_build_req(path)) {
+        printf("error: cannot build request for %s\n", path);
+        return -1;
+    }
+
+    _handled = 0;
+    _errors = 0;
+
+    if (route) {
+        BENCHMARK_FUNC(name, BENCH_RUNS, _route());
+    }
+    else {
+        BENCHMARK_FUNC(name, BENCH_RUNS, _parse());
+    }
+
+    if ((_errors > 0) || (_handled != ((route && found) ? BENCH_RUNS : 0))) {
+        printf("error: %s: %u handled, %u errors\n", name, _handled, _errors);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("nanocoap parse benchmark\n");
+
+    if (_bench("parse", "/sensors/temp/2/raw", false, false)
+            || _bench("route /", "/", true, true)
+            || _bench("route /riot/board", "/riot/board", true, true)
+            || _bench("route /sensors/temp/2/raw", "/sensors/temp/2/raw",
+                      true, true)
+            || _bench("route 404", "/sensors/temp/3", true, false)) {
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Cost of routing CoAP requests, linear scan versus trie
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/nanocoap.h"
+#include "net/nanocoap_router.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#ifndef BENCH_RESOURCES_MAX
+#define BENCH_RESOURCES_MAX (256U)
+#endif
+
+#define INSTANCES_NUMOF     (4U)
+#define PATH_LEN_MAX        (sizeof("/o000/0"))
+#define REQ_BUF_SIZE        (64U)
+#define RESP_BUF_SIZE       (64U)
+
+/* not routed through coap_handle_req(), but nanocoap requires them */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+};
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static char _paths[BENCH_RESOURCES_MAX][PATH_LEN_MAX];
+static coap_resource_t _resources[BENCH_RESOURCES_MAX];
+static nanocoap_router_t _router;
+static unsigned _numof;
+
+static uint8_t _req[REQ_BUF_SIZE];
+static size_t _req_len;
+static uint8_t _resp[RESP_BUF_SIZE];
+static coap_pkt_t _pkt;
+static unsigned _handled;
+static unsigned _errors;
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+    _handled++;
+    return coap_reply_simple(pkt, COAP_CODE_205, buf, len, COAP_FORMAT_NONE,
+                             NULL, 0);
+}
+
+static void _init_resources(void)
+{
+    /* /o<object>/<instance>, generated in order */
+    for (unsigned i = 0; i < BENCH_RESOURCES_MAX; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/o%03u/%u",
+                 i / INSTANCES_NUMOF, i % INSTANCES_NUMOF);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+        _resources[i].handler = _handler;
+        _resources[i].context = NULL;
+    }
+}
+
+static int _build_req(const char *path)
+{
+    coap_pkt_t pkt;
+    uint8_t token[2] = { 0xda, 0xec };
+
+    ssize_t len = coap_build_hdr((coap_hdr_t *)_req, COAP_TYPE_NON, token,
+                                 sizeof(token), COAP_METHOD_GET, 0x1234);
+    coap_pkt_init(&pkt, _req, sizeof(_req), len);
+
+    if (coap_opt_add_uri_path(&pkt, path) < 0) {
+        return -1;
+    }
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    if (len < 0) {
+        return -1;
+    }
+    _req_len = len;
+    return 0;
+}
+
+static void _route_linear(void)
+{
+    if ((coap_parse(&_pkt, _req, _req_len) < 0)
+            || (coap_tree_handler(&_pkt, _resp, sizeof(_resp), _resources,
+                                  _numof) <= 0)) {
+        _errors++;
+    }
+}
+
+static void _route_trie(void)
+{
+    if ((coap_parse(&_pkt, _req, _req_len) < 0)
+            || (nanocoap_router_handle(&_router, &_pkt, _resp,
+                                       sizeof(_resp)) <= 0)) {
+        _errors++;
+    }
+}
+
+static int _bench(const char *func, const char *path, bool found)
+{
+    char name[24];
+    bool trie = (strncmp(func, "trie", 4) == 0);
+
+    if (_build_req(path)) {
+        printf("error: cannot build request for %s\n", path);
+        return -1;
+    }
+
+    _handled = 0;
+    _errors = 0;
+
+    snprintf(name, sizeof(name), "%s %u", func, _numof);
+    if (trie) {
+        BENCHMARK_FUNC(name, BENCH_RUNS, _route_trie());
+    }
+    else {
+        BENCHMARK_FUNC(name, BENCH_RUNS, _route_linear());
+    }
+
+    if ((_errors > 0) || (_handled != (found ? BENCH_RUNS : 0))) {
+        printf("error: %s: %u handled, %u errors\n", name, _handled, _errors);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 16, 64, 256 };
+
+    puts("nanocoap router benchmark\n");
+
+    _init_resources();
+    for (unsigned i = 0; i < ARRAY_SIZE(numofs); i++) {
+        if (numofs[i] > BENCH_RESOURCES_MAX) {
+            break;
+        }
+        _numof = numofs[i];
+        if (nanocoap_router_init(&_router, _resources, _numof)) {
+            puts("error: cannot build trie, increase ROUTER_NODES");
+            puts("\n[FAILURE]");
+            return 1;
+        }
+
+        const char *last = _paths[_numof - 1];
+        if (_bench("linear", last, true) || _bench("trie", last, true)
+                || _bench("linear 404", "/o999/9", false)
+                || _bench("trie 404", "/o999/9", false)) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
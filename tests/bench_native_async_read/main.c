@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Frames per second received via the asynchronous read of
+ *              native through socket_zep and netdev_tap
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/ieee802154.h"
+#include "socket_zep.h"
+#include "socket_zep_params.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifdef MODULE_NETDEV_TAP
+#include "netdev_tap.h"
+#include "netdev_tap_params.h"
+#endif
+
+#define MSG_QUEUE_SIZE      (32U)
+#define MSG_TYPE_ISR        (0x3456)
+#define MSG_TYPE_REPORT     (0x3457)
+#define REPORT_INTERVAL     (1U * US_PER_SEC)
+
+typedef struct {
+    netdev_t *netdev;
+    const char *name;
+    unsigned frames;
+} bench_dev_t;
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static kernel_pid_t _main_pid;
+static uint8_t _buf[ETHERNET_FRAME_LEN];
+
+static socket_zep_t _zep;
+#ifdef MODULE_NETDEV_TAP
+static netdev_tap_t _tap;
+#endif
+
+static bench_dev_t _devs[] = {
+    { .netdev = &_zep.netdev.netdev, .name = "socket_zep" },
+#ifdef MODULE_NETDEV_TAP
+    { .netdev = &_tap.netdev, .name = "netdev_tap" },
+#endif
+};
+
+#define BENCH_DEV_NUMOF     ARRAY_SIZE(_devs)
+
+static void _event_cb(netdev_t *netdev, netdev_event_t event)
+{
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg = { .type = MSG_TYPE_ISR, .content.ptr = netdev };
+
+        if (msg_send(&msg, _main_pid) <= 0) {
+            puts("lost interrupt");
+        }
+    }
+    else if (event == NETDEV_EVENT_RX_COMPLETE) {
+        for (unsigned i = 0; i < BENCH_DEV_NUMOF; i++) {
+            if (_devs[i].netdev == netdev &&
+                netdev->driver->recv(netdev, _buf, sizeof(_buf), NULL) > 0) {
+                _devs[i].frames++;
+            }
+        }
+    }
+}
+
+static void _init(bench_dev_t *dev)
+{
+    dev->netdev->event_callback = _event_cb;
+    expect(dev->netdev->driver->init(dev->netdev) >= 0);
+}
+
+int main(void)
+{
+    xtimer_t timer;
+    msg_t report = { .type = MSG_TYPE_REPORT };
+    uint32_t last;
+
+    puts("native asynchronous read benchmark");
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    _main_pid = thread_getpid();
+
+    socket_zep_setup(&_zep, &socket_zep_params[0], 0);
+#ifdef MODULE_NETDEV_TAP
+    netdev_tap_setup(&_tap, &netdev_tap_params[0]);
+#endif
+    for (unsigned i = 0; i < BENCH_DEV_NUMOF; i++) {
+        _init(&_devs[i]);
+    }
+    printf("%s backend, %u devices\n",
+           IS_USED(MODULE_NATIVE_ASYNC_READ_EPOLL) ? "epoll" : "poll",
+           (unsigned)BENCH_DEV_NUMOF);
+
+    last = xtimer_now_usec();
+    xtimer_set_msg(&timer, REPORT_INTERVAL, &report, _main_pid);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_ISR) {
+            netdev_t *netdev = msg.content.ptr;
+
+            netdev->driver->isr(netdev);
+        }
+        else if (msg.type == MSG_TYPE_REPORT) {
+            uint32_t now = xtimer_now_usec();
+
+            for (unsigned i = 0; i < BENCH_DEV_NUMOF; i++) {
+                if (_devs[i].frames > 0) {
+                    printf("%s: %u frames/s\n", _devs[i].name,
+                           (unsigned)(((uint64_t)_devs[i].frames * US_PER_SEC) /
+                                      (now - last)));
+                    _devs[i].frames = 0;
+                }
+            }
+            last = now;
+            xtimer_set_msg(&timer, REPORT_INTERVAL, &report, _main_pid);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import socket
+import struct
+import sys
+import threading
+import time
+
+from testrunner import run
+
+DURATION = 5
+ZEP_PORT_LOCAL = int(os.environ.get('ZEP_PORT_LOCAL', 17755))
+ZEP_PORT_REMOTE = int(os.environ.get('ZEP_PORT_REMOTE', 17754))
+ZEP_CHANNEL = 26
+
+# IEEE 802.15.4 data frame to the broadcast address, with a dummy FCS
+IEEE802154_FRAME = bytes([0x41, 0x88, 0x00, 0x23, 0x00, 0xff, 0xff,
+                          0x01, 0x00]) + b'RIOT' * 16 + b'\x00\x00'
+# Ethernet broadcast frame with the local experimental ethertype
+ETHERNET_FRAME = b'\xff' * 6 + b'\x02\x00\x00\x00\x00\x01' + \
+                 b'\x88\xb5' + b'RIOT' * 64
+
+
+def zep_frame(seq):
+    return struct.pack('!2sBBBHBB8sI10sB', b'EX', 2, 1, ZEP_CHANNEL, 0, 1,
+                       0xff, b'\x00' * 8, seq, b'\x00' * 10,
+                       len(IEEE802154_FRAME)) + IEEE802154_FRAME
+
+
+def send_zep(stop):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    sock.bind(('::1', ZEP_PORT_REMOTE))
+    seq = 0
+    while not stop.is_set():
+        try:
+            sock.sendto(zep_frame(seq), ('::1', ZEP_PORT_LOCAL))
+        except OSError:
+            pass
+        seq = (seq + 1) & 0xffffffff
+    sock.close()
+
+
+def send_tap(stop, dev):
+    sock = socket.socket(socket.AF_PACKET, socket.SOCK_RAW)
+    sock.bind((dev, 0))
+    while not stop.is_set():
+        try:
+            sock.send(ETHERNET_FRAME)
+        except OSError:
+            pass
+    sock.close()
+
+
+def measure(child, name, sender, *args):
+    stop = threading.Event()
+    thread = threading.Thread(target=sender, args=(stop,) + args)
+    rates = []
+
+    thread.start()
+    end = time.time() + DURATION
+    while time.time() < end:
+        child.expect(r'{}: (\d+) frames/s'.format(name))
+        rates.append(int(child.match.group(1)))
+    stop.set()
+    thread.join()
+    print('{}: {} frames/s at most'.format(name, max(rates)))
+
+
+def testfunc(child):
+    child.expect(r'(\w+) backend, (\d+) devices')
+    devices = int(child.match.group(2))
+    measure(child, 'socket_zep', send_zep)
+    if devices > 1:
+        measure(child, 'netdev_tap', send_tap, os.environ['TAPDEV'])
+
+
+if __name__ == '__main__':
+    sys.exit(run(testfunc, timeout=DURATION + 5, echo=False))
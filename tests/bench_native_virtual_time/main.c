@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Simulates long timer driven scenarios on native
+ *
+ * Several threads sleep with different periods for a simulated duration and
+ * count their wakeups. With module native_virtual_time this runs as fast as
+ * the host can execute it.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef SIM_DURATION_S
+#define SIM_DURATION_S      (3600U)
+#endif
+
+#define SLEEPER_NUMOF       (3U)
+
+static char _stacks[SLEEPER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static const uint32_t _periods_ms[SLEEPER_NUMOF] = { 10, 250, 1000 };
+static unsigned _wakeups[SLEEPER_NUMOF];
+static kernel_pid_t _main_pid;
+
+static void *_sleeper(void *arg)
+{
+    unsigned idx = (unsigned)(uintptr_t)arg;
+    uint32_t period = _periods_ms[idx] * US_PER_MS;
+    xtimer_ticks32_t last = xtimer_now();
+    msg_t msg;
+
+    for (uint32_t i = 0; i < (SIM_DURATION_S * MS_PER_SEC) / _periods_ms[idx];
+         i++) {
+        /* some jitter, so wakeups interleave */
+        xtimer_periodic_wakeup(&last, period);
+        xtimer_spin(xtimer_ticks_from_usec(random_uint32_range(0, 100)));
+        _wakeups[idx]++;
+    }
+    msg_send(&msg, _main_pid);
+    return NULL;
+}
+
+int main(void)
+{
+    uint64_t start = xtimer_now_usec64();
+    unsigned expected = 0;
+    unsigned total = 0;
+    msg_t msg;
+
+    printf("simulating %u s\n", SIM_DURATION_S);
+    _main_pid = thread_getpid();
+    for (unsigned i = 0; i < SLEEPER_NUMOF; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _sleeper, (void *)(uintptr_t)i,
+                      "sleeper");
+    }
+    for (unsigned i = 0; i < SLEEPER_NUMOF; i++) {
+        msg_receive(&msg);
+    }
+    for (unsigned i = 0; i < SLEEPER_NUMOF; i++) {
+        expected += (SIM_DURATION_S * MS_PER_SEC) / _periods_ms[i];
+        total += _wakeups[i];
+    }
+    printf("%u wakeups in %u s of simulated time\n", total,
+           (unsigned)((xtimer_now_usec64() - start) / US_PER_SEC));
+    puts((total == expected) ? "[SUCCESS]" : "[FAILURE]");
+    return 0;
+}
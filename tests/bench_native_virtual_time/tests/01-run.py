@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+import time
+
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r'simulating (\d+) s')
+    duration = int(child.match.group(1))
+    start = time.monotonic()
+    child.expect(r'(\d+) wakeups in (\d+) s of simulated time',
+                 timeout=2 * duration)
+    elapsed = time.monotonic() - start
+    simulated = int(child.match.group(2))
+    assert simulated >= duration
+    child.expect_exact('[SUCCESS]')
+    print('{} s simulated in {:.1f} s, speedup {:.0f}x'.format(
+          simulated, elapsed, simulated / elapsed))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
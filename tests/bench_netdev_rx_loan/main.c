@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of zero-copy receive with loaned netdev buffers
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev/eth.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#ifndef BENCH_FRAME_SIZE
+#define BENCH_FRAME_SIZE    (ETHERNET_DATA_LEN)
+#endif
+
+#define RX_BUF_NUMOF        (4U)
+#define QUEUE_SIZE          (8U)
+
+static const uint8_t _addr[ETHERNET_ADDR_LEN] = {
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x01
+};
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_netif_t _netif;
+static netdev_t _dev;
+
+/* receive buffers of the mock device, filled once as the frames' content
+ * does not matter */
+static uint8_t _rx_bufs[RX_BUF_NUMOF][sizeof(ethernet_hdr_t) + BENCH_FRAME_SIZE];
+/* buffers holding a received or lent out frame */
+static uint8_t _rx_used;
+/* buffer holding the frame to receive next, -1 if none */
+static int _rx_pending = -1;
+
+static void _rx_buf_free(unsigned idx)
+{
+    unsigned state = irq_disable();
+
+    _rx_used &= ~(1U << idx);
+    irq_restore(state);
+}
+
+/* lets the mock device receive a frame, as its DMA would */
+static int _hw_receive(void)
+{
+    unsigned state = irq_disable();
+    unsigned avail = ~_rx_used & ((1U << RX_BUF_NUMOF) - 1);
+
+    if ((avail == 0) || (_rx_pending >= 0)) {
+        irq_restore(state);
+        return -ENOBUFS;
+    }
+    _rx_pending = bitarithm_lsb(avail);
+    _rx_used |= 1U << _rx_pending;
+    irq_restore(state);
+    netdev_trigger_event_isr(&_dev);
+    return 0;
+}
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    int idx = _rx_pending;
+
+    (void)dev;
+    (void)info;
+    if (idx < 0) {
+        return 0;
+    }
+    if ((buf == NULL) && (len == 0)) {
+        return sizeof(_rx_bufs[idx]);
+    }
+    _rx_pending = -1;
+    if (buf == NULL) {
+        _rx_buf_free(idx);
+        return sizeof(_rx_bufs[idx]);
+    }
+    if (len < sizeof(_rx_bufs[idx])) {
+        _rx_buf_free(idx);
+        return -ENOBUFS;
+    }
+    memcpy(buf, _rx_bufs[idx], sizeof(_rx_bufs[idx]));
+    _rx_buf_free(idx);
+    return sizeof(_rx_bufs[idx]);
+}
+
+static int _recv_loan(netdev_t *dev, void **buf, void *info)
+{
+    int idx = _rx_pending;
+
+    (void)dev;
+    (void)info;
+    if (idx < 0) {
+        return 0;
+    }
+    _rx_pending = -1;
+    *buf = _rx_bufs[idx];
+    return sizeof(_rx_bufs[idx]);
+}
+
+static void _recv_return(netdev_t *dev, void *buf)
+{
+    (void)dev;
+    _rx_buf_free(((uint8_t *)buf - _rx_bufs[0]) / sizeof(_rx_bufs[0]));
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    (void)iolist;
+    return -ENOTSUP;
+}
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    for (unsigned i = 0; i < RX_BUF_NUMOF; i++) {
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)_rx_bufs[i];
+
+        memcpy(hdr->dst, _addr, sizeof(hdr->dst));
+        memcpy(hdr->src, _addr, sizeof(hdr->src));
+        hdr->type = byteorder_htons(ETHERTYPE_CUSTOM);
+    }
+    return 0;
+}
+
+static void _isr(netdev_t *dev)
+{
+    if (_rx_pending >= 0) {
+        dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+    }
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, _addr, sizeof(_addr));
+        return sizeof(_addr);
+    }
+    return netdev_eth_get(dev, opt, value, max_len);
+}
+
+static const netdev_driver_t _driver_copy = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = netdev_eth_set,
+};
+
+static const netdev_driver_t _driver_loan = {
+    .send = _send,
+    .recv = _recv,
+    .recv_loan = _recv_loan,
+    .recv_return = _recv_return,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = netdev_eth_set,
+};
+
+static bool _in_rx_buf(const void *data)
+{
+    const uint8_t *p = data;
+
+    return (p >= _rx_bufs[0]) && (p < _rx_bufs[RX_BUF_NUMOF]);
+}
+
+static int _bench(bool loan)
+{
+    const char *mode = loan ? "loan" : "copy";
+    unsigned long zero_copy = 0;
+
+    _dev.driver = loan ? &_driver_loan : &_driver_copy;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        msg_t msg;
+
+        if (_hw_receive() < 0) {
+            puts("error: no receive buffer left");
+            return -1;
+        }
+        /* the interface thread has a higher priority, so the frame
+         * is already waiting */
+        msg_receive(&msg);
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            puts("error: unexpected message");
+            return -1;
+        }
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        if (pkt->size != BENCH_FRAME_SIZE) {
+            printf("error: received %u of %u bytes\n", (unsigned)pkt->size,
+                   (unsigned)BENCH_FRAME_SIZE);
+            gnrc_pktbuf_release(pkt);
+            return -1;
+        }
+        if (_in_rx_buf(pkt->data)) {
+            zero_copy++;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("%s: %lu frames per sec, %lu frames zero-copy\n", mode,
+           (unsigned long)(((uint64_t)BENCH_RUNS * US_PER_SEC) / time),
+           zero_copy);
+    if (loan && (zero_copy != BENCH_RUNS)) {
+        puts("error: frames were copied");
+        return -1;
+    }
+    if (_rx_used != 0) {
+        puts("error: receive buffers were not returned");
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    msg_t msg_queue[QUEUE_SIZE];
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                        GNRC_NETREG_DEMUX_CTX_ALL,
+                                        thread_getpid());
+
+    puts("netdev zero-copy receive benchmark\n");
+
+    msg_init_queue(msg_queue, QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_CUSTOM, &entry);
+    _dev.driver = &_driver_copy;
+    if (gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                   sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                   "loop", &_dev) < 0) {
+        puts("error: unable to create interface\n[FAILURE]");
+        return 1;
+    }
+
+    if (_bench(false) || _bench(true)) {
+        puts("\n[FAILURE]");
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
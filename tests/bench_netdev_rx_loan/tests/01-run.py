@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+RESULT_REGEXP = r"{mode}: (\d+) frames per sec, (\d+) frames zero-copy"
+
+
+def testfunc(child):
+    child.expect_exact('netdev zero-copy receive benchmark')
+    child.expect(RESULT_REGEXP.format(mode="copy"), timeout=TIMEOUT)
+    assert int(child.match.group(2)) == 0
+    child.expect(RESULT_REGEXP.format(mode="loan"), timeout=TIMEOUT)
+    assert int(child.match.group(2)) > 0
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of ringbuffer and tsrb for several chunk sizes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "ringbuffer.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (1024UL * 1024UL)
+#endif
+
+#define BUF_SIZE            (512U)
+#define CHUNK_MAX           (256U)
+
+static char _rb_buf[BUF_SIZE];
+static uint8_t _tsrb_buf[BUF_SIZE];
+static uint8_t _in[CHUNK_MAX];
+static uint8_t _out[CHUNK_MAX];
+
+static void _print(const char *name, unsigned chunk, uint32_t time)
+{
+    /* bytes per usec are MB/s */
+    unsigned long kb_per_sec = (BENCH_BYTES * 1000ULL) / time;
+
+    printf("%s %u byte chunks: %lu.%03lu MB/s\n", name, chunk,
+           kb_per_sec / 1000, kb_per_sec % 1000);
+}
+
+static int _bench_ringbuffer(unsigned chunk)
+{
+    ringbuffer_t rb;
+
+    ringbuffer_init(&rb, _rb_buf, sizeof(_rb_buf));
+    /* keep the buffer half full, so chunks wrap around its end */
+    ringbuffer_add(&rb, (char *)_in, BUF_SIZE / 2);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long n = 0; n < BENCH_BYTES; n += chunk) {
+        if ((ringbuffer_add(&rb, (char *)_in, chunk) != chunk) ||
+            (ringbuffer_get(&rb, (char *)_out, chunk) != chunk)) {
+            return -1;
+        }
+    }
+    _print("ringbuffer", chunk, xtimer_now_usec() - start);
+    return 0;
+}
+
+static int _bench_tsrb(unsigned chunk)
+{
+    tsrb_t rb;
+
+    tsrb_init(&rb, _tsrb_buf, sizeof(_tsrb_buf));
+    tsrb_add(&rb, _in, BUF_SIZE / 2);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long n = 0; n < BENCH_BYTES; n += chunk) {
+        if ((tsrb_add(&rb, _in, chunk) != (int)chunk) ||
+            (tsrb_get(&rb, _out, chunk) != (int)chunk)) {
+            return -1;
+        }
+    }
+    _print("tsrb", chunk, xtimer_now_usec() - start);
+    return 0;
+}
+
+static int _bench_tsrb_in_place(unsigned chunk)
+{
+    tsrb_t rb;
+
+    tsrb_init(&rb, _tsrb_buf, sizeof(_tsrb_buf));
+    tsrb_add(&rb, _in, BUF_SIZE / 2);
+
+    /* a producer writing in place, as a DMA transfer would, and a consumer
+     * reading in place, as a frame decoder would */
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long n = 0; n < BENCH_BYTES; n += chunk) {
+        for (unsigned left = chunk; left > 0;) {
+            uint8_t *space;
+            size_t len = tsrb_reserve_contiguous(&rb, &space);
+
+            len = (len > left) ? left : len;
+            memset(space, n, len);
+            tsrb_commit(&rb, len);
+            left -= len;
+        }
+        for (unsigned left = chunk; left > 0;) {
+            const uint8_t *data;
+            size_t len = tsrb_peek_contiguous(&rb, &data);
+
+            len = (len > left) ? left : len;
+            if (len == 0) {
+                return -1;
+            }
+            tsrb_drop(&rb, len);
+            left -= len;
+        }
+    }
+    _print("tsrb in place", chunk, xtimer_now_usec() - start);
+    return 0;
+}
+
+int main(void)
+{
+    static const unsigned chunks[] = { 1, 16, 64, CHUNK_MAX };
+
+    puts("ringbuffer and tsrb throughput benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(chunks); i++) {
+        if (_bench_ringbuffer(chunks[i]) || _bench_tsrb(chunks[i]) ||
+            _bench_tsrb_in_place(chunks[i])) {
+            printf("error: ringbuffer ran empty or full for %u byte chunks\n",
+                   chunks[i]);
+            puts("\n[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+
+
+def testfunc(child):
+    child.expect_exact('ringbuffer and tsrb throughput benchmark')
+    for chunk in (1, 16, 64, 256):
+        for name in ("ringbuffer", "tsrb", "tsrb in place"):
+            child.expect(r"{} {} byte chunks: \d+\.\d+ MB/s".format(name, chunk),
+                         timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
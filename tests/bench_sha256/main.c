@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of SHA-256
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define MSG_NUMOF           (4U)
+#define MSG_SIZE_MAX        (1024U)
+
+static uint8_t _msgs[MSG_NUMOF][MSG_SIZE_MAX];
+static uint8_t _digests[MSG_NUMOF][SHA256_DIGEST_LENGTH];
+static uint8_t _expected[MSG_NUMOF][SHA256_DIGEST_LENGTH];
+
+static const void *const _data[MSG_NUMOF] = {
+    _msgs[0], _msgs[1], _msgs[2], _msgs[3]
+};
+static void *const _out[MSG_NUMOF] = {
+    _digests[0], _digests[1], _digests[2], _digests[3]
+};
+
+static void _print(size_t len, uint32_t time)
+{
+    uint64_t bytes = (uint64_t)BENCH_RUNS * MSG_NUMOF * len;
+
+    time = time ? time : 1;
+    printf("%4u B: %" PRIu32 " bytes/s", (unsigned)len,
+           (uint32_t)(bytes * US_PER_SEC / time));
+#ifdef CLOCK_CORECLOCK
+    /* in hundredths of a cycle */
+    uint64_t cycles = (uint64_t)time * (CLOCK_CORECLOCK / 10000UL) / bytes;
+    printf(", %" PRIu32 ".%02" PRIu32 " cycles/byte",
+           (uint32_t)(cycles / 100), (uint32_t)(cycles % 100));
+#endif
+    puts("");
+}
+
+static int _bench(size_t len)
+{
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        sha256_context_t ctx;
+
+        sha256_init(&ctx);
+        sha256_update(&ctx, _msgs[i], len);
+        sha256_final(&ctx, _expected[i]);
+    }
+
+    uint32_t time = xtimer_now_usec();
+    for (unsigned long run = 0; run < BENCH_RUNS; run++) {
+        sha256_multi(_data, len, _out, MSG_NUMOF);
+    }
+    time = xtimer_now_usec() - time;
+    _print(len, time);
+
+    if (memcmp(_digests, _expected, sizeof(_digests))) {
+        printf("error: digests differ for %u B\n", (unsigned)len);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const size_t lens[] = { SHA256_DIGEST_LENGTH, 64, MSG_SIZE_MAX };
+
+    puts("sha256 benchmark\n");
+
+    for (unsigned i = 0; i < sizeof(_msgs); i++) {
+        _msgs[i / MSG_SIZE_MAX][i % MSG_SIZE_MAX] = i;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        if (_bench(lens[i])) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of SHA3-256 and SHAKE128
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha3.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (200UL)
+#endif
+
+#define MSG_SIZE_MAX        (1024U)
+#define SHAKE_OUT_LEN       (32U)
+
+static uint8_t _msg[MSG_SIZE_MAX];
+static uint8_t _digest[SHA3_256_DIGEST_LENGTH];
+
+static void _print(const char *name, size_t len, uint32_t time)
+{
+    uint64_t bytes = (uint64_t)BENCH_RUNS * len;
+
+    time = time ? time : 1;
+    printf("%8s %4u B: %" PRIu32 " bytes/s", name, (unsigned)len,
+           (uint32_t)(bytes * US_PER_SEC / time));
+#ifdef CLOCK_CORECLOCK
+    /* in hundredths of a cycle */
+    uint64_t cycles = (uint64_t)time * (CLOCK_CORECLOCK / 10000UL) / bytes;
+    printf(", %" PRIu32 ".%02" PRIu32 " cycles/byte",
+           (uint32_t)(cycles / 100), (uint32_t)(cycles % 100));
+#endif
+    puts("");
+}
+
+static void _bench(size_t len)
+{
+    uint32_t time = xtimer_now_usec();
+
+    for (unsigned long run = 0; run < BENCH_RUNS; run++) {
+        sha3_256(_digest, _msg, len);
+    }
+    time = xtimer_now_usec() - time;
+    _print("sha3-256", len, time);
+
+    time = xtimer_now_usec();
+    for (unsigned long run = 0; run < BENCH_RUNS; run++) {
+        shake128(_digest, SHAKE_OUT_LEN, _msg, len);
+    }
+    time = xtimer_now_usec() - time;
+    _print("shake128", len, time);
+}
+
+int main(void)
+{
+    static const size_t lens[] = { 32, 136, MSG_SIZE_MAX };
+
+    puts("sha3 benchmark\n");
+
+    for (unsigned i = 0; i < MSG_SIZE_MAX; i++) {
+        _msg[i] = i;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        _bench(lens[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
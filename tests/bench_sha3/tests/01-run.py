@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+LENGTHS = (32, 136, 1024)
+
+
+def testfunc(child):
+    child.expect_exact('sha3 benchmark')
+    for length in LENGTHS:
+        for name in ("sha3-256", "shake128"):
+            child.expect(r"\s*{}\s+{} B: \d+ bytes/s".format(name, length),
+                         timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
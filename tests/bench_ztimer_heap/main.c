@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the runtime of ztimer clocks using a list or a heap
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#ifndef BENCH_TIMERS_MAX
+#define BENCH_TIMERS_MAX    (1000U)
+#endif
+
+/* expiry is measured in rounds, until at least this many timers triggered */
+#define BENCH_EXPIRE_RUNS   (1000U)
+
+/* all timers are set within [OFFSET_MIN, OFFSET_MIN + OFFSET_RANGE) */
+#define OFFSET_MIN          (1000U)
+#define OFFSET_RANGE        (0x10000U)
+
+static ztimer_t _timers[BENCH_TIMERS_MAX + 1];
+static ztimer_mock_t _mock;
+static unsigned _fired;
+static uint32_t _rand_state = 0x12345678;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, good enough to scramble the timer offsets */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static uint32_t _rand_offset(void)
+{
+    return OFFSET_MIN + (_rand() % OFFSET_RANGE);
+}
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    _fired++;
+}
+
+static void _arm(ztimer_clock_t *clock, unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_set(clock, &_timers[i], _rand_offset());
+    }
+}
+
+static void _disarm(ztimer_clock_t *clock, unsigned numof)
+{
+    for (unsigned i = 0; i <= numof; i++) {
+        ztimer_remove(clock, &_timers[i]);
+    }
+}
+
+static void _set_remove(ztimer_clock_t *clock, unsigned numof)
+{
+    ztimer_set(clock, &_timers[numof], _rand_offset());
+    ztimer_remove(clock, &_timers[numof]);
+}
+
+static void _reset(ztimer_clock_t *clock, unsigned numof)
+{
+    ztimer_set(clock, &_timers[_rand() % numof], _rand_offset());
+}
+
+static int _bench(unsigned numof, bool heap)
+{
+    ztimer_clock_t *clock = &_mock.super;
+    const char *queue = heap ? "heap" : "list";
+    char name[32];
+
+    ztimer_mock_init(&_mock, 32);
+    if (heap) {
+        ztimer_clock_use_heap(clock);
+    }
+
+    _arm(clock, numof);
+
+    snprintf(name, sizeof(name), "%s %u set/remove", queue, numof);
+    BENCHMARK_FUNC(name, BENCH_RUNS, _set_remove(clock, numof));
+    snprintf(name, sizeof(name), "%s %u reset", queue, numof);
+    BENCHMARK_FUNC(name, BENCH_RUNS, _reset(clock, numof));
+
+    _disarm(clock, numof);
+
+    /* measure only the time spent in the ISR, not the time spent arming */
+    uint32_t time = 0;
+    unsigned runs = 0;
+    while (runs < BENCH_EXPIRE_RUNS) {
+        _fired = 0;
+        _arm(clock, numof);
+        uint32_t start = xtimer_now_usec();
+        ztimer_mock_advance(&_mock, OFFSET_MIN + OFFSET_RANGE);
+        time += xtimer_now_usec() - start;
+        if (_fired != numof) {
+            printf("error: %u of %u timers triggered\n", _fired, numof);
+            return -1;
+        }
+        runs += numof;
+    }
+    snprintf(name, sizeof(name), "%s %u expire", queue, numof);
+    benchmark_print_time(time, runs, name);
+
+    return 0;
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 10, 100, 1000 };
+
+    puts("ztimer list vs. heap benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_timers); i++) {
+        _timers[i].callback = _cb;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(numofs); i++) {
+        if (numofs[i] > BENCH_TIMERS_MAX) {
+            break;
+        }
+        if (_bench(numofs[i], false) || _bench(numofs[i], true)) {
+            puts("\n[FAILURE]");
+            return 1;
+        }
+        puts("");
+    }
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+
+
+def testfunc(child):
+    child.expect_exact('ztimer list vs. heap benchmark')
+    for numof in (10, 100, 1000):
+        for queue in ("list", "heap"):
+            for op in ("set/remove", "reset", "expire"):
+                child.expect(BENCHMARK_REGEXP.format(
+                    func="{} {} {}".format(queue, numof, op)), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
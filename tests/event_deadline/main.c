@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the order of events posted with a deadline hint
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "event.h"
+#include "kernel_defines.h"
+#include "test_utils/expect.h"
+
+#define EVENTS_NUMOF    (8U)
+
+static void _handler(event_t *event)
+{
+    (void)event;
+}
+
+static event_queue_t _queue;
+static event_t _events[EVENTS_NUMOF];
+
+/* takes all events from the queue and compares them with the expected ones */
+static void _expect_order(const unsigned *order, unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        event_t *event = event_get(&_queue);
+
+        expect(event == &_events[order[i]]);
+    }
+    expect(event_get(&_queue) == NULL);
+}
+
+static void test_sorted(void)
+{
+    static const uint32_t deadlines[] = { 30, 10, 20, 10, 40 };
+    static const unsigned order[] = { 1, 3, 2, 0, 4 };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(deadlines); i++) {
+        event_post_deadline(&_queue, &_events[i], deadlines[i]);
+    }
+    /* reposting a queued event has no effect */
+    event_post_deadline(&_queue, &_events[4], 0);
+    _expect_order(order, ARRAY_SIZE(order));
+    puts("sorted: OK");
+}
+
+static void test_before_plain(void)
+{
+    static const unsigned order[] = { 3, 2, 0, 1 };
+
+    event_post(&_queue, &_events[0]);
+    event_post_deadline(&_queue, &_events[2], 20);
+    event_post(&_queue, &_events[1]);
+    event_post_deadline(&_queue, &_events[3], 10);
+    _expect_order(order, ARRAY_SIZE(order));
+    puts("before plain: OK");
+}
+
+static void test_wraparound(void)
+{
+    static const unsigned order[] = { 0, 1, 2 };
+
+    event_post_deadline(&_queue, &_events[2], 5);
+    event_post_deadline(&_queue, &_events[0], UINT32_MAX - 5);
+    event_post_deadline(&_queue, &_events[1], UINT32_MAX);
+    _expect_order(order, ARRAY_SIZE(order));
+    puts("wraparound: OK");
+}
+
+static void test_cancel(void)
+{
+    static const unsigned order_last[] = { 0, 3, 2 };
+    static const unsigned order_head[] = { 4, 5, 6 };
+
+    /* cancel the last event with a deadline */
+    event_post_deadline(&_queue, &_events[0], 10);
+    event_post_deadline(&_queue, &_events[1], 20);
+    event_post(&_queue, &_events[2]);
+    event_cancel(&_queue, &_events[1]);
+    event_post_deadline(&_queue, &_events[3], 30);
+    _expect_order(order_last, ARRAY_SIZE(order_last));
+
+    /* cancel the only event with a deadline, at the head of the queue */
+    event_post_deadline(&_queue, &_events[7], 10);
+    event_post(&_queue, &_events[5]);
+    event_post(&_queue, &_events[6]);
+    event_cancel(&_queue, &_events[7]);
+    event_post_deadline(&_queue, &_events[4], 20);
+    _expect_order(order_head, ARRAY_SIZE(order_head));
+    puts("cancel: OK");
+}
+
+static void test_wait_multi(void)
+{
+    static const unsigned order[] = { 1, 0 };
+
+    event_post(&_queue, &_events[0]);
+    event_post_deadline(&_queue, &_events[1], 10);
+    expect(event_wait_multi(&_queue, 1) == &_events[1]);
+    /* the queue has no event with a deadline anymore */
+    event_post_deadline(&_queue, &_events[1], 20);
+    _expect_order(order, ARRAY_SIZE(order));
+    puts("wait multi: OK");
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        _events[i].handler = _handler;
+    }
+    event_queue_init(&_queue);
+
+    test_sorted();
+    test_before_plain();
+    test_wraparound();
+    test_cancel();
+    test_wait_multi();
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the network protocol registry with entries of different
+ *              demultiplexing contexts sharing hash buckets
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "thread.h"
+
+#define TEST_PORT       (49152U)
+#define TEST_ENTRIES    (4 * GNRC_NETREG_BUCKETS)
+
+static msg_t _msg_queue[1];
+static gnrc_netreg_entry_t _entries[TEST_ENTRIES];
+
+static void _set_up(void)
+{
+    gnrc_netreg_init();
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        gnrc_netreg_entry_init_pid(&_entries[i], TEST_PORT + i, thread_getpid());
+    }
+}
+
+static void test_netreg_buckets__lookup(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP, &_entries[i]));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        gnrc_netreg_entry_t *res;
+        int num = -1;
+
+        TEST_ASSERT(&_entries[i] == (res = gnrc_netreg_lookup(GNRC_NETTYPE_UDP,
+                                                              TEST_PORT + i)));
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        TEST_ASSERT(res == gnrc_netreg_lookup_num(GNRC_NETTYPE_UDP, TEST_PORT + i,
+                                                  &num));
+        TEST_ASSERT_EQUAL_INT(1, num);
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_UDP,
+                                        TEST_PORT + ARRAY_SIZE(_entries)));
+}
+
+static void test_netreg_buckets__getnext_skips_other_ctx(void)
+{
+    gnrc_netreg_entry_t same = GNRC_NETREG_ENTRY_INIT_PID(TEST_PORT, thread_getpid());
+    gnrc_netreg_entry_t *res;
+
+    /* _entries[GNRC_NETREG_BUCKETS] shares the bucket of _entries[0], and is
+     * registered in between the two entries for TEST_PORT */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP, &_entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP,
+                                                  &_entries[GNRC_NETREG_BUCKETS]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP, &same));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_UDP, TEST_PORT));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_UDP, TEST_PORT)));
+    TEST_ASSERT_EQUAL_INT(TEST_PORT, res->demux_ctx);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT_EQUAL_INT(TEST_PORT, res->demux_ctx);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_UDP,
+                                             TEST_PORT + GNRC_NETREG_BUCKETS));
+}
+
+static void test_netreg_buckets__unregister(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP, &_entries[i]));
+    }
+    /* remove every other entry of each bucket, leaving two in each */
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        if (!((i / GNRC_NETREG_BUCKETS) & 1)) {
+            gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &_entries[i]);
+        }
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_UDP, TEST_PORT + i);
+
+        if ((i / GNRC_NETREG_BUCKETS) & 1) {
+            TEST_ASSERT(&_entries[i] == res);
+        }
+        else {
+            TEST_ASSERT_NULL(res);
+        }
+    }
+}
+
+static void test_netreg_buckets__ctx_all(void)
+{
+    gnrc_netreg_entry_t zero = GNRC_NETREG_ENTRY_INIT_PID(0, thread_getpid());
+    gnrc_netreg_entry_t all = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                         thread_getpid());
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP, &zero));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP, &all));
+    TEST_ASSERT(&zero == gnrc_netreg_lookup(GNRC_NETTYPE_UDP, 0));
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(&zero));
+    TEST_ASSERT(&all == gnrc_netreg_lookup(GNRC_NETTYPE_UDP,
+                                           GNRC_NETREG_DEMUX_CTX_ALL));
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(&all));
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netreg_buckets__lookup),
+        new_TestFixture(test_netreg_buckets__getnext_skips_other_ctx),
+        new_TestFixture(test_netreg_buckets__unregister),
+        new_TestFixture(test_netreg_buckets__ctx_all),
+    };
+
+    EMB_UNIT_TESTCALLER(netreg_buckets_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&netreg_buckets_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    /* netreg requires a message queue of the registered thread */
+    msg_init_queue(_msg_queue, ARRAY_SIZE(_msg_queue));
+    run_unittests();
+    return 0;
+}
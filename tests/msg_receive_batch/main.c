@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for batched receive from the message queue
+ *              and from message channels
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "msg_chan.h"
+#include "thread.h"
+
+#define MSG_QUEUE_LENGTH    (8)
+#define BATCH_SIZE          (5)
+#define CHAN_FLAG           (0x1)
+
+static msg_t _msg_queue[MSG_QUEUE_LENGTH];
+static msg_chan_slot_t _slots[MSG_QUEUE_LENGTH];
+static msg_chan_t _chan;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static int _check(const msg_t *msgs, unsigned numof, unsigned first)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        if (msgs[i].type != first + i) {
+            printf("error: got message %u, expected %u\n",
+                   (unsigned)msgs[i].type, first + i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _test_queue(void)
+{
+    msg_t msgs[BATCH_SIZE];
+    unsigned n;
+
+    for (unsigned i = 0; i < MSG_QUEUE_LENGTH; i++) {
+        msg_t msg = { .type = i };
+        msg_send_to_self(&msg);
+    }
+    n = msg_receive_batch(msgs, BATCH_SIZE);
+    if ((n != BATCH_SIZE) || _check(msgs, n, 0)) {
+        return -1;
+    }
+    n = msg_receive_batch(msgs, BATCH_SIZE);
+    if ((n != MSG_QUEUE_LENGTH - BATCH_SIZE) || _check(msgs, n, BATCH_SIZE)) {
+        return -1;
+    }
+    return (msg_avail() == 0) ? 0 : -1;
+}
+
+static void *_producer(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < MSG_QUEUE_LENGTH; i++) {
+        msg_t msg = { .type = i };
+        if (msg_chan_try_put(&_chan, &msg) != 1) {
+            puts("error: channel full");
+        }
+    }
+    return NULL;
+}
+
+static int _test_chan(void)
+{
+    msg_t msgs[BATCH_SIZE];
+    msg_t msg = { .type = 0 };
+    unsigned n;
+
+    msg_chan_init(&_chan, _slots, MSG_QUEUE_LENGTH, CHAN_FLAG);
+    if (msg_chan_try_receive_batch(&_chan, msgs, BATCH_SIZE) != 0) {
+        return -1;
+    }
+    /* the producer has a lower priority, so it only runs while the main
+     * thread waits for the channel */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, _producer, NULL, "producer");
+    for (unsigned first = 0; first < MSG_QUEUE_LENGTH; first += n) {
+        n = msg_chan_receive_batch(&_chan, msgs, BATCH_SIZE);
+        if (_check(msgs, n, first)) {
+            return -1;
+        }
+    }
+    /* the channel accepts messages again after being drained */
+    for (unsigned i = 0; i < MSG_QUEUE_LENGTH; i++) {
+        if (msg_chan_try_put(&_chan, &msg) != 1) {
+            return -1;
+        }
+    }
+    if (msg_chan_try_put(&_chan, &msg) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_msg_queue, MSG_QUEUE_LENGTH);
+
+    puts("[START]");
+    if (_test_queue() || _test_chan()) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/gcm.h"
+#include "kernel_defines.h"
+#include "tests-crypto.h"
+
+/* Test cases 1 to 6 of "The Galois/Counter Mode of Operation (GCM)" by
+ * McGrew and Viega, as used for the NIST validation of AES-128-GCM */
+static const uint8_t TEST_KEY_ZERO[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t TEST_NONCE_ZERO[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t TEST_BLOCK_ZERO[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t TEST_KEY[] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+
+static const uint8_t TEST_NONCE_96[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88,
+};
+
+static const uint8_t TEST_NONCE_64[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+};
+
+static const uint8_t TEST_NONCE_480[] = {
+    0x93, 0x13, 0x22, 0x5d, 0xf8, 0x84, 0x06, 0xe5,
+    0x55, 0x90, 0x9c, 0x5a, 0xff, 0x52, 0x69, 0xaa,
+    0x6a, 0x7a, 0x95, 0x38, 0x53, 0x4f, 0x7d, 0xa1,
+    0xe4, 0xc3, 0x03, 0xd2, 0xa3, 0x18, 0xa7, 0x28,
+    0xc3, 0xc0, 0xc9, 0x51, 0x56, 0x80, 0x95, 0x39,
+    0xfc, 0xf0, 0xe2, 0x42, 0x9a, 0x6b, 0x52, 0x54,
+    0x16, 0xae, 0xdb, 0xf5, 0xa0, 0xde, 0x6a, 0x57,
+    0xa6, 0x37, 0xb3, 0x9b,
+};
+
+static const uint8_t TEST_PLAIN[] = {
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5,
+    0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+    0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+    0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53,
+    0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57,
+    0xba, 0x63, 0x7b, 0x39, 0x1a, 0xaf, 0xd2, 0x55,
+};
+
+static const uint8_t TEST_ADATA[] = {
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+    0xab, 0xad, 0xda, 0xd2,
+};
+
+/* Test Case 1 */
+static const uint8_t TEST_1_EXPECTED[] = {
+    0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61,
+    0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a,
+};
+
+/* Test Case 2 */
+static const uint8_t TEST_2_EXPECTED[] = {
+    0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92,
+    0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78,
+    0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd,
+    0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf,
+};
+
+/* Test Case 3 */
+static const uint8_t TEST_3_EXPECTED[] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+    0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+    0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+    0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+    0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+    0x3d, 0x58, 0xe0, 0x91, 0x47, 0x3f, 0x59, 0x85,
+    0x4d, 0x5c, 0x2a, 0xf3, 0x27, 0xcd, 0x64, 0xa6,
+    0x2c, 0xf3, 0x5a, 0xbd, 0x2b, 0xa6, 0xfa, 0xb4,
+};
+
+/* Test Case 4 */
+static const uint8_t TEST_4_EXPECTED[] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+    0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+    0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+    0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+    0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+    0x3d, 0x58, 0xe0, 0x91, 0x5b, 0xc9, 0x4f, 0xbc,
+    0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a,
+    0xe7, 0x12, 0x1a, 0x47,
+};
+
+/* Test Case 5 */
+static const uint8_t TEST_5_EXPECTED[] = {
+    0x61, 0x35, 0x3b, 0x4c, 0x28, 0x06, 0x93, 0x4a,
+    0x77, 0x7f, 0xf5, 0x1f, 0xa2, 0x2a, 0x47, 0x55,
+    0x69, 0x9b, 0x2a, 0x71, 0x4f, 0xcd, 0xc6, 0xf8,
+    0x37, 0x66, 0xe5, 0xf9, 0x7b, 0x6c, 0x74, 0x23,
+    0x73, 0x80, 0x69, 0x00, 0xe4, 0x9f, 0x24, 0xb2,
+    0x2b, 0x09, 0x75, 0x44, 0xd4, 0x89, 0x6b, 0x42,
+    0x49, 0x89, 0xb5, 0xe1, 0xeb, 0xac, 0x0f, 0x07,
+    0xc2, 0x3f, 0x45, 0x98, 0x36, 0x12, 0xd2, 0xe7,
+    0x9e, 0x3b, 0x07, 0x85, 0x56, 0x1b, 0xe1, 0x4a,
+    0xac, 0xa2, 0xfc, 0xcb,
+};
+
+/* Test Case 6 */
+static const uint8_t TEST_6_EXPECTED[] = {
+    0x8c, 0xe2, 0x49, 0x98, 0x62, 0x56, 0x15, 0xb6,
+    0x03, 0xa0, 0x33, 0xac, 0xa1, 0x3f, 0xb8, 0x94,
+    0xbe, 0x91, 0x12, 0xa5, 0xc3, 0xa2, 0x11, 0xa8,
+    0xba, 0x26, 0x2a, 0x3c, 0xca, 0x7e, 0x2c, 0xa7,
+    0x01, 0xe4, 0xa9, 0xa4, 0xfb, 0xa4, 0x3c, 0x90,
+    0xcc, 0xdc, 0xb2, 0x81, 0xd4, 0x8c, 0x7c, 0x6f,
+    0xd6, 0x28, 0x75, 0xd2, 0xac, 0xa4, 0x17, 0x03,
+    0x4c, 0x34, 0xae, 0xe5, 0x61, 0x9c, 0xc5, 0xae,
+    0xff, 0xfe, 0x0b, 0xfa, 0x46, 0x2a, 0xf4, 0x3c,
+    0x16, 0x99, 0xd0, 0x50,
+};
+
+#define TEST_MAC_LEN    (16U)
+
+static void test_encrypt_op(const uint8_t *key, const uint8_t *adata,
+                            size_t adata_len, const uint8_t *nonce,
+                            size_t nonce_len, const uint8_t *plain,
+                            size_t plain_len, const uint8_t *expected)
+{
+    cipher_t cipher;
+    uint8_t data[64 + TEST_MAC_LEN];
+    int len, err;
+
+    err = cipher_init(&cipher, CIPHER_AES_128, key, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_encrypt_gcm(&cipher, adata, adata_len, TEST_MAC_LEN,
+                             nonce, nonce_len, plain, plain_len, data);
+    TEST_ASSERT_EQUAL_INT(plain_len + TEST_MAC_LEN, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, data, len));
+}
+
+static void test_decrypt_op(const uint8_t *key, const uint8_t *adata,
+                            size_t adata_len, const uint8_t *nonce,
+                            size_t nonce_len, const uint8_t *plain,
+                            size_t plain_len, const uint8_t *encrypted)
+{
+    cipher_t cipher;
+    uint8_t data[64];
+    uint8_t tampered[64 + TEST_MAC_LEN];
+    int len, err;
+
+    err = cipher_init(&cipher, CIPHER_AES_128, key, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_decrypt_gcm(&cipher, adata, adata_len, TEST_MAC_LEN,
+                             nonce, nonce_len, encrypted,
+                             plain_len + TEST_MAC_LEN, data);
+    TEST_ASSERT_EQUAL_INT(plain_len, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, data, len));
+
+    memcpy(tampered, encrypted, plain_len + TEST_MAC_LEN);
+    tampered[plain_len + TEST_MAC_LEN - 1] ^= 0x01;
+    len = cipher_decrypt_gcm(&cipher, adata, adata_len, TEST_MAC_LEN,
+                             nonce, nonce_len, tampered,
+                             plain_len + TEST_MAC_LEN, data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_MAC, len);
+}
+
+#define do_test_encrypt_op(name, key, adata, adata_len, nonce, plain, plain_len) \
+    test_encrypt_op(key, adata, adata_len, nonce, sizeof(nonce), plain, \
+                    plain_len, TEST_##name##_EXPECTED)
+
+#define do_test_decrypt_op(name, key, adata, adata_len, nonce, plain, plain_len) \
+    test_decrypt_op(key, adata, adata_len, nonce, sizeof(nonce), plain, \
+                    plain_len, TEST_##name##_EXPECTED)
+
+static void test_crypto_modes_gcm_encrypt(void)
+{
+    do_test_encrypt_op(1, TEST_KEY_ZERO, NULL, 0, TEST_NONCE_ZERO, NULL, 0);
+    do_test_encrypt_op(2, TEST_KEY_ZERO, NULL, 0, TEST_NONCE_ZERO,
+                       TEST_BLOCK_ZERO, 16);
+    do_test_encrypt_op(3, TEST_KEY, NULL, 0, TEST_NONCE_96, TEST_PLAIN, 64);
+    do_test_encrypt_op(4, TEST_KEY, TEST_ADATA, sizeof(TEST_ADATA),
+                       TEST_NONCE_96, TEST_PLAIN, 60);
+    do_test_encrypt_op(5, TEST_KEY, TEST_ADATA, sizeof(TEST_ADATA),
+                       TEST_NONCE_64, TEST_PLAIN, 60);
+    do_test_encrypt_op(6, TEST_KEY, TEST_ADATA, sizeof(TEST_ADATA),
+                       TEST_NONCE_480, TEST_PLAIN, 60);
+}
+
+static void test_crypto_modes_gcm_decrypt(void)
+{
+    do_test_decrypt_op(1, TEST_KEY_ZERO, NULL, 0, TEST_NONCE_ZERO, NULL, 0);
+    do_test_decrypt_op(2, TEST_KEY_ZERO, NULL, 0, TEST_NONCE_ZERO,
+                       TEST_BLOCK_ZERO, 16);
+    do_test_decrypt_op(3, TEST_KEY, NULL, 0, TEST_NONCE_96, TEST_PLAIN, 64);
+    do_test_decrypt_op(4, TEST_KEY, TEST_ADATA, sizeof(TEST_ADATA),
+                       TEST_NONCE_96, TEST_PLAIN, 60);
+    do_test_decrypt_op(5, TEST_KEY, TEST_ADATA, sizeof(TEST_ADATA),
+                       TEST_NONCE_64, TEST_PLAIN, 60);
+    do_test_decrypt_op(6, TEST_KEY, TEST_ADATA, sizeof(TEST_ADATA),
+                       TEST_NONCE_480, TEST_PLAIN, 60);
+}
+
+static void test_crypto_modes_gcm_stream(void)
+{
+    /* pieces not aligned to blocks, as from a packet chain */
+    static const size_t pieces[] = { 1, 15, 17, 3, 24 };
+    cipher_t cipher;
+    cipher_gcm_ctx_t ctx;
+    uint8_t data[60];
+    uint8_t mac[TEST_MAC_LEN];
+    size_t offset = 0;
+    int err;
+
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    /* encrypt in place */
+    memcpy(data, TEST_PLAIN, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, cipher_gcm_init(&ctx, &cipher, TEST_NONCE_96,
+                                             sizeof(TEST_NONCE_96)));
+    TEST_ASSERT_EQUAL_INT(0, cipher_gcm_aad(&ctx, TEST_ADATA, 7));
+    TEST_ASSERT_EQUAL_INT(0, cipher_gcm_aad(&ctx, TEST_ADATA + 7,
+                                            sizeof(TEST_ADATA) - 7));
+    for (unsigned i = 0; i < ARRAY_SIZE(pieces); i++) {
+        err = cipher_gcm_encrypt_update(&ctx, data + offset, pieces[i],
+                                        data + offset);
+        TEST_ASSERT_EQUAL_INT(pieces[i], err);
+        offset += pieces[i];
+    }
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_STATE,
+                          cipher_gcm_aad(&ctx, TEST_ADATA, 1));
+    TEST_ASSERT_EQUAL_INT(sizeof(mac),
+                          cipher_gcm_encrypt_finish(&ctx, mac, sizeof(mac)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_4_EXPECTED, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_4_EXPECTED + sizeof(data), mac,
+                                    sizeof(mac)));
+
+    /* decrypt in place */
+    offset = 0;
+    TEST_ASSERT_EQUAL_INT(0, cipher_gcm_init(&ctx, &cipher, TEST_NONCE_96,
+                                             sizeof(TEST_NONCE_96)));
+    TEST_ASSERT_EQUAL_INT(0, cipher_gcm_aad(&ctx, TEST_ADATA,
+                                            sizeof(TEST_ADATA)));
+    for (unsigned i = 0; i < ARRAY_SIZE(pieces); i++) {
+        err = cipher_gcm_decrypt_update(&ctx, data + offset, pieces[i],
+                                        data + offset);
+        TEST_ASSERT_EQUAL_INT(pieces[i], err);
+        offset += pieces[i];
+    }
+    TEST_ASSERT_EQUAL_INT(0, cipher_gcm_decrypt_finish(&ctx, mac, sizeof(mac)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_PLAIN, data, sizeof(data)));
+}
+
+static void test_crypto_modes_gcm_check_len(void)
+{
+    cipher_t cipher;
+    uint8_t data[16 + GCM_MAC_MAX_LEN];
+    int err;
+
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    err = cipher_encrypt_gcm(&cipher, NULL, 0, 2, TEST_NONCE_96,
+                             sizeof(TEST_NONCE_96), TEST_PLAIN, 16, data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_MAC_LENGTH, err);
+    err = cipher_encrypt_gcm(&cipher, NULL, 0, 17, TEST_NONCE_96,
+                             sizeof(TEST_NONCE_96), TEST_PLAIN, 16, data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_MAC_LENGTH, err);
+    err = cipher_encrypt_gcm(&cipher, NULL, 0, 16, TEST_NONCE_96, 0,
+                             TEST_PLAIN, 16, data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_NONCE_LENGTH, err);
+
+    /* shorter MACs are a prefix of the full MAC */
+    err = cipher_encrypt_gcm(&cipher, NULL, 0, 12, TEST_NONCE_96,
+                             sizeof(TEST_NONCE_96), TEST_PLAIN, 16, data);
+    TEST_ASSERT_EQUAL_INT(16 + 12, err);
+    err = cipher_decrypt_gcm(&cipher, NULL, 0, 12, TEST_NONCE_96,
+                             sizeof(TEST_NONCE_96), data, 16 + 12, data);
+    TEST_ASSERT_EQUAL_INT(16, err);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_PLAIN, data, 16));
+}
+
+Test *tests_crypto_modes_gcm_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_modes_gcm_encrypt),
+        new_TestFixture(test_crypto_modes_gcm_decrypt),
+        new_TestFixture(test_crypto_modes_gcm_stream),
+        new_TestFixture(test_crypto_modes_gcm_check_len),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_modes_gcm_tests, NULL, NULL, fixtures);
+
+    return (Test *)&crypto_modes_gcm_tests;
+}
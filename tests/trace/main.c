@@ -28,6 +28,7 @@ int main(void)
 {
     trace(0);
     trace(1);
+    trace_event(TRACE_EVENT_APP, 2);
 
     trace_dump();
 
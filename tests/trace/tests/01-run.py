@@ -7,6 +7,7 @@ from testrunner import run
 def testfunc(child):
     child.expect(r"n=   0 t=\ +\d+ v=0x00000000\r\n")
     child.expect(r"n=   1 t=\+\ +\d+ v=0x00000001\r\n")
+    child.expect(r"n=   2 t=\+\ +\d+ v=0x00000002 e=app\(0x8000\) pid=\d+\r\n")
 
 
 if __name__ == "__main__":
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -152,12 +154,65 @@ static void tests_core_ringbuffer_remove_underflow(void)
     TEST_ASSERT_EQUAL_INT(1, ringbuffer_empty(&buf));
 }
 
+static void tests_core_ringbuffer_add_get_wrap(void)
+{
+    char mem[5];
+    char out[5];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_add(&buf, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_get(&buf, out, 2));
+    /* wraps around the end of mem and is truncated to the free space */
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_add(&buf, "defgh", 5));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_full(&buf));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_get(&buf, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("cdefg", out, sizeof(out)));
+}
+
+static void tests_core_ringbuffer_contiguous(void)
+{
+    char mem[5];
+    const char *data;
+    char *space;
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_peek_contiguous(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_reserve_contiguous(&buf, &space));
+    TEST_ASSERT(space == mem);
+    memcpy(space, "abcd", 4);
+    ringbuffer_commit(&buf, 4);
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_peek_contiguous(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("abcd", data, 4));
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&buf, 3));
+
+    /* free space is split into the end and the start of mem */
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_reserve_contiguous(&buf, &space));
+    TEST_ASSERT(space == &mem[4]);
+    *space = 'e';
+    ringbuffer_commit(&buf, 1);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_reserve_contiguous(&buf, &space));
+    TEST_ASSERT(space == mem);
+    memcpy(space, "fg", 2);
+    ringbuffer_commit(&buf, 2);
+
+    /* readable elements are split as well */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_contiguous(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("de", data, 2));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_remove(&buf, 2));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_contiguous(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("fg", data, 2));
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
         new_TestFixture(tests_core_ringbuffer_remove),
         new_TestFixture(tests_core_ringbuffer_remove_underflow),
+        new_TestFixture(tests_core_ringbuffer_add_get_wrap),
+        new_TestFixture(tests_core_ringbuffer_contiguous),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -41,7 +41,7 @@ static const gnrc_sixlowpan_frag_rb_int_t _interval = {
     .start = 0,
     .end = 116U,
 };
-static const gnrc_sixlowpan_frag_rb_base_t _base = {
+static gnrc_sixlowpan_frag_rb_base_t _base = {
     .ints = (gnrc_sixlowpan_frag_rb_int_t *)&_interval,
     .src = TEST_SRC,
     .dst = TEST_DST,
@@ -50,7 +50,9 @@ static const gnrc_sixlowpan_frag_rb_base_t _base = {
     .tag = TEST_TAG,
     .datagram_size = 1156U,
     .current_size = 116U,
-    .arrival = 1742197326U,
+    /* set in set_up(), as gnrc_sixlowpan_frag_vrb_get() drops timed out
+     * entries */
+    .arrival = 0U,
 };
 static uint8_t _out_dst[] = TEST_OUT_DST;
 
@@ -58,6 +60,7 @@ static void set_up(void)
 {
     gnrc_sixlowpan_frag_vrb_reset();
     gnrc_sixlowpan_frag_fb_reset();
+    _base.arrival = xtimer_now_usec();
 }
 
 static void test_vrb_add__success(void)
@@ -143,6 +146,22 @@ static void test_vrb_get__after_add(void)
     TEST_ASSERT(res1 == res2);
 }
 
+static void test_vrb_get__timed_out(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+    gnrc_sixlowpan_frag_vrb_t *res;
+
+    base.arrival = xtimer_now_usec() - CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US - 1000;
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    /* no garbage collection, the entry is dropped on lookup */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(base.src, base.src_len,
+                                                 base.tag));
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_entry_empty(res));
+}
+
 static void test_vrb_rm(void)
 {
     gnrc_sixlowpan_frag_vrb_t *res;
@@ -179,6 +198,7 @@ static Test *tests_gnrc_sixlowpan_frag_vrb_tests(void)
         new_TestFixture(test_vrb_add__full),
         new_TestFixture(test_vrb_get__empty),
         new_TestFixture(test_vrb_get__after_add),
+        new_TestFixture(test_vrb_get__timed_out),
         new_TestFixture(test_vrb_rm),
         new_TestFixture(test_vrb_gc),
     };
@@ -30,6 +30,7 @@
 #include "embUnit/embUnit.h"
 
 #include "hashes/sha256.h"
+#include "kernel_defines.h"
 
 #include "tests-hashes.h"
 
@@ -266,6 +267,33 @@ static void test_hashes_sha256_hash_sequence_abc_long(void)
     TEST_ASSERT(calc_and_compare_hash_wrapper(teststring, h_fips_multiblock));
 }
 
+static void test_hashes_sha256_multi(void)
+{
+    /* lengths around the padding boundaries */
+    static const size_t lens[] = { 0, 32, 55, 56, 64, 119, 200 };
+    static unsigned char msgs[3][200];
+    unsigned char expected[3][SHA256_DIGEST_LENGTH];
+    unsigned char digests[3][SHA256_DIGEST_LENGTH];
+    const void *data[] = { msgs[0], msgs[1], msgs[2] };
+    void *const out[] = { digests[0], digests[1], digests[2] };
+
+    for (unsigned i = 0; i < sizeof(msgs); i++) {
+        msgs[i / sizeof(msgs[0])][i % sizeof(msgs[0])] = i * 7;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(msgs); j++) {
+            sha256_context_t ctx;
+
+            sha256_init(&ctx);
+            sha256_update(&ctx, msgs[j], lens[i]);
+            sha256_final(&ctx, expected[j]);
+        }
+        sha256_multi(data, lens[i], out, ARRAY_SIZE(msgs));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(expected, digests, sizeof(digests)));
+    }
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -284,6 +312,8 @@ Test *tests_hashes_sha256_tests(void)
 
         new_TestFixture(test_hashes_sha256_hash_sequence_abc),
         new_TestFixture(test_hashes_sha256_hash_sequence_abc_long),
+
+        new_TestFixture(test_hashes_sha256_multi),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
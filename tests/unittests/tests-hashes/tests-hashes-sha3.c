@@ -411,6 +411,55 @@ static void test_hashes_sha3_hash_sequence_failing_compare(void)
     TEST_ASSERT(!calc_and_compare_hash_512(mfail, mfail_len, hfail_512));
 }
 
+/**
+ * @brief expected SHAKE128 output for an empty message, first 32 bytes
+ *
+ * Values taken from the Python hashlib module.
+ */
+static const uint8_t shake128_empty[] = {
+    0x7F, 0x9C, 0x2B, 0xA4, 0xE8, 0x8F, 0x82, 0x7D,
+    0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3E,
+    0xD7, 0x3B, 0x80, 0x93, 0xF6, 0xEF, 0xBC, 0x88,
+    0xEB, 0x1A, 0x6E, 0xAC, 0xFA, 0x66, 0xEF, 0x26
+};
+
+/**
+ * @brief expected SHAKE256 output for "abc", first 32 bytes
+ */
+static const uint8_t shake256_abc[] = {
+    0x48, 0x33, 0x66, 0x60, 0x13, 0x60, 0xA8, 0x77,
+    0x1C, 0x68, 0x63, 0x08, 0x0C, 0xC4, 0x11, 0x4D,
+    0x8D, 0xB4, 0x45, 0x30, 0xF8, 0xF1, 0xE1, 0xEE,
+    0x4F, 0x94, 0xEA, 0x37, 0xE7, 0x8B, 0x57, 0x39
+};
+
+static void test_hashes_sha3_shake128(void)
+{
+    uint8_t out[sizeof(shake128_empty)];
+
+    shake128(out, sizeof(out), NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(shake128_empty, out, sizeof(out)));
+}
+
+static void test_hashes_sha3_shake256(void)
+{
+    /* longer than the rate of 136 bytes, squeezed across a block boundary */
+    uint8_t expected[200];
+    uint8_t out[200];
+    keccak_state_t state;
+
+    shake256(expected, sizeof(expected), "abc", 3);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(shake256_abc, expected,
+                                    sizeof(shake256_abc)));
+
+    shake256_init(&state);
+    sha3_update(&state, "ab", 2);
+    sha3_update(&state, "c", 1);
+    shake_final(&state, out, 100);
+    shake_squeeze(&state, &out[100], 60);
+    shake_squeeze(&state, &out[160], 40);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, out, sizeof(out)));
+}
 
 Test *tests_hashes_sha3_tests(void)
 {
@@ -420,6 +469,8 @@ Test *tests_hashes_sha3_tests(void)
         new_TestFixture(test_hashes_sha3_hash_sequence_03),
         new_TestFixture(test_hashes_sha3_hash_sequence_04),
         new_TestFixture(test_hashes_sha3_hash_sequence_failing_compare),
+        new_TestFixture(test_hashes_sha3_shake128),
+        new_TestFixture(test_hashes_sha3_shake256),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha3_tests, NULL, NULL,
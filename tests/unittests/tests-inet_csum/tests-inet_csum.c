@@ -165,6 +165,78 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* byte-wise implementation of inet_csum_slice() as reference */
+static uint16_t _csum_ref(uint16_t sum, const uint8_t *buf, uint16_t len,
+                          size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++, accum_len++) {
+        csum += (accum_len & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _rand(void)
+{
+    static uint32_t state = 0x12345678;
+
+    /* xorshift32, so the test is reproducible */
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void test_inet_csum__fuzz(void)
+{
+    uint8_t data[300];
+
+    for (unsigned round = 0; round < 2000; round++) {
+        /* vary the alignment of the buffer, its position in the domain and
+         * run into all-ones data to provoke many carries */
+        unsigned offset = _rand() % 8;
+        uint16_t len = _rand() % (sizeof(data) - offset);
+        size_t accum_len = _rand() % 4;
+        uint16_t sum = _rand();
+        uint8_t fill = (round % 4) ? 0x00 : 0xff;
+
+        for (unsigned i = 0; i < sizeof(data); i++) {
+            data[i] = ((round % 8) < 2) ? fill : _rand();
+        }
+        TEST_ASSERT_EQUAL_INT(_csum_ref(sum, &data[offset], len, accum_len),
+                              inet_csum_slice(sum, &data[offset], len,
+                                              accum_len));
+    }
+}
+
+static void test_inet_csum__fuzz_slices(void)
+{
+    uint8_t data[300];
+
+    for (unsigned round = 0; round < 500; round++) {
+        uint16_t len = _rand() % sizeof(data);
+        uint16_t expected, sum = 0;
+        size_t accum_len = 0;
+
+        for (unsigned i = 0; i < len; i++) {
+            data[i] = _rand();
+        }
+        expected = _csum_ref(0, data, len, 0);
+        /* split the domain into slices of random length */
+        while (accum_len < len) {
+            uint16_t slice_len = _rand() % (len - accum_len + 1);
+
+            sum = inet_csum_slice(sum, &data[accum_len], slice_len, accum_len);
+            accum_len += slice_len;
+        }
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +248,8 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__fuzz),
+        new_TestFixture(test_inet_csum__fuzz_slices),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
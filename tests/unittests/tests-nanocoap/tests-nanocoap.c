@@ -19,7 +19,9 @@
 
 #include "embUnit.h"
 
+#include "kernel_defines.h"
 #include "net/nanocoap.h"
+#include "net/nanocoap_router.h"
 
 #include "unittests-constants.h"
 #include "tests-nanocoap.h"
@@ -497,6 +499,74 @@ static void test_nanocoap__server_get_req(void)
     TEST_ASSERT_EQUAL_STRING((char *)path, (char *)uri);
 }
 
+/*
+ * Parses requests with a path that fits the Uri-Path index and with one that
+ * does not, both must read back the same path.
+ */
+static void test_nanocoap__server_uri_path_index(void)
+{
+    static const char *paths[] = {
+        "/", "/riot/value", "/riot/value/", "/a/b/c/d/e/f/g/h/i/j/k/l"
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(paths); i++) {
+        uint8_t buf[_BUF_SIZE];
+        coap_pkt_t pkt;
+        uint8_t token[2] = {0xDA, 0xEC};
+
+        ssize_t len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_NON,
+                                     &token[0], 2, COAP_METHOD_GET, 0xABCD);
+        coap_pkt_init(&pkt, &buf[0], sizeof(buf), len);
+        coap_opt_add_uri_path(&pkt, paths[i]);
+        coap_opt_add_format(&pkt, COAP_FORMAT_TEXT);
+        len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+        TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, &buf[0], len));
+
+        char uri[64] = {0};
+        TEST_ASSERT_EQUAL_INT(strlen(paths[i]) + 1,
+                              coap_get_uri_path(&pkt, (uint8_t *)&uri[0]));
+        TEST_ASSERT_EQUAL_STRING(paths[i], (char *)uri);
+    }
+}
+
+/*
+ * The trie router must pick the same resource as the linear scan, including
+ * subtree matching and the first resource with a fitting method.
+ */
+static void test_nanocoap__router_find(void)
+{
+    static const coap_resource_t resources[] = {
+        { "/riot", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/riot/board", COAP_PUT, NULL, NULL },
+        { "/riot/board", COAP_GET, NULL, NULL },
+        { "/riot/value", COAP_POST, NULL, NULL },
+        { "/sensor/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/sensor/temp", COAP_GET, NULL, NULL },
+    };
+    nanocoap_router_t router;
+    const coap_resource_t *res;
+
+    TEST_ASSERT_EQUAL_INT(0, nanocoap_router_init(&router, resources,
+                                                  ARRAY_SIZE(resources)));
+
+    TEST_ASSERT_EQUAL_INT(0, nanocoap_router_find(&router, "/riot/board",
+                                                  COAP_PUT, &res));
+    TEST_ASSERT(res == &resources[1]);
+    TEST_ASSERT_EQUAL_INT(0, nanocoap_router_find(&router, "/riotous",
+                                                  COAP_GET, &res));
+    TEST_ASSERT(res == &resources[0]);
+    TEST_ASSERT_EQUAL_INT(0, nanocoap_router_find(&router, "/sensor/temp",
+                                                  COAP_GET, &res));
+    TEST_ASSERT(res == &resources[4]);
+    TEST_ASSERT_EQUAL_INT(-EPERM, nanocoap_router_find(&router, "/riot/value",
+                                                       COAP_PUT, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, nanocoap_router_find(&router, "/sensor",
+                                                        COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, nanocoap_router_find(&router, "/",
+                                                        COAP_GET, &res));
+}
+
 /* Response for server GET request using coap_reply_simple(). */
 static void test_nanocoap__server_reply_simple(void)
 {
@@ -886,6 +956,8 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__options_get_opaque),
         new_TestFixture(test_nanocoap__options_iterate),
         new_TestFixture(test_nanocoap__server_get_req),
+        new_TestFixture(test_nanocoap__server_uri_path_index),
+        new_TestFixture(test_nanocoap__router_find),
         new_TestFixture(test_nanocoap__server_reply_simple),
         new_TestFixture(test_nanocoap__server_get_req_con),
         new_TestFixture(test_nanocoap__server_reply_simple_con),
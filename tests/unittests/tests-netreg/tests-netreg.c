@@ -14,6 +14,7 @@
 #include <errno.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/nettype.h"
@@ -124,6 +125,60 @@ void test_netreg_num__2_entries(void)
     TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
 }
 
+void test_netreg_lookup_num__empty(void)
+{
+    int num = -1;
+
+    TEST_ASSERT_NULL(gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST, TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(0, num);
+}
+
+void test_netreg_lookup_num__wrong_type_numof(void)
+{
+    int num = -1;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup_num(GNRC_NETTYPE_NUMOF, TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(0, num);
+}
+
+void test_netreg_lookup_num__2_entries(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+    int num = -1;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST, TEST_UINT16,
+                                                       &num)));
+    TEST_ASSERT_EQUAL_INT(2, num);
+    TEST_ASSERT(res == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+}
+
+void test_netreg_lookup__many_demux_ctx(void)
+{
+    static gnrc_netreg_entry_t many[32];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i++) {
+        gnrc_netreg_entry_init_pid(&many[i], TEST_UINT16 + i, TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &many[i]));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i++) {
+        gnrc_netreg_entry_t *res;
+
+        TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16 + i)));
+        TEST_ASSERT(res == &many[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, GNRC_NETREG_DEMUX_CTX_ALL));
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+}
+
 void test_netreg_getnext__NULL(void)
 {
     TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
@@ -153,6 +208,10 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__wrong_type_undef),
         new_TestFixture(test_netreg_num__wrong_type_numof),
         new_TestFixture(test_netreg_num__2_entries),
+        new_TestFixture(test_netreg_lookup_num__empty),
+        new_TestFixture(test_netreg_lookup_num__wrong_type_numof),
+        new_TestFixture(test_netreg_lookup_num__2_entries),
+        new_TestFixture(test_netreg_lookup__many_demux_ctx),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
     };
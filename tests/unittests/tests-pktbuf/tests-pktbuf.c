@@ -852,6 +852,96 @@ static void test_pktbuf_reverse_snips__success(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+#if IS_USED(MODULE_GNRC_PKTBUF_LOAN)
+static uint8_t _loan[2][64];
+static unsigned _loan_returned;
+
+static void _loan_cb(void *ctx, void *data)
+{
+    TEST_ASSERT(ctx == _loan);
+    TEST_ASSERT(data == _loan[0]);
+    _loan_returned++;
+}
+
+static void test_pktbuf_add_loaned__mark(void)
+{
+    gnrc_pktsnip_t *pkt1, *pkt2;
+
+    _loan_returned = 0;
+    memcpy(_loan[0], TEST_STRING64, sizeof(_loan[0]));
+    pkt1 = gnrc_pktbuf_add_loaned(NULL, _loan[0], sizeof(_loan[0]),
+                                  GNRC_NETTYPE_TEST, _loan_cb, _loan);
+    TEST_ASSERT_NOT_NULL(pkt1);
+    TEST_ASSERT(pkt1->data == _loan[0]);
+    TEST_ASSERT_EQUAL_INT(sizeof(_loan[0]), pkt1->size);
+    /* unaligned headers are split off without copying */
+    TEST_ASSERT_NOT_NULL((pkt2 = gnrc_pktbuf_mark(pkt1, 3, GNRC_NETTYPE_UNDEF)));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(pkt2->data == _loan[0]);
+    TEST_ASSERT(pkt1->data == &_loan[0][3]);
+    TEST_ASSERT_EQUAL_INT(sizeof(_loan[0]) - 3, pkt1->size);
+    gnrc_pktbuf_remove_snip(pkt1, pkt2);
+    TEST_ASSERT_EQUAL_INT(0, _loan_returned);
+    gnrc_pktbuf_release(pkt1);
+    TEST_ASSERT_EQUAL_INT(1, _loan_returned);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_loaned__realloc_data(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    _loan_returned = 0;
+    memcpy(_loan[0], TEST_STRING64, sizeof(_loan[0]));
+    pkt = gnrc_pktbuf_add_loaned(NULL, _loan[0], sizeof(_loan[0]),
+                                 GNRC_NETTYPE_TEST, _loan_cb, _loan);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* shrinking keeps the loaned data */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 16));
+    TEST_ASSERT(pkt->data == _loan[0]);
+    TEST_ASSERT_EQUAL_INT(0, _loan_returned);
+    /* growing moves the data into the packet buffer */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 32));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(pkt->data != _loan[0]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64, pkt->data, 16));
+    TEST_ASSERT_EQUAL_INT(1, _loan_returned);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _loan_returned);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void _loan_count_cb(void *ctx, void *data)
+{
+    (void)ctx;
+    (void)data;
+    _loan_returned++;
+}
+
+static void test_pktbuf_add_loaned__loans_full(void)
+{
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_PKTBUF_LOAN_NUMOF];
+
+    _loan_returned = 0;
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTBUF_LOAN_NUMOF; i++) {
+        pkts[i] = gnrc_pktbuf_add_loaned(NULL, &_loan[1][i], 1,
+                                         GNRC_NETTYPE_TEST, _loan_count_cb,
+                                         NULL);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_add_loaned(NULL, _loan[0], 1,
+                                            GNRC_NETTYPE_TEST, _loan_count_cb,
+                                            NULL));
+    TEST_ASSERT_EQUAL_INT(0, _loan_returned);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTBUF_LOAN_NUMOF; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_PKTBUF_LOAN_NUMOF, _loan_returned);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -910,6 +1000,11 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
 #endif /* MODULE_GNRC_PKTBUF_MALLOC */
         new_TestFixture(test_pktbuf_reverse_snips__success),
+#if IS_USED(MODULE_GNRC_PKTBUF_LOAN)
+        new_TestFixture(test_pktbuf_add_loaned__mark),
+        new_TestFixture(test_pktbuf_add_loaned__realloc_data),
+        new_TestFixture(test_pktbuf_add_loaned__loans_full),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
@@ -162,6 +162,73 @@ static void test_add(void)
     }
 }
 
+static void test_add_get_wrap(void)
+{
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2, tsrb_add(&_tsrb, _io_buffer,
+                                                    BUFFER_SIZE - 2));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2, tsrb_drop(&_tsrb, BUFFER_SIZE));
+    /* wraps around the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    memset(_io_buffer, IO_BUFFER_CANARY, sizeof(_io_buffer));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_get(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + i), _io_buffer[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(IO_BUFFER_CANARY, _io_buffer[BUFFER_SIZE]);
+}
+
+static void test_peek_contiguous(void)
+{
+    const uint8_t *data;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_contiguous(&_tsrb, &data));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_tsrb, TEST_INPUT + i));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_drop(&_tsrb, TEST_DROP_NUM));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_tsrb, TEST_INPUT));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_peek_contiguous(&_tsrb, &data));
+    TEST_ASSERT(data == &_tsrb_buffer[TEST_DROP_NUM]);
+    TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + TEST_DROP_NUM), data[0]);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_drop(&_tsrb, BUFFER_SIZE - TEST_DROP_NUM));
+    /* the rest is at the start of the buffer */
+    TEST_ASSERT_EQUAL_INT(1, tsrb_peek_contiguous(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT, data[0]);
+}
+
+static void test_reserve_commit(void)
+{
+    uint8_t *data;
+
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_reserve_contiguous(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    memset(data, TEST_INPUT, BUFFER_SIZE - 1);
+    tsrb_commit(&_tsrb, BUFFER_SIZE - 1);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 1, tsrb_avail(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_drop(&_tsrb, TEST_DROP_NUM));
+    /* only the space up to the end of the buffer is contiguous */
+    TEST_ASSERT_EQUAL_INT(1, tsrb_reserve_contiguous(&_tsrb, &data));
+    TEST_ASSERT(data == &_tsrb_buffer[BUFFER_SIZE - 1]);
+    *data = TEST_INPUT + 1;
+    tsrb_commit(&_tsrb, 1);
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_reserve_contiguous(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    tsrb_commit(&_tsrb, 0);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM, tsrb_avail(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_get(&_tsrb, _io_buffer, sizeof(_io_buffer)));
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT + 1,
+                          _io_buffer[BUFFER_SIZE - TEST_DROP_NUM - 1]);
+}
+
 static Test *tests_tsrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -174,6 +241,9 @@ static Test *tests_tsrb_tests(void)
         new_TestFixture(test_drop),
         new_TestFixture(test_add_one),
         new_TestFixture(test_add),
+        new_TestFixture(test_add_get_wrap),
+        new_TestFixture(test_peek_contiguous),
+        new_TestFixture(test_reserve_commit),
     };
 
     EMB_UNIT_TESTCALLER(tsrb_tests, NULL, tear_down, fixtures);
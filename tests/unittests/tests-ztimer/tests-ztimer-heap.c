@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for ztimer clocks using the pairing heap
+ *
+ * @}
+ */
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer.h"
+
+#define TIMER_NUMOF     (32U)
+
+static unsigned _order[TIMER_NUMOF];
+static unsigned _fired;
+
+/**
+ * @brief   Callback recording the order in which timers trigger
+ */
+static void cb_record(void *arg)
+{
+    _order[_fired++] = (unsigned)(uintptr_t)arg;
+}
+
+static void _init_timers(ztimer_t *timers, unsigned numof)
+{
+    _fired = 0;
+    for (unsigned i = 0; i < numof; i++) {
+        timers[i] = (ztimer_t){ .callback = cb_record, .arg = (void *)(uintptr_t)i };
+    }
+}
+
+/**
+ * @brief   Timers set in scrambled order trigger sorted by target
+ */
+static void test_ztimer_heap_order(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+    ztimer_t timers[TIMER_NUMOF];
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_clock_use_heap(z);
+    _init_timers(timers, TIMER_NUMOF);
+
+    /* 7 is coprime to TIMER_NUMOF, so this sets every timer once */
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        unsigned n = (i * 7) % TIMER_NUMOF;
+        ztimer_set(z, &timers[n], 100 + n * 10);
+    }
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        TEST_ASSERT(ztimer_is_set(z, &timers[i]));
+    }
+
+    ztimer_mock_advance(&zmock, 99);
+    TEST_ASSERT_EQUAL_INT(0, _fired);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, _fired);
+    ztimer_mock_advance(&zmock, TIMER_NUMOF * 10);
+    TEST_ASSERT_EQUAL_INT(TIMER_NUMOF, _fired);
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _order[i]);
+        TEST_ASSERT(!ztimer_is_set(z, &timers[i]));
+    }
+    TEST_ASSERT_NULL(z->list.next);
+}
+
+/**
+ * @brief   Removing and re-setting timers anywhere in the heap
+ */
+static void test_ztimer_heap_remove(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+    ztimer_t timers[TIMER_NUMOF];
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_clock_use_heap(z);
+    _init_timers(timers, TIMER_NUMOF);
+
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        ztimer_set(z, &timers[i], 1000 - i * 10);
+    }
+    /* after this, odd timers are gone and even ones fire in ascending order */
+    for (unsigned i = 1; i < TIMER_NUMOF; i += 2) {
+        ztimer_remove(z, &timers[i]);
+        TEST_ASSERT(!ztimer_is_set(z, &timers[i]));
+    }
+    for (unsigned i = 0; i < TIMER_NUMOF; i += 2) {
+        ztimer_remove(z, &timers[i]);
+    }
+    TEST_ASSERT_NULL(z->list.next);
+    for (unsigned i = 0; i < TIMER_NUMOF; i += 2) {
+        ztimer_set(z, &timers[i], 2000 + i * 10);
+    }
+    /* re-setting timers already in the heap, keeping the head in place */
+    for (unsigned i = 2; i < TIMER_NUMOF; i += 2) {
+        ztimer_set(z, &timers[i], 2000 + i * 10);
+    }
+    /* removing an unset timer is a no-op */
+    ztimer_remove(z, &timers[1]);
+
+    ztimer_mock_advance(&zmock, 1999);
+    TEST_ASSERT_EQUAL_INT(0, _fired);
+    ztimer_mock_advance(&zmock, TIMER_NUMOF * 10);
+    TEST_ASSERT_EQUAL_INT(TIMER_NUMOF / 2, _fired);
+    for (unsigned i = 0; i < TIMER_NUMOF / 2; i++) {
+        TEST_ASSERT_EQUAL_INT(i * 2, _order[i]);
+    }
+    TEST_ASSERT_NULL(z->list.next);
+}
+
+/**
+ * @brief   Targets passed while the clock was not serviced trigger at once
+ */
+static void test_ztimer_heap_late(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+    ztimer_t timers[3];
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_clock_use_heap(z);
+    _init_timers(timers, 3);
+
+    ztimer_set(z, &timers[0], 10);
+    ztimer_set(z, &timers[1], 20);
+    /* move the counter without triggering the alarm, then set another timer,
+     * which forces the base to move past the pending targets */
+    ztimer_mock_jump(&zmock, 50);
+    ztimer_set(z, &timers[2], 5);
+    TEST_ASSERT(ztimer_is_set(z, &timers[0]));
+    TEST_ASSERT(ztimer_is_set(z, &timers[1]));
+
+    ztimer_mock_fire(&zmock);
+    TEST_ASSERT_EQUAL_INT(2, _fired);
+    TEST_ASSERT(ztimer_is_set(z, &timers[2]));
+    ztimer_mock_advance(&zmock, 5);
+    TEST_ASSERT_EQUAL_INT(3, _fired);
+    TEST_ASSERT_EQUAL_INT(2, _order[2]);
+}
+
+/**
+ * @brief   Only timers linked into the heap are set, whether they were never
+ *          set, expired or were removed
+ */
+static void test_ztimer_heap_is_set(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+    ztimer_t timers[TIMER_NUMOF];
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_clock_use_heap(z);
+    _init_timers(timers, TIMER_NUMOF);
+
+    for (unsigned i = 0; i < TIMER_NUMOF - 1; i++) {
+        ztimer_set(z, &timers[i], 100 + i * 10);
+    }
+    /* the last timer was zero-initialized and never set */
+    ztimer_t *t = &timers[TIMER_NUMOF - 1];
+    TEST_ASSERT(!ztimer_is_set(z, t));
+    ztimer_remove(z, t);
+    ztimer_remove(z, &timers[5]);
+    TEST_ASSERT(!ztimer_is_set(z, &timers[5]));
+    TEST_ASSERT(ztimer_is_set(z, &timers[6]));
+
+    ztimer_mock_advance(&zmock, 100);
+    TEST_ASSERT(!ztimer_is_set(z, &timers[0]));
+    /* links of a timer that expired are cleared, so it can be set again */
+    ztimer_set(z, &timers[0], 10 * TIMER_NUMOF);
+    ztimer_set(z, t, 10 * (TIMER_NUMOF - 1));
+    TEST_ASSERT(ztimer_is_set(z, t));
+    ztimer_mock_advance(&zmock, 10 * TIMER_NUMOF);
+    /* timer 0 fired twice, timer 5 never */
+    TEST_ASSERT_EQUAL_INT(TIMER_NUMOF, _fired);
+    TEST_ASSERT_EQUAL_INT(0, _order[0]);
+    TEST_ASSERT_EQUAL_INT(6, _order[5]);
+    TEST_ASSERT_EQUAL_INT(TIMER_NUMOF - 1, _order[TIMER_NUMOF - 2]);
+    TEST_ASSERT_EQUAL_INT(0, _order[TIMER_NUMOF - 1]);
+    TEST_ASSERT_NULL(z->list.next);
+}
+
+/**
+ * @brief   Heap clock on a 16 bit counter, requiring extension
+ */
+static void test_ztimer_heap_set16(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+    ztimer_t timers[2];
+
+    ztimer_mock_init(&zmock, 16);
+    ztimer_clock_use_heap(z);
+    _init_timers(timers, 2);
+
+    ztimer_set(z, &timers[1], 0x30000ul);
+    ztimer_set(z, &timers[0], 0x10001ul);
+    ztimer_mock_advance(&zmock, 0x10000ul);
+    TEST_ASSERT_EQUAL_INT(0, _fired);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, _fired);
+    ztimer_mock_advance(&zmock, 0x1fffeul);
+    TEST_ASSERT_EQUAL_INT(1, _fired);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(2, _fired);
+    TEST_ASSERT_EQUAL_INT(1, _order[1]);
+    TEST_ASSERT_EQUAL_INT(0x30000ul, ztimer_now(z));
+}
+
+Test *tests_ztimer_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_heap_order),
+        new_TestFixture(test_ztimer_heap_remove),
+        new_TestFixture(test_ztimer_heap_late),
+        new_TestFixture(test_ztimer_heap_is_set),
+        new_TestFixture(test_ztimer_heap_set16),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_tests, NULL, NULL, fixtures);
+
+    return (Test *)&ztimer_tests;
+}
+
+/** @} */